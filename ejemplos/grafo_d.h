@@ -1,12 +1,55 @@
 /*Libraria de Grafo Dinamico Implementado Mediante Lista de Adyacencia*/
-#ifndef _GRAFO_D_H
+#if !defined(_GRAFO_D_H) || defined(GRAFO_D_PREFIJO)
+#ifdef GRAFO_D_PREFIJO
+#ifdef _GRAFO_D_H
+#error "No se puede incluir la libreria con GRAFO_D_PREFIJO despues de incluirla sin prefijo"
+#endif
+#define _GRAFO_D_PREFIJADO
+#else
+#ifdef _GRAFO_D_PREFIJADO
+#error "No se puede incluir la libreria sin GRAFO_D_PREFIJO despues de incluirla con prefijo"
+#endif
 #define _GRAFO_D_H
+#endif
 
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <limits.h>
+#include <stdint.h>
 #include <assert.h>
+#include <string.h>
+
+#if defined(GRAFO_D_CONCURRENTE) && !defined(GRAFO_D_HILOS)
+#define GRAFO_D_HILOS
+#endif
+
+#ifdef GRAFO_D_HILOS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/*  Los candados de lectura/escritura son parte de POSIX.1-2001 y no de C, con -std=c99/-std=c11
+    las cabeceras del sistema no los declaran si no se pide POSIX explicitamente.
+*/
+#if defined(GRAFO_D_CONCURRENTE) && !defined(PTHREAD_RWLOCK_INITIALIZER)
+#error "GRAFO_D_CONCURRENTE requiere pthread_rwlock_t: compile con -std=gnu99/gnu11 o defina _POSIX_C_SOURCE como 200112L o mayor antes de incluir cualquier cabecera"
+#endif
+
+#ifdef GRAFO_D_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*  Sin un candado de lectura/escritura que de preferencia a los escritores de forma nativa se usa
+    un torniquete para que las consultas nuevas esperen a los escritores pendientes.
+*/
+#if defined(GRAFO_D_CONCURRENTE) && !(defined(__GLIBC__) && defined(__USE_GNU))
+#define _GD_TORNIQUETE
+#endif
 
 /*  LIBRERIA DE GRAFOS DINAMICOS GRAFO_D
     Esta es una libreria de tipo cabezera que implementa el tipo de dato abstracto
@@ -53,6 +96,89 @@
     #define PESO_NO_ARISTA HUGE_VAL
     Si DATO_PESO fue definido como unsigned long long
     #define PESO_NO_ARISTA ULLONG_MAX
+
+    GRAFO_D_UMBRAL_HASH_ADY: Grado de salida a partir del cual un vertice mantiene una tabla hash
+    que relaciona cada vecino con las aristas que llegan a el, de modo que las busquedas de aristas
+    entre dos vertices no recorran toda su lista de adyacencia. La tabla se libera cuando el grado
+    baja de la mitad del umbral. Por defecto es 32. Ejemplo:
+    #define GRAFO_D_UMBRAL_HASH_ADY 128
+
+    GRAFO_D_ADY_LOCAL: Numero de aristas de salida que se guardan dentro del propio nodo de cada
+    vertice, sin reservar memoria por separado. Las aristas adicionales se reservan en lotes
+    contiguos por vertice. Por defecto es 4, 0 hace que todas se reserven en lotes. Ejemplo:
+    #define GRAFO_D_ADY_LOCAL 2
+
+    GRAFO_D_IDS_32: Si se define antes de incluir la libreria cada vertice recibe un identificador
+    numerico denso de 32 bits y las aristas guardan el identificador de su vertice final en lugar
+    de un puntero, lo que reduce el tamano de cada arista. Los identificadores de vertices
+    eliminados se reutilizan. Habilita las funciones de la seccion Identificadores Numericos. El
+    grafo no puede tener mas de UINT32_MAX-1 vertices. Ejemplo:
+    #define GRAFO_D_IDS_32
+
+    GRAFO_D_HILOS: Si se define antes de incluir la libreria se habilitan las operaciones que usan
+    varios hilos de ejecucion (POSIX threads), como grafo_d_buscar_vertices_par() y
+    grafo_d_buscar_aristas_par(). El programa debe enlazarse con -pthread. Ejemplo:
+    #define GRAFO_D_HILOS
+
+    GRAFO_D_CONCURRENTE: Si se define antes de incluir la libreria cada grafo incluye un candado
+    de lectura/escritura y todas las operaciones publicas sobre el grafo lo adquieren, de modo que
+    varios hilos pueden consultar un mismo grafo a la vez mientras otro lo modifica sin necesidad
+    de sincronizacion externa. Implica GRAFO_D_HILOS. Requiere los candados de lectura/escritura
+    de POSIX, por lo que con -std=c99/-std=c11 debe definirse _POSIX_C_SOURCE como 200112L o mayor
+    antes de incluir cualquier cabecera. Ver la seccion Modo Concurrente. Ejemplo:
+    #define GRAFO_D_CONCURRENTE
+
+    GRAFO_D_MMAP: Si se define antes de incluir la libreria grafo_d_mapear() proyecta los archivos
+    en formato binario en memoria con mmap() (POSIX) en lugar de leerlos completos, de modo que
+    cargar un grafo no depende de su tamano. Ejemplo:
+    #define GRAFO_D_MMAP
+
+    GRAFO_D_MALLOC/GRAFO_D_REALLOC/GRAFO_D_FREE/GRAFO_D_CALLOC: Permiten que la libreria reserve
+    toda su memoria (nodos, tablas, vectores, matrices, caminos, versiones, etc.) con un asignador
+    propio, por ejemplo una arena por peticion o un asignador por nodo NUMA. Reciben los mismos
+    argumentos que malloc(), realloc(), free() y calloc(). GRAFO_D_MALLOC, GRAFO_D_REALLOC y
+    GRAFO_D_FREE deben definirse juntos; si no se define GRAFO_D_CALLOC se implementa con
+    GRAFO_D_MALLOC. Para usar un contexto (la arena actual, el nodo NUMA, etc.) las macros pueden
+    hacer referencia a una variable del usuario. Todo lo que la libreria regresa para que el
+    usuario lo libere debe liberarse con GRAFO_D_FREE, que por defecto es free(). Ejemplo:
+    #define GRAFO_D_MALLOC(tam) arena_reservar(arena_actual, tam)
+    #define GRAFO_D_REALLOC(ptr, tam) arena_redimensionar(arena_actual, ptr, tam)
+    #define GRAFO_D_FREE(ptr) arena_liberar(arena_actual, ptr)
+
+    GRAFO_D_CALC_PESO/PESO_CAMPO: Definen en tiempo de compilacion la funcion de pesos por
+    defecto de los grafos, de modo que en grafo_d_dijkstra(), la matriz de pesos y demas
+    operaciones el peso se calcula en linea en lugar de llamar a una funcion mediante un puntero.
+    GRAFO_D_CALC_PESO(ar) recibe un Arista* y debe regresar el peso; PESO_CAMPO nombra el campo del
+    struct de las aristas que contiene el peso. Solo una de las dos debe definirse. Una funcion
+    registrada con grafo_d_set_calc_peso() sigue teniendo prioridad. Ejemplos:
+    #define GRAFO_D_CALC_PESO(ar) ((ar)->distancia*(ar)->factor)
+    #define PESO_CAMPO longitud
+
+    GRAFO_D_CMP_VT/GRAFO_D_CMP_AR: Definen en tiempo de compilacion la comparacion por defecto
+    de vertices/aristas. Reciben dos apuntadores a Vertice o a Arista y deben regresar verdadero
+    si son iguales.
+    Permiten usar las busquedas con vertices o aristas struct sin registrar una funcion y las
+    comparaciones se hacen en linea. Las funciones registradas con grafo_d_set_cmp_vt() y
+    grafo_d_set_cmp_ar() siguen teniendo prioridad. Ejemplo:
+    #define GRAFO_D_CMP_VT(v1, v2) ((v1)->id==(v2)->id)
+
+    GRAFO_D_PREFIJO: Permite incluir la libreria varias veces en un mismo archivo con distintos
+    tipos y modos. Todos los identificadores de la libreria (tipos y funciones) se generan con el
+    prefijo indicado seguido de un guion bajo, por ejemplo vial_Grafo_D y vial_grafo_d_crear(), y
+    cada instancia tiene su propio codigo especializado para sus tipos. Al terminar cada inclusion
+    se eliminan las macros de tipos y modos (DATO_/STRUCT_, DATO_PESO, PESO_NO_ARISTA, GRAFO_D_*),
+    de modo que la siguiente inclusion puede definir otras; el valor de PESO_NO_ARISTA de cada
+    instancia se obtiene con prefijo_grafo_d_peso_no_arista(). Si la libreria se incluye con
+    prefijo, todas sus inclusiones en el archivo deben tenerlo. Ejemplo:
+    #define GRAFO_D_PREFIJO vial
+    #define STRUCT_VERTICE Ciudad
+    #define STRUCT_ARISTA Via
+    #define DATO_PESO double
+    #define PESO_NO_ARISTA HUGE_VAL
+    #define PESO_CAMPO longitud
+    #include "grafo_d.h"
+    #define GRAFO_D_PREFIJO ent
+    #include "grafo_d.h"
 */
 
 /*------------------------Macros y Customizacion de la Libreria------------------------*/
@@ -66,13 +192,25 @@
 
 #ifdef STRUCT_VERTICE
 #define Vertice STRUCT_VERTICE
+#ifndef GRAFO_D_CMP_VT
 #define cmp_vt_default NULL
 #endif
+#endif
 
 #ifdef STRUCT_ARISTA
 #define Arista STRUCT_ARISTA
+#ifndef GRAFO_D_CMP_AR
 #define cmp_ar_default NULL
 #endif
+#endif
+
+#if defined(GRAFO_D_CALC_PESO) && defined(PESO_CAMPO)
+#error "Defina exlusivamente GRAFO_D_CALC_PESO o PESO_CAMPO no ambos"
+#endif
+
+#ifdef PESO_CAMPO
+#define GRAFO_D_CALC_PESO(ar) ((ar)->PESO_CAMPO)
+#endif
 
 #ifdef DATO_VERTICE
 #define Vertice DATO_VERTICE
@@ -102,19 +240,506 @@
 #define PESO_NO_ARISTA INT_MAX
 #endif
 
-#ifndef STRUCT_VERTICE
+#ifndef GRAFO_D_UMBRAL_HASH_ADY
+#define GRAFO_D_UMBRAL_HASH_ADY 32
+#endif
+
+#ifndef GRAFO_D_ADY_LOCAL
+#define GRAFO_D_ADY_LOCAL 4
+#endif
+
+#if defined(GRAFO_D_MALLOC) || defined(GRAFO_D_REALLOC) || defined(GRAFO_D_FREE)
+#if !defined(GRAFO_D_MALLOC) || !defined(GRAFO_D_REALLOC) || !defined(GRAFO_D_FREE)
+#error "Defina juntas las MACROS GRAFO_D_MALLOC, GRAFO_D_REALLOC y GRAFO_D_FREE"
+#endif
+#ifndef GRAFO_D_CALLOC
+/*  !!!FUNCION DE USO INTERNO!!!
+    calloc() implementado con el asignador del usuario
+*/
+static inline void* _grafo_d_calloc(size_t n, size_t tam) {
+    if(tam && n>SIZE_MAX/tam) return NULL;
+    void* ptr=GRAFO_D_MALLOC(n*tam);
+    if(ptr) memset(ptr, 0, n*tam);
+    return ptr;
+}
+#define GRAFO_D_CALLOC(n, tam) _grafo_d_calloc(n, tam)
+#endif
+#else
+#define GRAFO_D_MALLOC(tam) malloc(tam)
+#define GRAFO_D_REALLOC(ptr, tam) realloc(ptr, tam)
+#define GRAFO_D_FREE(ptr) free(ptr)
+#ifndef GRAFO_D_CALLOC
+#define GRAFO_D_CALLOC(n, tam) calloc(n, tam)
+#endif
+#endif
+
+/*  En modo concurrente las operaciones publicas se compilan con un nombre interno sin candado y
+    al final de la libreria se definen con su nombre publico envolviendo la version sin candado.
+    Las llamadas entre funciones de la libreria usan siempre la version sin candado. Con
+    GRAFO_D_PREFIJO los nombres internos se definen siempre y en modo no concurrente corresponden
+    al nombre publico con prefijo, ver abajo.
+*/
+#if defined(GRAFO_D_CONCURRENTE) || defined(GRAFO_D_PREFIJO)
+#define grafo_d_isempty _grafo_d_isempty_sb
+#define grafo_d_buscar_vertice _grafo_d_buscar_vertice_sb
+#define grafo_d_buscar_vertices _grafo_d_buscar_vertices_sb
+#define grafo_d_buscar_arista _grafo_d_buscar_arista_sb
+#define grafo_d_buscar_aristas _grafo_d_buscar_aristas_sb
+#define grafo_d_buscar_arista_entre_vert _grafo_d_buscar_arista_entre_vert_sb
+#define grafo_d_buscar_aristas_entre_vert _grafo_d_buscar_aristas_entre_vert_sb
+#define grafo_d_buscar_arista_estricto _grafo_d_buscar_arista_estricto_sb
+#define grafo_d_buscar_aristas_estricto _grafo_d_buscar_aristas_estricto_sb
+#define grafo_d_buscar_vertices_par _grafo_d_buscar_vertices_par_sb
+#define grafo_d_buscar_aristas_par _grafo_d_buscar_aristas_par_sb
+#define grafo_d_crear_mat_ady _grafo_d_crear_mat_ady_sb
+#define grafo_d_crear_mat_peso _grafo_d_crear_mat_peso_sb
+#define grafo_d_es_simetrico _grafo_d_es_simetrico_sb
+#define grafo_d_crear_mat_peso_sim _grafo_d_crear_mat_peso_sim_sb
+#define grafo_d_crear_mat_bits _grafo_d_crear_mat_bits_sb
+#define grafo_d_dijkstra _grafo_d_dijkstra_sb
+#define grafo_d_print_debug _grafo_d_print_debug_sb
+#define grafo_d_set_cmp_vt _grafo_d_set_cmp_vt_sb
+#define grafo_d_unset_cmp_vt _grafo_d_unset_cmp_vt_sb
+#define grafo_d_set_cmp_ar _grafo_d_set_cmp_ar_sb
+#define grafo_d_unset_cmp_ar _grafo_d_unset_cmp_ar_sb
+#define grafo_d_set_calc_peso _grafo_d_set_calc_peso_sb
+#define grafo_d_unset_calc_peso _grafo_d_unset_calc_peso_sb
+#define grafo_d_set_hash_vt _grafo_d_set_hash_vt_sb
+#define grafo_d_unset_hash_vt _grafo_d_unset_hash_vt_sb
+#define grafo_d_set_hash_ar _grafo_d_set_hash_ar_sb
+#define grafo_d_unset_hash_ar _grafo_d_unset_hash_ar_sb
+#define grafo_d_insertar_vertice _grafo_d_insertar_vertice_sb
+#define grafo_d_eliminar_vertice _grafo_d_eliminar_vertice_sb
+#define grafo_d_insertar_arista _grafo_d_insertar_arista_sb
+#define grafo_d_insertar_arista_par _grafo_d_insertar_arista_par_sb
+#define grafo_d_insertar_arpar _grafo_d_insertar_arpar_sb
+#define grafo_d_elminar_arista _grafo_d_elminar_arista_sb
+#define grafo_d_marcar_modificado _grafo_d_marcar_modificado_sb
+#define grafo_d_snapshot _grafo_d_snapshot_sb
+#define grafo_d_fin_carga_atomica _grafo_d_fin_carga_atomica_sb
+#define grafo_d_guardar_binario _grafo_d_guardar_binario_sb
+#define grafo_d_comprimir _grafo_d_comprimir_sb
+#define grafo_d_exportar_lista _grafo_d_exportar_lista_sb
+#define grafo_d_exportar_dot _grafo_d_exportar_dot_sb
+#define grafo_d_cargar_texto _grafo_d_cargar_texto_sb
+#define grafo_d_diario_iniciar _grafo_d_diario_iniciar_sb
+#define grafo_d_diario_punto_control _grafo_d_diario_punto_control_sb
+#define grafo_d_diario_sincronizar _grafo_d_diario_sincronizar_sb
+#define grafo_d_diario_terminar _grafo_d_diario_terminar_sb
+#define grafo_d_compactar _grafo_d_compactar_sb
+#define grafo_d_clonar _grafo_d_clonar_sb
+#define grafo_d_calcular_orden _grafo_d_calcular_orden_sb
+#define grafo_d_ancho_banda _grafo_d_ancho_banda_sb
+#define grafo_d_reordenar _grafo_d_reordenar_sb
+#define grafo_d_memoria _grafo_d_memoria_sb
+#ifdef GRAFO_D_IDS_32
+#define grafo_d_limite_ids _grafo_d_limite_ids_sb
+#define grafo_d_vertice_por_id _grafo_d_vertice_por_id_sb
+#define grafo_d_ids_ejes _grafo_d_ids_ejes_sb
+#endif
+#endif
+
+/*  Con GRAFO_D_PREFIJO cada identificador de la libreria se define como el mismo identificador con
+    el prefijo. Las definiciones son identicas en cada inclusion y el prefijo se toma al expandirlas,
+    por lo que solo _GD_SB, que depende del modo concurrente, se elimina al terminar la inclusion.
+    Las versiones sin candado de las operaciones envueltas en modo concurrente reciben el nombre
+    publico con prefijo cuando el modo concurrente no esta activo.
+*/
+#ifdef GRAFO_D_PREFIJO
+#define _GD_UNIR2(a, b) a##_##b
+#define _GD_UNIR(a, b) _GD_UNIR2(a, b)
+#define _GD_PREFIJAR(nombre) _GD_UNIR(GRAFO_D_PREFIJO, nombre)
+#define _GD_PUBLICO(nombre) _GD_PREFIJAR(nombre)
+#ifdef GRAFO_D_CONCURRENTE
+#define _GD_SB(nombre) _GD_PREFIJAR(_##nombre##_sb)
+#else
+#define _GD_SB(nombre) _GD_PREFIJAR(nombre)
+#endif
+#define _grafo_d_calloc _GD_PREFIJAR(_grafo_d_calloc)
+#define _grafo_d_cmp_vt_default _GD_PREFIJAR(_grafo_d_cmp_vt_default)
+#define _grafo_d_cmp_ar_default _GD_PREFIJAR(_grafo_d_cmp_ar_default)
+#define _grafo_d_calc_peso_default _GD_PREFIJAR(_grafo_d_calc_peso_default)
+#define _gd_hash_ptr _GD_PREFIJAR(_gd_hash_ptr)
+#define _tabla_h_crear _GD_PREFIJAR(_tabla_h_crear)
+#define _tabla_h_destruir _GD_PREFIJAR(_tabla_h_destruir)
+#define _tabla_h_cubeta _GD_PREFIJAR(_tabla_h_cubeta)
+#define _tabla_h_enlazar _GD_PREFIJAR(_tabla_h_enlazar)
+#define _tabla_h_crecer _GD_PREFIJAR(_tabla_h_crecer)
+#define _tabla_h_insertar _GD_PREFIJAR(_tabla_h_insertar)
+#define _tabla_h_insertar_inicio _GD_PREFIJAR(_tabla_h_insertar_inicio)
+#define _tabla_h_nodo _GD_PREFIJAR(_tabla_h_nodo)
+#define _tabla_h_eliminar _GD_PREFIJAR(_tabla_h_eliminar)
+#define _grafo_d_ady_agregar _GD_PREFIJAR(_grafo_d_ady_agregar)
+#define _grafo_d_ady_quitar _GD_PREFIJAR(_grafo_d_ady_quitar)
+#define grafo_d_hash_bytes _GD_PREFIJAR(grafo_d_hash_bytes)
+#define _grafo_d_iniciar_nodo_v _GD_PREFIJAR(_grafo_d_iniciar_nodo_v)
+#define _grafo_d_reservar_arista _GD_PREFIJAR(_grafo_d_reservar_arista)
+#define _grafo_d_arista_propia _GD_PREFIJAR(_grafo_d_arista_propia)
+#define _grafo_d_liberar_arista _GD_PREFIJAR(_grafo_d_liberar_arista)
+#define _grafo_d_liberar_aristas _GD_PREFIJAR(_grafo_d_liberar_aristas)
+#define _grafo_d_liberar_nodo_v _GD_PREFIJAR(_grafo_d_liberar_nodo_v)
+#define _grafo_d_asignar_id _GD_PREFIJAR(_grafo_d_asignar_id)
+#define _grafo_d_liberar_id _GD_PREFIJAR(_grafo_d_liberar_id)
+#define grafo_d_version_liberar _GD_PREFIJAR(grafo_d_version_liberar)
+#define _grafo_d_diario_registrar _GD_PREFIJAR(_grafo_d_diario_registrar)
+#define _grafo_d_diario_id _GD_PREFIJAR(_grafo_d_diario_id)
+#define _grafo_d_diario_checkpoint _GD_PREFIJAR(_grafo_d_diario_checkpoint)
+#define _grafo_d_diario_cerrar _GD_PREFIJAR(_grafo_d_diario_cerrar)
+#define grafo_d_crear _GD_PREFIJAR(grafo_d_crear)
+#define _grafo_d_set_cmp_vt_sb _GD_SB(grafo_d_set_cmp_vt)
+#define _grafo_d_unset_cmp_vt_sb _GD_SB(grafo_d_unset_cmp_vt)
+#define _grafo_d_set_cmp_ar_sb _GD_SB(grafo_d_set_cmp_ar)
+#define _grafo_d_unset_cmp_ar_sb _GD_SB(grafo_d_unset_cmp_ar)
+#define _grafo_d_set_calc_peso_sb _GD_SB(grafo_d_set_calc_peso)
+#define _grafo_d_unset_calc_peso_sb _GD_SB(grafo_d_unset_calc_peso)
+#define _grafo_d_set_hash_vt_sb _GD_SB(grafo_d_set_hash_vt)
+#define _grafo_d_unset_hash_vt_sb _GD_SB(grafo_d_unset_hash_vt)
+#define _grafo_d_set_hash_ar_sb _GD_SB(grafo_d_set_hash_ar)
+#define _grafo_d_unset_hash_ar_sb _GD_SB(grafo_d_unset_hash_ar)
+#define _grafo_d_indexar_aristas _GD_PREFIJAR(_grafo_d_indexar_aristas)
+#define _grafo_d_desindexar_arista _GD_PREFIJAR(_grafo_d_desindexar_arista)
+#define _grafo_d_marcar_modificado_sb _GD_SB(grafo_d_marcar_modificado)
+#define _grafo_d_isempty_sb _GD_SB(grafo_d_isempty)
+#define grafo_d_destruir _GD_PREFIJAR(grafo_d_destruir)
+#define _grafo_d_insertar_vertice_sb _GD_SB(grafo_d_insertar_vertice)
+#define _grafo_d_buscar_vertice_sb _GD_SB(grafo_d_buscar_vertice)
+#define _grafo_d_buscar_vertices_sb _GD_SB(grafo_d_buscar_vertices)
+#define _grafo_d_eliminar_vertice_sb _GD_SB(grafo_d_eliminar_vertice)
+#define _grafo_d_enlazar_en_vertice _GD_PREFIJAR(_grafo_d_enlazar_en_vertice)
+#define _grafo_d_enlazar_arista _GD_PREFIJAR(_grafo_d_enlazar_arista)
+#define _grafo_d_insertar_arista_sb _GD_SB(grafo_d_insertar_arista)
+#define _grafo_d_insertar_par _GD_PREFIJAR(_grafo_d_insertar_par)
+#define _grafo_d_insertar_arista_par_sb _GD_SB(grafo_d_insertar_arista_par)
+#define _grafo_d_insertar_arpar_sb _GD_SB(grafo_d_insertar_arpar)
+#define _grafo_d_buscar_arista_sb _GD_SB(grafo_d_buscar_arista)
+#define _grafo_d_buscar_aristas_sb _GD_SB(grafo_d_buscar_aristas)
+#define _grafo_d_sig_arista_entre _GD_PREFIJAR(_grafo_d_sig_arista_entre)
+#define _grafo_d_aristas_entre _GD_PREFIJAR(_grafo_d_aristas_entre)
+#define _grafo_d_buscar_arista_entre_vert_sb _GD_SB(grafo_d_buscar_arista_entre_vert)
+#define _grafo_d_buscar_aristas_entre_vert_sb _GD_SB(grafo_d_buscar_aristas_entre_vert)
+#define _grafo_d_buscar_arista_estricto_sb _GD_SB(grafo_d_buscar_arista_estricto)
+#define _grafo_d_buscar_aristas_estricto_sb _GD_SB(grafo_d_buscar_aristas_estricto)
+#define _grafo_d_desenlazar_arista _GD_PREFIJAR(_grafo_d_desenlazar_arista)
+#define _grafo_d_elminar_arista_sb _GD_SB(grafo_d_elminar_arista)
+#define grafo_d_insertar_arista_atomica _GD_PREFIJAR(grafo_d_insertar_arista_atomica)
+#define _grafo_d_fin_carga_atomica_sb _GD_SB(grafo_d_fin_carga_atomica)
+#define grafo_d_iter_vertices _GD_PREFIJAR(grafo_d_iter_vertices)
+#define grafo_d_iter_vertices_filtro _GD_PREFIJAR(grafo_d_iter_vertices_filtro)
+#define iter_v_siguiente _GD_PREFIJAR(iter_v_siguiente)
+#define iter_v_llenar _GD_PREFIJAR(iter_v_llenar)
+#define grafo_d_iter_aristas _GD_PREFIJAR(grafo_d_iter_aristas)
+#define grafo_d_iter_aristas_filtro _GD_PREFIJAR(grafo_d_iter_aristas_filtro)
+#define grafo_d_iter_aristas_de _GD_PREFIJAR(grafo_d_iter_aristas_de)
+#define grafo_d_iter_aristas_entre_vert _GD_PREFIJAR(grafo_d_iter_aristas_entre_vert)
+#define grafo_d_iter_aristas_estricto _GD_PREFIJAR(grafo_d_iter_aristas_estricto)
+#define iter_a_siguiente _GD_PREFIJAR(iter_a_siguiente)
+#define iter_a_destino _GD_PREFIJAR(iter_a_destino)
+#define iter_a_llenar _GD_PREFIJAR(iter_a_llenar)
+#define _grafo_d_num_hilos _GD_PREFIJAR(_grafo_d_num_hilos)
+#define _grafo_d_lanzar_hilos _GD_PREFIJAR(_grafo_d_lanzar_hilos)
+#define _tarea_busq_agregar _GD_PREFIJAR(_tarea_busq_agregar)
+#define _grafo_d_hilo_busq_v _GD_PREFIJAR(_grafo_d_hilo_busq_v)
+#define _grafo_d_hilo_busq_a _GD_PREFIJAR(_grafo_d_hilo_busq_a)
+#define _grafo_d_buscar_par _GD_PREFIJAR(_grafo_d_buscar_par)
+#define _grafo_d_buscar_vertices_par_sb _GD_SB(grafo_d_buscar_vertices_par)
+#define _grafo_d_buscar_aristas_par_sb _GD_SB(grafo_d_buscar_aristas_par)
+#define _gd_pos_sim _GD_PREFIJAR(_gd_pos_sim)
+#define _cmp_indice_v _GD_PREFIJAR(_cmp_indice_v)
+#define _grafo_d_crear_indice_v _GD_PREFIJAR(_grafo_d_crear_indice_v)
+#define _grafo_d_pos_indice_v _GD_PREFIJAR(_grafo_d_pos_indice_v)
+#define _grafo_d_crear_mat_ady_sb _GD_SB(grafo_d_crear_mat_ady)
+#define _grafo_d_crear_mat_peso_sb _GD_SB(grafo_d_crear_mat_peso)
+#define _grafo_d_es_simetrico_sb _GD_SB(grafo_d_es_simetrico)
+#define _grafo_d_crear_mat_peso_sim_sb _GD_SB(grafo_d_crear_mat_peso_sim)
+#define _gd_popcount _GD_PREFIJAR(_gd_popcount)
+#define _grafo_d_crear_mat_bits_sb _GD_SB(grafo_d_crear_mat_bits)
+#define matriz_bits_vecinos_comunes _GD_PREFIJAR(matriz_bits_vecinos_comunes)
+#define matriz_bits_contar_triangulos _GD_PREFIJAR(matriz_bits_contar_triangulos)
+#define matriz_bits_cerradura_transitiva _GD_PREFIJAR(matriz_bits_cerradura_transitiva)
+#define _get_nodo_c_vertice _GD_PREFIJAR(_get_nodo_c_vertice)
+#define _get_nodo_c_minimo _GD_PREFIJAR(_get_nodo_c_minimo)
+#define _liberar_lista_c _GD_PREFIJAR(_liberar_lista_c)
+#define es_camino_valido _GD_PREFIJAR(es_camino_valido)
+#define camino_d_destruir _GD_PREFIJAR(camino_d_destruir)
+#define _grafo_d_dijkstra_sb _GD_SB(grafo_d_dijkstra)
+#define _monticulo_crear _GD_PREFIJAR(_monticulo_crear)
+#define _monticulo_destruir _GD_PREFIJAR(_monticulo_destruir)
+#define _monticulo_subir _GD_PREFIJAR(_monticulo_subir)
+#define _monticulo_actualizar _GD_PREFIJAR(_monticulo_actualizar)
+#define _monticulo_extraer _GD_PREFIJAR(_monticulo_extraer)
+#define _gd_relajar _GD_PREFIJAR(_gd_relajar)
+#define _gd_dijkstra_pos _GD_PREFIJAR(_gd_dijkstra_pos)
+#define _grafo_d_liberar_bloques _GD_PREFIJAR(_grafo_d_liberar_bloques)
+#define grafo_d_version_retener _GD_PREFIJAR(grafo_d_version_retener)
+#define _grafo_d_snapshot_sb _GD_SB(grafo_d_snapshot)
+#define grafo_d_version_orden _GD_PREFIJAR(grafo_d_version_orden)
+#define grafo_d_version_tamano _GD_PREFIJAR(grafo_d_version_tamano)
+#define grafo_d_version_vertice _GD_PREFIJAR(grafo_d_version_vertice)
+#define grafo_d_version_grado _GD_PREFIJAR(grafo_d_version_grado)
+#define grafo_d_version_arista _GD_PREFIJAR(grafo_d_version_arista)
+#define grafo_d_version_destino _GD_PREFIJAR(grafo_d_version_destino)
+#define grafo_d_version_posicion _GD_PREFIJAR(grafo_d_version_posicion)
+#define grafo_d_version_buscar_vertice _GD_PREFIJAR(grafo_d_version_buscar_vertice)
+#define _grafo_d_version_relajar _GD_PREFIJAR(_grafo_d_version_relajar)
+#define _grafo_d_version_vertice _GD_PREFIJAR(_grafo_d_version_vertice)
+#define grafo_d_version_dijkstra _GD_PREFIJAR(grafo_d_version_dijkstra)
+#define _grafo_d_bin_secciones _GD_PREFIJAR(_grafo_d_bin_secciones)
+#define _grafo_d_bin_rellenar _GD_PREFIJAR(_grafo_d_bin_rellenar)
+#define _grafo_d_guardar_binario_sb _GD_SB(grafo_d_guardar_binario)
+#define _grafo_d_bin_validar _GD_PREFIJAR(_grafo_d_bin_validar)
+#define _grafo_d_abrir_archivo _GD_PREFIJAR(_grafo_d_abrir_archivo)
+#define _grafo_d_soltar_archivo _GD_PREFIJAR(_grafo_d_soltar_archivo)
+#define grafo_d_mapear _GD_PREFIJAR(grafo_d_mapear)
+#define grafo_d_mapa_cerrar _GD_PREFIJAR(grafo_d_mapa_cerrar)
+#define grafo_d_mapa_validar _GD_PREFIJAR(grafo_d_mapa_validar)
+#define grafo_d_mapa_grado _GD_PREFIJAR(grafo_d_mapa_grado)
+#define grafo_d_mapa_arista _GD_PREFIJAR(grafo_d_mapa_arista)
+#define grafo_d_mapa_destino _GD_PREFIJAR(grafo_d_mapa_destino)
+#define _grafo_d_mapa_relajar _GD_PREFIJAR(_grafo_d_mapa_relajar)
+#define _grafo_d_mapa_vertice _GD_PREFIJAR(_grafo_d_mapa_vertice)
+#define grafo_d_mapa_dijkstra _GD_PREFIJAR(grafo_d_mapa_dijkstra)
+#define grafo_d_desde_mapa _GD_PREFIJAR(grafo_d_desde_mapa)
+#define _gd_leer_varint _GD_PREFIJAR(_gd_leer_varint)
+#define _gd_escribir_varint _GD_PREFIJAR(_gd_escribir_varint)
+#define _cmp_arista_c _GD_PREFIJAR(_cmp_arista_c)
+#define grafo_d_comprimido_destruir _GD_PREFIJAR(grafo_d_comprimido_destruir)
+#define _grafo_d_comprimir_sb _GD_SB(grafo_d_comprimir)
+#define grafo_d_comprimido_orden _GD_PREFIJAR(grafo_d_comprimido_orden)
+#define grafo_d_comprimido_tamano _GD_PREFIJAR(grafo_d_comprimido_tamano)
+#define grafo_d_comprimido_vertice _GD_PREFIJAR(grafo_d_comprimido_vertice)
+#define grafo_d_comprimido_arista _GD_PREFIJAR(grafo_d_comprimido_arista)
+#define grafo_d_comprimido_vecinos _GD_PREFIJAR(grafo_d_comprimido_vecinos)
+#define iter_c_siguiente _GD_PREFIJAR(iter_c_siguiente)
+#define grafo_d_comprimido_grado _GD_PREFIJAR(grafo_d_comprimido_grado)
+#define _grafo_d_comprimido_relajar _GD_PREFIJAR(_grafo_d_comprimido_relajar)
+#define _grafo_d_comprimido_vertice _GD_PREFIJAR(_grafo_d_comprimido_vertice)
+#define grafo_d_comprimido_dijkstra _GD_PREFIJAR(grafo_d_comprimido_dijkstra)
+#define _gd_leer_natural _GD_PREFIJAR(_gd_leer_natural)
+#define _gd_leer_real _GD_PREFIJAR(_gd_leer_real)
+#define _grafo_d_leer_ar_default _GD_PREFIJAR(_grafo_d_leer_ar_default)
+#define _gd_separar_campos _GD_PREFIJAR(_gd_separar_campos)
+#define _grafo_d_hilo_texto _GD_PREFIJAR(_grafo_d_hilo_texto)
+#define _grafo_d_hilo_enlazar _GD_PREFIJAR(_grafo_d_hilo_enlazar)
+#define _grafo_d_cargar_texto_sb _GD_SB(grafo_d_cargar_texto)
+#define _escritor_vaciar _GD_PREFIJAR(_escritor_vaciar)
+#define _escritor_bytes _GD_PREFIJAR(_escritor_bytes)
+#define _escritor_char _GD_PREFIJAR(_escritor_char)
+#define _escritor_cadena _GD_PREFIJAR(_escritor_cadena)
+#define _escritor_natural _GD_PREFIJAR(_escritor_natural)
+#define _escritor_entero _GD_PREFIJAR(_escritor_entero)
+#define _escritor_real _GD_PREFIJAR(_escritor_real)
+#define _escritor_peso _GD_PREFIJAR(_escritor_peso)
+#define _escritor_abrir _GD_PREFIJAR(_escritor_abrir)
+#define _escritor_cerrar _GD_PREFIJAR(_escritor_cerrar)
+#define matriz_peso_guardar_mm _GD_PREFIJAR(matriz_peso_guardar_mm)
+#define _gd_mm_cabecera_patron _GD_PREFIJAR(_gd_mm_cabecera_patron)
+#define _gd_mm_celda_patron _GD_PREFIJAR(_gd_mm_celda_patron)
+#define matriz_ady_guardar_mm _GD_PREFIJAR(matriz_ady_guardar_mm)
+#define _gd_ctz _GD_PREFIJAR(_gd_ctz)
+#define matriz_bits_guardar_mm _GD_PREFIJAR(matriz_bits_guardar_mm)
+#define _gd_igual_ci _GD_PREFIJAR(_gd_igual_ci)
+#define _gd_mm_campo _GD_PREFIJAR(_gd_mm_campo)
+#define _gd_mm_cabecera _GD_PREFIJAR(_gd_mm_cabecera)
+#define _gd_mm_posicion _GD_PREFIJAR(_gd_mm_posicion)
+#define _gd_mm_peso _GD_PREFIJAR(_gd_mm_peso)
+#define matriz_peso_cargar_mm _GD_PREFIJAR(matriz_peso_cargar_mm)
+#define matriz_bits_cargar_mm _GD_PREFIJAR(matriz_bits_cargar_mm)
+#define _grafo_d_diario_nombre _GD_PREFIJAR(_grafo_d_diario_nombre)
+#define _grafo_d_diario_asignar _GD_PREFIJAR(_grafo_d_diario_asignar)
+#define _grafo_d_diario_numerar _GD_PREFIJAR(_grafo_d_diario_numerar)
+#define _grafo_d_diario_validar _GD_PREFIJAR(_grafo_d_diario_validar)
+#define _grafo_d_diario_iniciar_sb _GD_SB(grafo_d_diario_iniciar)
+#define _grafo_d_diario_punto_control_sb _GD_SB(grafo_d_diario_punto_control)
+#define _grafo_d_diario_sincronizar_sb _GD_SB(grafo_d_diario_sincronizar)
+#define _grafo_d_diario_terminar_sb _GD_SB(grafo_d_diario_terminar)
+#define _gd_tam_registro _GD_PREFIJAR(_gd_tam_registro)
+#define grafo_d_diario_recuperar _GD_PREFIJAR(grafo_d_diario_recuperar)
+#define _escritor_iniciar _GD_PREFIJAR(_escritor_iniciar)
+#define _escritor_formato _GD_PREFIJAR(_escritor_formato)
+#define _escritor_vt _GD_PREFIJAR(_escritor_vt)
+#define _escritor_ar _GD_PREFIJAR(_escritor_ar)
+#define _gd_con_texto_ar _GD_PREFIJAR(_gd_con_texto_ar)
+#define _grafo_d_exportar_lista_sb _GD_SB(grafo_d_exportar_lista)
+#define _grafo_d_exportar_dot_sb _GD_SB(grafo_d_exportar_dot)
+#define _cmp_par_traduccion _GD_PREFIJAR(_cmp_par_traduccion)
+#define _grafo_d_traducir _GD_PREFIJAR(_grafo_d_traducir)
+#define _grafo_d_crear_traduccion _GD_PREFIJAR(_grafo_d_crear_traduccion)
+#define grafo_d_traduccion_destruir _GD_PREFIJAR(grafo_d_traduccion_destruir)
+#define grafo_d_traducir_vertice _GD_PREFIJAR(grafo_d_traducir_vertice)
+#define grafo_d_traducir_arista _GD_PREFIJAR(grafo_d_traducir_arista)
+#define _grafo_d_trasladar_indice_ar _GD_PREFIJAR(_grafo_d_trasladar_indice_ar)
+#define _grafo_d_reindexar _GD_PREFIJAR(_grafo_d_reindexar)
+#define _grafo_d_bytes_lotes _GD_PREFIJAR(_grafo_d_bytes_lotes)
+#define _grafo_d_copiar_nodo_v _GD_PREFIJAR(_grafo_d_copiar_nodo_v)
+#define _grafo_d_compactar_sb _GD_SB(grafo_d_compactar)
+#define _gd_mapa_nodo _GD_PREFIJAR(_gd_mapa_nodo)
+#define _grafo_d_clonar_sb _GD_SB(grafo_d_clonar)
+#define _grafo_d_csr_simetrico _GD_PREFIJAR(_grafo_d_csr_simetrico)
+#define _gd_ancho_banda _GD_PREFIJAR(_gd_ancho_banda)
+#define _cmp_grado_asc _GD_PREFIJAR(_cmp_grado_asc)
+#define _cmp_grado_desc _GD_PREFIJAR(_cmp_grado_desc)
+#define _gd_ordenar_por_grado _GD_PREFIJAR(_gd_ordenar_por_grado)
+#define _gd_vecinos_por_grado _GD_PREFIJAR(_gd_vecinos_por_grado)
+#define _gd_orden_bfs _GD_PREFIJAR(_gd_orden_bfs)
+#define _gd_gorder_cambiar _GD_PREFIJAR(_gd_gorder_cambiar)
+#define _gd_gorder_ventana _GD_PREFIJAR(_gd_gorder_ventana)
+#define _gd_orden_gorder _GD_PREFIJAR(_gd_orden_gorder)
+#define _grafo_d_calcular_orden_sb _GD_SB(grafo_d_calcular_orden)
+#define _grafo_d_ancho_banda_sb _GD_SB(grafo_d_ancho_banda)
+#define _grafo_d_reordenar_sb _GD_SB(grafo_d_reordenar)
+#define _gd_memoria_tabla _GD_PREFIJAR(_gd_memoria_tabla)
+#define _gd_memoria_total _GD_PREFIJAR(_gd_memoria_total)
+#define _grafo_d_memoria_sb _GD_SB(grafo_d_memoria)
+#define grafo_d_version_memoria _GD_PREFIJAR(grafo_d_version_memoria)
+#define grafo_d_comprimido_memoria _GD_PREFIJAR(grafo_d_comprimido_memoria)
+#define matriz_ady_memoria _GD_PREFIJAR(matriz_ady_memoria)
+#define matriz_peso_memoria _GD_PREFIJAR(matriz_peso_memoria)
+#define matriz_peso_sim_memoria _GD_PREFIJAR(matriz_peso_sim_memoria)
+#define matriz_bits_memoria _GD_PREFIJAR(matriz_bits_memoria)
+#define camino_d_memoria _GD_PREFIJAR(camino_d_memoria)
+#define grafo_d_id _GD_PREFIJAR(grafo_d_id)
+#define grafo_d_destino_id _GD_PREFIJAR(grafo_d_destino_id)
+#define _grafo_d_limite_ids_sb _GD_SB(grafo_d_limite_ids)
+#define _grafo_d_vertice_por_id_sb _GD_SB(grafo_d_vertice_por_id)
+#define grafo_d_camino_ids _GD_PREFIJAR(grafo_d_camino_ids)
+#define _grafo_d_ids_ejes_sb _GD_SB(grafo_d_ids_ejes)
+#define _grafo_d_print_debug_sb _GD_SB(grafo_d_print_debug)
+#define grafo_d_bloquear_lectura _GD_PREFIJAR(grafo_d_bloquear_lectura)
+#define grafo_d_bloquear_escritura _GD_PREFIJAR(grafo_d_bloquear_escritura)
+#define grafo_d_desbloquear _GD_PREFIJAR(grafo_d_desbloquear)
+#define _gd_bin_magia _GD_PREFIJAR(_gd_bin_magia)
+#define _gd_diario_magia _GD_PREFIJAR(_gd_diario_magia)
+#define Vect_V _GD_PREFIJAR(Vect_V)
+#define Vect_A _GD_PREFIJAR(Vect_A)
+#define _Nodo_H _GD_PREFIJAR(_Nodo_H)
+#define _Tabla_H _GD_PREFIJAR(_Tabla_H)
+#define Nodo_A _GD_PREFIJAR(Nodo_A)
+#define Nodo_V _GD_PREFIJAR(Nodo_V)
+#define _Lote_A _GD_PREFIJAR(_Lote_A)
+#define Grafo_D _GD_PREFIJAR(Grafo_D)
+#define Iter_V _GD_PREFIJAR(Iter_V)
+#define Iter_A _GD_PREFIJAR(Iter_A)
+#define _Tarea_Busq _GD_PREFIJAR(_Tarea_Busq)
+#define Matriz_Ady _GD_PREFIJAR(Matriz_Ady)
+#define Matriz_Peso _GD_PREFIJAR(Matriz_Peso)
+#define Matriz_Peso_Sim _GD_PREFIJAR(Matriz_Peso_Sim)
+#define _Indice_V _GD_PREFIJAR(_Indice_V)
+#define Matriz_Bits _GD_PREFIJAR(Matriz_Bits)
+#define _Nodo_C _GD_PREFIJAR(_Nodo_C)
+#define Camino_D _GD_PREFIJAR(Camino_D)
+#define _Monticulo _GD_PREFIJAR(_Monticulo)
+#define _Dijkstra_D _GD_PREFIJAR(_Dijkstra_D)
+#define _Arista_Ver _GD_PREFIJAR(_Arista_Ver)
+#define _Bloque_V _GD_PREFIJAR(_Bloque_V)
+#define Grafo_D_Version _GD_PREFIJAR(Grafo_D_Version)
+#define _Cabecera_Bin _GD_PREFIJAR(_Cabecera_Bin)
+#define Grafo_D_Mapa _GD_PREFIJAR(Grafo_D_Mapa)
+#define _Bloque_C _GD_PREFIJAR(_Bloque_C)
+#define Grafo_D_Comprimido _GD_PREFIJAR(Grafo_D_Comprimido)
+#define Iter_C _GD_PREFIJAR(Iter_C)
+#define _Arista_C _GD_PREFIJAR(_Arista_C)
+#define _Arista_Txt _GD_PREFIJAR(_Arista_Txt)
+#define _Tarea_Texto _GD_PREFIJAR(_Tarea_Texto)
+#define _Escritor _GD_PREFIJAR(_Escritor)
+#define _Cabecera_MM _GD_PREFIJAR(_Cabecera_MM)
+#define _Cabecera_Diario _GD_PREFIJAR(_Cabecera_Diario)
+#define _Diario _GD_PREFIJAR(_Diario)
+#define _Par_Traduccion _GD_PREFIJAR(_Par_Traduccion)
+#define Grafo_D_Traduccion _GD_PREFIJAR(Grafo_D_Traduccion)
+#define _Grado_P _GD_PREFIJAR(_Grado_P)
+#define _Entrada_G _GD_PREFIJAR(_Entrada_G)
+#define Grafo_D_Memoria _GD_PREFIJAR(Grafo_D_Memoria)
+#define vect_v _GD_PREFIJAR(vect_v)
+#define vect_a _GD_PREFIJAR(vect_a)
+#define _nodo_h _GD_PREFIJAR(_nodo_h)
+#define _tabla_h _GD_PREFIJAR(_tabla_h)
+#define _bloque_v _GD_PREFIJAR(_bloque_v)
+#define grafo_d_version _GD_PREFIJAR(grafo_d_version)
+#define _diario _GD_PREFIJAR(_diario)
+#define nodo_a _GD_PREFIJAR(nodo_a)
+#define nodo_v _GD_PREFIJAR(nodo_v)
+#define _lote_a _GD_PREFIJAR(_lote_a)
+#define grafo_d _GD_PREFIJAR(grafo_d)
+#define iter_v _GD_PREFIJAR(iter_v)
+#define iter_a _GD_PREFIJAR(iter_a)
+#define _tarea_busq _GD_PREFIJAR(_tarea_busq)
+#define matriz_ady _GD_PREFIJAR(matriz_ady)
+#define matriz_peso _GD_PREFIJAR(matriz_peso)
+#define matriz_peso_sim _GD_PREFIJAR(matriz_peso_sim)
+#define _indice_v _GD_PREFIJAR(_indice_v)
+#define matriz_bits _GD_PREFIJAR(matriz_bits)
+#define _nodo_c _GD_PREFIJAR(_nodo_c)
+#define camino_d _GD_PREFIJAR(camino_d)
+#define _monticulo _GD_PREFIJAR(_monticulo)
+#define _dijkstra_d _GD_PREFIJAR(_dijkstra_d)
+#define _arista_ver _GD_PREFIJAR(_arista_ver)
+#define _cabecera_bin _GD_PREFIJAR(_cabecera_bin)
+#define grafo_d_mapa _GD_PREFIJAR(grafo_d_mapa)
+#define _bloque_c _GD_PREFIJAR(_bloque_c)
+#define grafo_d_comprimido _GD_PREFIJAR(grafo_d_comprimido)
+#define iter_c _GD_PREFIJAR(iter_c)
+#define _arista_c _GD_PREFIJAR(_arista_c)
+#define _arista_txt _GD_PREFIJAR(_arista_txt)
+#define _tarea_texto _GD_PREFIJAR(_tarea_texto)
+#define _escritor _GD_PREFIJAR(_escritor)
+#define _cabecera_mm _GD_PREFIJAR(_cabecera_mm)
+#define _cabecera_diario _GD_PREFIJAR(_cabecera_diario)
+#define _par_traduccion _GD_PREFIJAR(_par_traduccion)
+#define grafo_d_traduccion _GD_PREFIJAR(grafo_d_traduccion)
+#define _grado_p _GD_PREFIJAR(_grado_p)
+#define _entrada_g _GD_PREFIJAR(_entrada_g)
+#define grafo_d_peso_no_arista _GD_PREFIJAR(grafo_d_peso_no_arista)
+#else
+#define _GD_PUBLICO(nombre) nombre
+#endif
+
+#if defined(GRAFO_D_CMP_VT)
+static bool _grafo_d_cmp_vt_default(Vertice* v1, Vertice* v2) {return (GRAFO_D_CMP_VT(v1, v2));}
+#define cmp_vt_default _grafo_d_cmp_vt_default
+#elif !defined(STRUCT_VERTICE)
 static bool _grafo_d_cmp_vt_default(Vertice* v1, Vertice* v2) {return *v1==*v2;}
 #define cmp_vt_default _grafo_d_cmp_vt_default
 #endif
 
-#ifndef STRUCT_ARISTA
+#if defined(GRAFO_D_CMP_AR)
+static bool _grafo_d_cmp_ar_default(Arista* a1, Arista* a2) {return (GRAFO_D_CMP_AR(a1, a2));}
+#define cmp_ar_default _grafo_d_cmp_ar_default
+#elif !defined(STRUCT_ARISTA)
 static bool _grafo_d_cmp_ar_default(Arista* a1, Arista* a2) {return *a1==*a2;}
 #define cmp_ar_default _grafo_d_cmp_ar_default
 #endif
 
-static peso_t _grafo_d_calc_peso_default(Arista* arista) {return (peso_t)1;}
+#ifdef GRAFO_D_CALC_PESO
+static peso_t _grafo_d_calc_peso_default(Arista* arista) {return (peso_t)(GRAFO_D_CALC_PESO(arista));}
+#else
+static peso_t _grafo_d_calc_peso_default(Arista* arista) {(void)arista; return (peso_t)1;}
+#endif
 #define calc_peso_default _grafo_d_calc_peso_default
 
+/*  Regresa el valor PESO_NO_ARISTA de la libreria, util con GRAFO_D_PREFIJO donde la macro se
+    elimina al terminar la inclusion
+*/
+static inline peso_t grafo_d_peso_no_arista(void) {return PESO_NO_ARISTA;}
+
+/*  !!!MACROS DE USO INTERNO!!!
+    Llaman a la funcion de comparacion o de pesos f. Si f es la funcion por defecto se llama
+    directamente para que el compilador pueda expandirla en linea en lugar de hacer una llamada
+    indirecta en cada arista.
+*/
+#if defined(GRAFO_D_CMP_VT) || !defined(STRUCT_VERTICE)
+#define _GD_CMP_VT(f, v1, v2) ((f)==_grafo_d_cmp_vt_default ? _grafo_d_cmp_vt_default(v1, v2) : (f)(v1, v2))
+#else
+#define _GD_CMP_VT(f, v1, v2) ((f)(v1, v2))
+#endif
+
+#if defined(GRAFO_D_CMP_AR) || !defined(STRUCT_ARISTA)
+#define _GD_CMP_AR(f, a1, a2) ((f)==_grafo_d_cmp_ar_default ? _grafo_d_cmp_ar_default(a1, a2) : (f)(a1, a2))
+#else
+#define _GD_CMP_AR(f, a1, a2) ((f)(a1, a2))
+#endif
+
+#define _GD_PESO(f, ar) ((f)==_grafo_d_calc_peso_default ? _grafo_d_calc_peso_default(ar) : (f)(ar))
+
 /*----------------------Definicion de los tipos de datos de interfaz---------------------*/
 
 typedef struct vect_v {
@@ -127,6 +752,46 @@ typedef struct vect_a {
     Arista* aristas[];
 } Vect_A;
 
+/*  !!!ESTRUCTURA DE USO INTERNO!!!
+    Tabla hash con encadenamiento usada por los indices opcionales del grafo. Cada nodo guarda
+    el valor hash del elemento para no recalcularlo al crecer la tabla y un puntero generico al
+    elemento indexado. Dentro de cada cubeta los elementos se mantienen en orden de insercion.
+    Las cubetas son listas doblemente enlazadas en las que el campo ant del primer nodo apunta al
+    ultimo, para insertar al final en tiempo constante aunque muchos elementos compartan el valor
+    hash. Ademas cada nodo esta en una segunda cubeta segun la direccion del elemento, para
+    encontrarlo y eliminarlo sin recorrer la cubeta de su valor hash.
+*/
+typedef struct _nodo_h {
+    struct _nodo_h* sig;
+    struct _nodo_h* ant;
+    struct _nodo_h* sig_dir;
+    size_t hash;
+    void* elem;
+} _Nodo_H;
+
+typedef struct _tabla_h {
+    size_t capacidad;
+    size_t elementos;
+    _Nodo_H** cubetas;
+    _Nodo_H** cubetas_dir;
+} _Tabla_H;
+
+/*  !!!MACROS DE USO INTERNO!!!
+    Incrementan/decrementan un contador de referencias compartido entre hilos y regresan
+    el nuevo valor.
+*/
+#if defined(__GNUC__) || defined(__clang__)
+#define _GD_REF_INC(contador) __atomic_add_fetch(&(contador), 1, __ATOMIC_RELAXED)
+#define _GD_REF_DEC(contador) __atomic_sub_fetch(&(contador), 1, __ATOMIC_ACQ_REL)
+#else
+#define _GD_REF_INC(contador) (++(contador))
+#define _GD_REF_DEC(contador) (--(contador))
+#endif
+
+struct _bloque_v;
+struct grafo_d_version;
+struct _diario;
+
 struct nodo_a;
 typedef struct nodo_a Nodo_A;
 struct nodo_v;
@@ -134,15 +799,41 @@ typedef struct nodo_v Nodo_V;
 
 struct nodo_a {
     struct nodo_a* sig;
+#ifdef GRAFO_D_IDS_32
+    uint32_t fin;
+    Arista ar;
+#else
     Arista ar;
     Nodo_V* fin;
+#endif
 };
 
+/*  !!!ESTRUCTURA DE USO INTERNO!!!
+    Lote contiguo de nodos de arista que un vertice reserva de una sola vez cuando se le acaban
+    los nodos locales, ver la seccion Almacenamiento de las Aristas
+*/
+typedef struct _lote_a {
+    struct _lote_a* sig;
+    size_t capacidad;
+    bool en_region;             //Reservado dentro de la region de grafo_d_compactar()
+    Nodo_A nodos[];
+} _Lote_A;
+
 struct nodo_v {
     struct nodo_v* sig;
     Vertice vt;
     size_t grado_s;
     Nodo_A* lista_ady;
+    _Tabla_H* indice_ady;
+    struct _bloque_v* bloque;
+#ifdef GRAFO_D_IDS_32
+    uint32_t id;
+#endif
+    Nodo_A* libres;
+    _Lote_A* lotes;
+#if GRAFO_D_ADY_LOCAL>0
+    Nodo_A ady_local[GRAFO_D_ADY_LOCAL];
+#endif
 };
 
 typedef struct grafo_d {
@@ -153,16 +844,446 @@ typedef struct grafo_d {
     bool (*cmp_vt)(Vertice*, Vertice*);
     bool (*cmp_ar)(Arista*, Arista*);
     peso_t (*calc_peso)(Arista*);
+    size_t (*hash_vt)(Vertice*);
+    size_t (*hash_ar)(Arista*);
+    _Tabla_H* indice_vt;
+    _Tabla_H* indice_ar;
+    struct grafo_d_version* version;
+    struct _diario* diario;
+    Nodo_V* region_v;
+    size_t region_orden;
+    char* region_a;
+    size_t region_bytes_a;
+#ifdef GRAFO_D_IDS_32
+    Nodo_V** nodos_id;
+    uint32_t* ids_libres;
+    size_t num_ids;
+    size_t num_libres;
+    size_t capacidad_ids;
+#endif
+#ifdef GRAFO_D_CONCURRENTE
+    pthread_rwlock_t bloqueo;
+#endif
+#ifdef _GD_TORNIQUETE
+    pthread_mutex_t torniquete;
+#endif
 } Grafo_D;
 
+/*-----------------------------Tablas hash de uso interno-------------------------------*/
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Mezcla los bits de una direccion de memoria para usarla como valor hash
+*/
+static inline size_t _gd_hash_ptr(const void* ptr) {
+    uint64_t x=(uint64_t)(uintptr_t)ptr;
+    x^=x>>33;
+    x*=0xff51afd7ed558ccdULL;
+    x^=x>>33;
+    return (size_t)x;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Crea una tabla hash vacia con al menos la capacidad indicada, la capacidad real siempre
+    es una potencia de 2.
+*/
+static _Tabla_H* _tabla_h_crear(size_t capacidad) {
+    _Tabla_H* tabla=(_Tabla_H*)GRAFO_D_MALLOC(sizeof(_Tabla_H));
+    if(!tabla) return NULL;
+    tabla->capacidad=16;
+    while(tabla->capacidad<capacidad) tabla->capacidad<<=1;
+    tabla->elementos=0;
+    tabla->cubetas=(_Nodo_H**)GRAFO_D_CALLOC(tabla->capacidad, sizeof(_Nodo_H*));
+    tabla->cubetas_dir=(_Nodo_H**)GRAFO_D_CALLOC(tabla->capacidad, sizeof(_Nodo_H*));
+    if(!tabla->cubetas || !tabla->cubetas_dir) {
+        GRAFO_D_FREE(tabla->cubetas); GRAFO_D_FREE(tabla->cubetas_dir); GRAFO_D_FREE(tabla);
+        return NULL;
+    }
+    return tabla;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Libera la tabla hash y todos sus nodos, los elementos indexados no se modifican
+*/
+static void _tabla_h_destruir(_Tabla_H* tabla) {
+    for(size_t i=0; i<tabla->capacidad; ++i) {
+        _Nodo_H* hptr=tabla->cubetas[i], *htmp;
+        while(hptr!=NULL) {
+            htmp=hptr;
+            hptr=hptr->sig;
+            GRAFO_D_FREE(htmp);
+        }
+    }
+    GRAFO_D_FREE(tabla->cubetas);
+    GRAFO_D_FREE(tabla->cubetas_dir);
+    GRAFO_D_FREE(tabla);
+    return;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa el primer nodo de la cubeta que corresponde al valor hash dado
+*/
+static inline _Nodo_H* _tabla_h_cubeta(const _Tabla_H* tabla, size_t hash) {
+    return tabla->cubetas[hash&(tabla->capacidad-1)];
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Enlaza el nodo al final (o al principio si inicio es verdadero) de su cubeta de hash y en su
+    cubeta de direccion, en arreglos de cubetas de la capacidad indicada
+*/
+static inline void _tabla_h_enlazar(_Nodo_H** cubetas, _Nodo_H** cubetas_dir, size_t capacidad,
+    _Nodo_H* nuevo, bool inicio) {
+    _Nodo_H** cubeta=&(cubetas[nuevo->hash&(capacidad-1)]);
+    if(*cubeta==NULL) {
+        nuevo->sig=NULL;
+        nuevo->ant=nuevo;
+        *cubeta=nuevo;
+    }
+    else if(inicio) {
+        nuevo->sig=*cubeta;
+        nuevo->ant=(*cubeta)->ant;
+        (*cubeta)->ant=nuevo;
+        *cubeta=nuevo;
+    }
+    else {
+        nuevo->sig=NULL;
+        nuevo->ant=(*cubeta)->ant;
+        (*cubeta)->ant->sig=nuevo;
+        (*cubeta)->ant=nuevo;
+    }
+    _Nodo_H** cubeta_dir=&(cubetas_dir[_gd_hash_ptr(nuevo->elem)&(capacidad-1)]);
+    nuevo->sig_dir=*cubeta_dir;
+    *cubeta_dir=nuevo;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Duplica la capacidad de la tabla conservando el orden de los elementos dentro de cada
+    cubeta. Si no hay memoria la tabla se queda como estaba.
+*/
+static void _tabla_h_crecer(_Tabla_H* tabla) {
+    size_t capacidad=tabla->capacidad<<1;
+    _Nodo_H** cubetas=(_Nodo_H**)GRAFO_D_CALLOC(capacidad, sizeof(_Nodo_H*));
+    _Nodo_H** cubetas_dir=(_Nodo_H**)GRAFO_D_CALLOC(capacidad, sizeof(_Nodo_H*));
+    if(!cubetas || !cubetas_dir) {GRAFO_D_FREE(cubetas); GRAFO_D_FREE(cubetas_dir); return;}
+    for(size_t i=0; i<tabla->capacidad; ++i) {
+        _Nodo_H* hptr=tabla->cubetas[i];
+        while(hptr!=NULL) {
+            _Nodo_H* htmp=hptr->sig;
+            _tabla_h_enlazar(cubetas, cubetas_dir, capacidad, hptr, false);
+            hptr=htmp;
+        }
+    }
+    GRAFO_D_FREE(tabla->cubetas);
+    GRAFO_D_FREE(tabla->cubetas_dir);
+    tabla->cubetas=cubetas;
+    tabla->cubetas_dir=cubetas_dir;
+    tabla->capacidad=capacidad;
+    return;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Inserta el elemento al final de su cubeta en tiempo constante, regresa false si no hay
+    memoria. Un mismo elemento no debe insertarse dos veces en la tabla.
+*/
+static bool _tabla_h_insertar(_Tabla_H* tabla, size_t hash, void* elem) {
+    _Nodo_H* nuevo=(_Nodo_H*)GRAFO_D_MALLOC(sizeof(_Nodo_H));
+    if(!nuevo) return false;
+    nuevo->hash=hash;
+    nuevo->elem=elem;
+    _tabla_h_enlazar(tabla->cubetas, tabla->cubetas_dir, tabla->capacidad, nuevo, false);
+    ++(tabla->elementos);
+    if(tabla->elementos>tabla->capacidad) _tabla_h_crecer(tabla);
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Inserta el elemento al principio de su cubeta, regresa false si no hay memoria
+*/
+static bool _tabla_h_insertar_inicio(_Tabla_H* tabla, size_t hash, void* elem) {
+    _Nodo_H* nuevo=(_Nodo_H*)GRAFO_D_MALLOC(sizeof(_Nodo_H));
+    if(!nuevo) return false;
+    nuevo->hash=hash;
+    nuevo->elem=elem;
+    _tabla_h_enlazar(tabla->cubetas, tabla->cubetas_dir, tabla->capacidad, nuevo, true);
+    ++(tabla->elementos);
+    if(tabla->elementos>tabla->capacidad) _tabla_h_crecer(tabla);
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa el nodo de la tabla que apunta a elem o NULL si elem no esta en la tabla. Se busca
+    por la direccion de elem, por lo que no depende de su contenido ni del numero de elementos
+    con el mismo valor hash.
+*/
+static _Nodo_H* _tabla_h_nodo(const _Tabla_H* tabla, const void* elem) {
+    _Nodo_H* hptr=tabla->cubetas_dir[_gd_hash_ptr(elem)&(tabla->capacidad-1)];
+    while(hptr!=NULL && hptr->elem!=elem) hptr=hptr->sig_dir;
+    return hptr;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Elimina de la tabla el nodo que apunta a elem en tiempo constante promedio, aunque el
+    contenido de elem haya cambiado desde que fue indexado. Regresa si el elemento fue encontrado.
+*/
+static bool _tabla_h_eliminar(_Tabla_H* tabla, const void* elem) {
+    _Nodo_H** dir=&(tabla->cubetas_dir[_gd_hash_ptr(elem)&(tabla->capacidad-1)]);
+    while(*dir!=NULL && (*dir)->elem!=elem) dir=&((*dir)->sig_dir);
+    _Nodo_H* htmp=*dir;
+    if(htmp==NULL) return false;
+    *dir=htmp->sig_dir;
+    _Nodo_H** cubeta=&(tabla->cubetas[htmp->hash&(tabla->capacidad-1)]);
+    if(htmp==*cubeta) {
+        *cubeta=htmp->sig;
+        if(htmp->sig!=NULL) htmp->sig->ant=htmp->ant;
+    }
+    else {
+        htmp->ant->sig=htmp->sig;
+        if(htmp->sig!=NULL) htmp->sig->ant=htmp->ant;
+        else (*cubeta)->ant=htmp->ant;
+    }
+    GRAFO_D_FREE(htmp);
+    --(tabla->elementos);
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Obtiene el Nodo_V que contiene al vertice identificado por vt. vt debe ser un
+    identificador valido de un vertice del grafo.
+*/
+#define _GD_NODO_V(ptr_vt) ((Nodo_V*)((char*)(ptr_vt)-offsetof(Nodo_V, vt)))
+
+/*  !!!MACROS DE USO INTERNO!!!
+    _GD_CLAVE_V(vptr) es el valor que guardan las aristas que terminan en vptr: su direccion o,
+    si se definio GRAFO_D_IDS_32, su identificador. _GD_FIN(grafo, aptr) obtiene el Nodo_V en el
+    que termina la arista aptr y _GD_HASH_FIN(clave) el hash de una clave para la tabla de vecinos.
+*/
+#ifdef GRAFO_D_IDS_32
+#define _GD_CLAVE_V(vptr) ((vptr)->id)
+#define _GD_FIN(grafo, aptr) ((grafo)->nodos_id[(aptr)->fin])
+#else
+#define _GD_CLAVE_V(vptr) (vptr)
+#define _GD_FIN(grafo, aptr) ((aptr)->fin)
+#endif
+#define _GD_HASH_FIN(clave) _gd_hash_ptr((const void*)(uintptr_t)(clave))
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Debe llamarse despues de enlazar la arista aptr al principio de la lista de adyacencia de
+    vptr y de incrementar su grado. Si el vertice ya tiene tabla de vecinos se agrega la arista,
+    si el grado rebasa GRAFO_D_UMBRAL_HASH_ADY se crea la tabla a partir de la lista completa.
+    Las cubetas conservan el orden de la lista de adyacencia. Si no hay memoria el vertice se
+    queda sin tabla y las busquedas recorren su lista.
+*/
+static void _grafo_d_ady_agregar(Nodo_V* vptr, Nodo_A* aptr) {
+    if(vptr->indice_ady!=NULL) {
+        if(!_tabla_h_insertar_inicio(vptr->indice_ady, _GD_HASH_FIN(aptr->fin), aptr)) {
+            _tabla_h_destruir(vptr->indice_ady);
+            vptr->indice_ady=NULL;
+        }
+        return;
+    }
+    if(vptr->grado_s<=GRAFO_D_UMBRAL_HASH_ADY) return;
+    _Tabla_H* tabla=_tabla_h_crear(vptr->grado_s);
+    if(!tabla) return;
+    for(Nodo_A* ptr=vptr->lista_ady; ptr!=NULL; ptr=ptr->sig) {
+        if(!_tabla_h_insertar(tabla, _GD_HASH_FIN(ptr->fin), ptr)) {
+            _tabla_h_destruir(tabla);
+            return;
+        }
+    }
+    vptr->indice_ady=tabla;
+    return;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Debe llamarse despues de desenlazar la arista aptr de la lista de adyacencia de vptr y de
+    decrementar su grado. Quita la arista de la tabla de vecinos y libera la tabla si el grado
+    bajo de la mitad de GRAFO_D_UMBRAL_HASH_ADY.
+*/
+static void _grafo_d_ady_quitar(Nodo_V* vptr, Nodo_A* aptr) {
+    if(vptr->indice_ady==NULL) return;
+    if(vptr->grado_s<GRAFO_D_UMBRAL_HASH_ADY/2) {
+        _tabla_h_destruir(vptr->indice_ady);
+        vptr->indice_ady=NULL;
+        return;
+    }
+    _tabla_h_eliminar(vptr->indice_ady, aptr);
+    return;
+}
+
+/*  Funcion hash FNV-1a de uso general que los usuarios pueden ocupar al implementar las
+    funciones hash de sus vertices/aristas, por ejemplo sobre el nombre de una ciudad.
+*/
+static size_t grafo_d_hash_bytes(const void* datos, size_t n) {
+    const unsigned char* ptr=(const unsigned char*)datos;
+    uint64_t hash=14695981039346656037ULL;
+    for(size_t i=0; i<n; ++i) {
+        hash^=ptr[i];
+        hash*=1099511628211ULL;
+    }
+    return (size_t)(hash^(hash>>32));
+}
+
+/*----------------------------Almacenamiento de las Aristas------------------------------*/
+
+/*  Los nodos de arista de cada vertice no se reservan uno por uno: los primeros
+    GRAFO_D_ADY_LOCAL estan dentro del propio Nodo_V y los siguientes se reservan en lotes
+    contiguos cuya capacidad crece con el grado del vertice. Los nodos libres de un vertice forman
+    una lista que se reutiliza al insertar. La lista de adyacencia sigue enlazando los nodos, que
+    nunca se mueven, por lo que los identificadores de las aristas siguen siendo validos. La
+    memoria de los lotes se libera al eliminar el vertice o destruir el grafo. Las aristas
+    insertadas con grafo_d_insertar_arista_atomica() se reservan por separado.
+*/
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Inicializa el almacenamiento de aristas de un nodo de vertice nuevo
+*/
+static inline void _grafo_d_iniciar_nodo_v(Nodo_V* vptr) {
+    vptr->libres=NULL;
+    vptr->lotes=NULL;
+#if GRAFO_D_ADY_LOCAL>0
+    for(size_t i=GRAFO_D_ADY_LOCAL; i>0; --i) {
+        vptr->ady_local[i-1].sig=vptr->libres;
+        vptr->libres=&(vptr->ady_local[i-1]);
+    }
+#endif
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa un nodo de arista libre del vertice vptr, reservando un lote nuevo si no le quedan.
+    Regresa NULL si no hubo memoria.
+*/
+static Nodo_A* _grafo_d_reservar_arista(Nodo_V* vptr) {
+    if(vptr->libres==NULL) {
+        size_t capacidad=vptr->grado_s>4 ? vptr->grado_s : 4;
+        _Lote_A* lote=(_Lote_A*)GRAFO_D_MALLOC(sizeof(_Lote_A)+sizeof(Nodo_A)*capacidad);
+        if(!lote) return NULL;
+        lote->capacidad=capacidad;
+        lote->en_region=false;
+        lote->sig=vptr->lotes;
+        vptr->lotes=lote;
+        for(size_t i=capacidad; i>0; --i) {
+            lote->nodos[i-1].sig=vptr->libres;
+            vptr->libres=&(lote->nodos[i-1]);
+        }
+    }
+    Nodo_A* nuevo=vptr->libres;
+    vptr->libres=nuevo->sig;
+    return nuevo;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa si el nodo de arista aptr pertenece al almacenamiento local o a un lote de vptr
+*/
+static bool _grafo_d_arista_propia(const Nodo_V* vptr, const Nodo_A* aptr) {
+    uintptr_t dir=(uintptr_t)aptr;
+#if GRAFO_D_ADY_LOCAL>0
+    if(dir>=(uintptr_t)vptr->ady_local && dir<(uintptr_t)(vptr->ady_local+GRAFO_D_ADY_LOCAL)) return true;
+#endif
+    for(const _Lote_A* lote=vptr->lotes; lote!=NULL; lote=lote->sig)
+        if(dir>=(uintptr_t)lote->nodos && dir<(uintptr_t)(lote->nodos+lote->capacidad)) return true;
+    return false;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa el nodo de arista aptr, que ya no esta en la lista de adyacencia de vptr, a sus
+    nodos libres
+*/
+static inline void _grafo_d_liberar_arista(Nodo_V* vptr, Nodo_A* aptr) {
+    if(_grafo_d_arista_propia(vptr, aptr)) {
+        aptr->sig=vptr->libres;
+        vptr->libres=aptr;
+    }
+    else GRAFO_D_FREE(aptr);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Libera todas las aristas de salida del vertice vptr y sus lotes
+*/
+static void _grafo_d_liberar_aristas(Nodo_V* vptr) {
+    Nodo_A* aptr=vptr->lista_ady, *atmp;
+    while(aptr!=NULL) {
+        atmp=aptr;
+        aptr=aptr->sig;
+        if(!_grafo_d_arista_propia(vptr, atmp)) GRAFO_D_FREE(atmp);
+    }
+    _Lote_A* lote=vptr->lotes, *ltmp;
+    while(lote!=NULL) {
+        ltmp=lote;
+        lote=lote->sig;
+        if(!ltmp->en_region) GRAFO_D_FREE(ltmp);
+    }
+    vptr->lista_ady=NULL;
+    _grafo_d_iniciar_nodo_v(vptr);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Libera el nodo de un vertice eliminado, salvo que este en la region de grafo_d_compactar()
+*/
+static inline void _grafo_d_liberar_nodo_v(Grafo_D* grafo, Nodo_V* vptr) {
+    uintptr_t dir=(uintptr_t)vptr;
+    if(dir>=(uintptr_t)grafo->region_v && dir<(uintptr_t)(grafo->region_v+grafo->region_orden)) return;
+    GRAFO_D_FREE(vptr);
+}
+
+#ifdef GRAFO_D_IDS_32
+/*  !!!FUNCION DE USO INTERNO!!!
+    Asigna a vptr un identificador numerico, reutilizando el de un vertice eliminado si lo hay.
+    Regresa falso si no hubo memoria o ya no quedan identificadores.
+*/
+static bool _grafo_d_asignar_id(Grafo_D* grafo, Nodo_V* vptr) {
+    uint32_t id;
+    if(grafo->num_libres>0) id=grafo->ids_libres[--(grafo->num_libres)];
+    else {
+        if(grafo->num_ids>=UINT32_MAX) return false;
+        if(grafo->num_ids==grafo->capacidad_ids) {
+            size_t capacidad=grafo->capacidad_ids ? 2*grafo->capacidad_ids : 16;
+            if(capacidad>UINT32_MAX) capacidad=UINT32_MAX;
+            Nodo_V** nodos=(Nodo_V**)GRAFO_D_REALLOC(grafo->nodos_id, sizeof(Nodo_V*)*capacidad);
+            if(!nodos) return false;
+            grafo->nodos_id=nodos;
+            uint32_t* libres=(uint32_t*)GRAFO_D_REALLOC(grafo->ids_libres, sizeof(uint32_t)*capacidad);
+            if(!libres) return false;
+            grafo->ids_libres=libres;
+            grafo->capacidad_ids=capacidad;
+        }
+        id=(uint32_t)(grafo->num_ids++);
+    }
+    grafo->nodos_id[id]=vptr;
+    vptr->id=id;
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Libera el identificador de un vertice eliminado para que lo ocupe el siguiente que se inserte
+*/
+static inline void _grafo_d_liberar_id(Grafo_D* grafo, uint32_t id) {
+    grafo->nodos_id[id]=NULL;
+    grafo->ids_libres[(grafo->num_libres)++]=id;
+}
+#endif
+
 /*---------------------------Operaciones basicas del grafo------------------------------*/
 
+static void grafo_d_version_liberar(const struct grafo_d_version* version);
+
+//  Tipos de registro del diario de operaciones, ver la seccion Diario de Operaciones
+#define _GD_DIARIO_INS_V 1
+#define _GD_DIARIO_ELI_V 2
+#define _GD_DIARIO_INS_A 3
+#define _GD_DIARIO_INS_PAR 4
+#define _GD_DIARIO_ELI_A 5
+
+static void _grafo_d_diario_registrar(Grafo_D* grafo, unsigned char tipo, const Nodo_V* ini,
+    const Nodo_V* fin, size_t pos, const void* dato);
+static size_t _grafo_d_diario_id(const Grafo_D* grafo, const Nodo_V* nodo);
+static bool _grafo_d_diario_checkpoint(Grafo_D* grafo);
+static bool _grafo_d_diario_cerrar(Grafo_D* grafo);
+
 /*  Crear un grafo vacio para empezar a realizar operaciones. Algunas funciones requieren
     que el grafo tenga asociado un comportamineto en particular, mediante las funciones
     grafo_d_set_cmp_vt(), grafo_d_set_cmp_ar() y grafo_d_set_calc_peso() 
 */
 static Grafo_D* grafo_d_crear(void) {
-    Grafo_D* grafo = (Grafo_D*)malloc(sizeof(Grafo_D));
+    Grafo_D* grafo = (Grafo_D*)GRAFO_D_MALLOC(sizeof(Grafo_D));
     if(!grafo) return NULL;
     grafo->lista_ady=NULL;
     grafo->lista_fin=NULL;
@@ -171,6 +1292,40 @@ static Grafo_D* grafo_d_crear(void) {
     grafo->cmp_vt=cmp_vt_default;
     grafo->cmp_ar=cmp_ar_default;
     grafo->calc_peso=calc_peso_default;
+    grafo->hash_vt=NULL;
+    grafo->hash_ar=NULL;
+    grafo->indice_vt=NULL;
+    grafo->indice_ar=NULL;
+    grafo->version=NULL;
+    grafo->diario=NULL;
+    grafo->region_v=NULL;
+    grafo->region_orden=0;
+    grafo->region_a=NULL;
+    grafo->region_bytes_a=0;
+#ifdef GRAFO_D_IDS_32
+    grafo->nodos_id=NULL;
+    grafo->ids_libres=NULL;
+    grafo->num_ids=grafo->num_libres=grafo->capacidad_ids=0;
+#endif
+#ifdef GRAFO_D_CONCURRENTE
+    //Se da preferencia a los escritores para que un flujo constante de consultas no los bloquee
+    pthread_rwlockattr_t atributos;
+    pthread_rwlockattr_init(&atributos);
+#ifndef _GD_TORNIQUETE
+    pthread_rwlockattr_setkind_np(&atributos, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#else
+    if(pthread_mutex_init(&(grafo->torniquete), NULL)!=0) {GRAFO_D_FREE(grafo); return NULL;}
+#endif
+    int error=pthread_rwlock_init(&(grafo->bloqueo), &atributos);
+    pthread_rwlockattr_destroy(&atributos);
+    if(error!=0) {
+#ifdef _GD_TORNIQUETE
+        pthread_mutex_destroy(&(grafo->torniquete));
+#endif
+        GRAFO_D_FREE(grafo);
+        return NULL;
+    }
+#endif
     return grafo;
 }
 
@@ -211,48 +1366,186 @@ static inline void grafo_d_set_calc_peso(Grafo_D* grafo,
 static inline void grafo_d_unset_calc_peso(Grafo_D* grafo) {
     grafo->calc_peso=calc_peso_default;}
 
-/*  Regresa si el grafo se encuentra vacio*/
-static inline bool grafo_d_isempty(const Grafo_D* grafo) {
-    return grafo->lista_ady==NULL
-        && grafo->lista_fin==NULL 
-        && grafo->orden==0;
-}
-
-/*  Libera la memoria reservada dinamicamente para el grafo, el puntero a el grafo
-    pasado a la funcion queda invalidado despues de esta operacion
+/*  Asigna una funcion size_t hash_vt(Vertice*) implementada por el usuario y crea un indice hash
+    sobre los datos de los vertices del grafo. Mientras el indice exista las funciones
+    grafo_d_buscar_vertice() y grafo_d_buscar_vertices() se resuelven en tiempo O(1) promedio en
+    lugar de recorrer todos los vertices; grafo->cmp_vt() sigue siendo el criterio de igualdad,
+    por lo que hash_vt() debe regresar el mismo valor para vertices que cmp_vt() considere iguales.
+    El indice se mantiene actualizado al insertar/eliminar vertices, los campos que usa hash_vt()
+    no deben modificarse mientras el vertice pertenezca al grafo. Regresa false si no hubo memoria
+    para construir el indice, en cuyo caso el grafo queda sin indice.
 */
-static void grafo_d_destruir(Grafo_D* grafo) {
-    Nodo_V* vptr = grafo->lista_ady, *vtmp;
+static bool grafo_d_set_hash_vt(Grafo_D* grafo, size_t (*hash_vt)(Vertice*)) {
+    if(grafo->indice_vt) _tabla_h_destruir(grafo->indice_vt);
+    grafo->hash_vt=NULL;
+    grafo->indice_vt=_tabla_h_crear(grafo->orden);
+    if(!grafo->indice_vt) return false;
+    Nodo_V* vptr=grafo->lista_ady;
     while(vptr!=NULL) {
-        Nodo_A *aptr = vptr->lista_ady, *atmp;
-        while(aptr!=NULL) {
-            atmp=aptr;
-            aptr=aptr->sig;
-            free(atmp);
+        if(!_tabla_h_insertar(grafo->indice_vt, hash_vt(&(vptr->vt)), vptr)) {
+            _tabla_h_destruir(grafo->indice_vt);
+            grafo->indice_vt=NULL;
+            return false;
         }
-        vtmp=vptr;
         vptr=vptr->sig;
-        free(vtmp);
     }
-    free(grafo);
-    return;
+    grafo->hash_vt=hash_vt;
+    return true;
 }
 
-/*----------------------------Operaciones sobre los vertices-----------------------------*/
+/*  Elimina el indice hash de vertices, las busquedas vuelven a recorrer la lista de vertices*/
+static inline void grafo_d_unset_hash_vt(Grafo_D* grafo) {
+    if(grafo->indice_vt) _tabla_h_destruir(grafo->indice_vt);
+    grafo->indice_vt=NULL;
+    grafo->hash_vt=NULL;
+}
 
-/*  Inserta un vertice con los datos que contenga el agumento vt, devuelve la direccion
-    de memoria que identifica al vertice como elemento unico del grafo, las demas operaciones
-    que esperan un argumento vertice toman este valor de retorno para identificar el vertice
+/*  Asigna una funcion size_t hash_ar(Arista*) implementada por el usuario y crea un indice hash
+    sobre los datos de las aristas del grafo. Mientras el indice exista las funciones
+    grafo_d_buscar_arista() y grafo_d_buscar_aristas() solo visitan las aristas cuyo hash coincide
+    con el de la referencia, en lugar de recorrer todas las listas de adyacencia; grafo->cmp_ar()
+    sigue siendo el criterio de igualdad, por lo que hash_ar() debe regresar el mismo valor para
+    aristas que cmp_ar() considere iguales. Con el indice activo las aristas iguales se regresan en
+    el orden en el que se agregaron al indice: al crearlo se agregan en el orden del grafo (vertice
+    por vertice) y despues en el orden en el que se insertan. Reconstruir el indice, con esta
+    funcion, grafo_d_compactar() o grafo_d_fin_carga_atomica(), conserva ese orden y agrega al
+    final las aristas que no estaban indexadas. El indice se mantiene actualizado al
+    insertar/eliminar aristas y vertices, los campos que usa hash_ar() no deben modificarse
+    mientras la arista pertenezca al grafo. Regresa false si no hubo memoria para construir el
+    indice, en cuyo caso el grafo queda sin indice.
 */
-static Vertice* grafo_d_insertar_vertice(Grafo_D* grafo, Vertice vt) {
-    Nodo_V* nuevo = (Nodo_V*)malloc(sizeof(Nodo_V));
-    if(!nuevo) return NULL;
-    nuevo->lista_ady=NULL;
-    nuevo->sig=NULL;
-    nuevo->vt=vt;
-    nuevo->grado_s=0;
-    //Vertices se insetan por el final en tiempo constante
-    if(grafo->lista_fin==NULL) {
+static bool grafo_d_set_hash_ar(Grafo_D* grafo, size_t (*hash_ar)(Arista*)) {
+    _Tabla_H* anterior=grafo->indice_ar;
+    grafo->hash_ar=NULL;
+    grafo->indice_ar=_tabla_h_crear(grafo->tamano);
+    bool ok=(grafo->indice_ar!=NULL);
+    //Las aristas del indice anterior conservan su orden relativo, cada cubeta se recorre en orden
+    for(size_t i=0; anterior!=NULL && ok && i<anterior->capacidad; ++i)
+        for(_Nodo_H* hptr=anterior->cubetas[i]; ok && hptr!=NULL; hptr=hptr->sig)
+            ok=_tabla_h_insertar(grafo->indice_ar, hash_ar(&(((Nodo_A*)hptr->elem)->ar)), hptr->elem);
+    for(Nodo_V* vptr=grafo->lista_ady; ok && vptr!=NULL; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; ok && aptr!=NULL; aptr=aptr->sig)
+            if(anterior==NULL || _tabla_h_nodo(anterior, aptr)==NULL)
+                ok=_tabla_h_insertar(grafo->indice_ar, hash_ar(&(aptr->ar)), aptr);
+    if(anterior) _tabla_h_destruir(anterior);
+    if(!ok) {
+        if(grafo->indice_ar) _tabla_h_destruir(grafo->indice_ar);
+        grafo->indice_ar=NULL;
+        return false;
+    }
+    grafo->hash_ar=hash_ar;
+    return true;
+}
+
+/*  Elimina el indice hash de aristas, las busquedas vuelven a recorrer todo el grafo*/
+static inline void grafo_d_unset_hash_ar(Grafo_D* grafo) {
+    if(grafo->indice_ar) _tabla_h_destruir(grafo->indice_ar);
+    grafo->indice_ar=NULL;
+    grafo->hash_ar=NULL;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Agrega las aristas a1 y a2 (a2 puede ser NULL) al indice hash de aristas si este existe.
+    Si no hay memoria el indice queda sin cambios y la funcion regresa false.
+*/
+static bool _grafo_d_indexar_aristas(Grafo_D* grafo, Nodo_A* a1, Nodo_A* a2) {
+    if(!grafo->indice_ar) return true;
+    if(!_tabla_h_insertar(grafo->indice_ar, grafo->hash_ar(&(a1->ar)), a1))
+        return false;
+    if(a2!=NULL && !_tabla_h_insertar(grafo->indice_ar, grafo->hash_ar(&(a2->ar)), a2)) {
+        _tabla_h_eliminar(grafo->indice_ar, a1);
+        return false;
+    }
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Quita la arista del indice hash de aristas si este existe
+*/
+static inline void _grafo_d_desindexar_arista(Grafo_D* grafo, Nodo_A* aptr) {
+    if(grafo->indice_ar)
+        _tabla_h_eliminar(grafo->indice_ar, aptr);
+}
+
+/*  Indica que los datos del vertice vt o de alguna de sus aristas de salida fueron modificados
+    directamente a traves de su identificador. Solo es necesario si se usan versiones del grafo
+    (ver grafo_d_snapshot()), para que la siguiente version no reutilice los datos anteriores.
+*/
+static inline void grafo_d_marcar_modificado(Grafo_D* grafo, const Vertice* vt) {
+    (void)grafo;
+    _GD_NODO_V(vt)->bloque=NULL;
+}
+
+/*  Regresa si el grafo se encuentra vacio*/
+static inline bool grafo_d_isempty(const Grafo_D* grafo) {
+    return grafo->lista_ady==NULL
+        && grafo->lista_fin==NULL 
+        && grafo->orden==0;
+}
+
+/*  Libera la memoria reservada dinamicamente para el grafo, el puntero a el grafo
+    pasado a la funcion queda invalidado despues de esta operacion
+*/
+static void grafo_d_destruir(Grafo_D* grafo) {
+    if(grafo->diario) _grafo_d_diario_cerrar(grafo);
+    Nodo_V* vptr = grafo->lista_ady, *vtmp;
+    while(vptr!=NULL) {
+        _grafo_d_liberar_aristas(vptr);
+        vtmp=vptr;
+        vptr=vptr->sig;
+        if(vtmp->indice_ady) _tabla_h_destruir(vtmp->indice_ady);
+        _grafo_d_liberar_nodo_v(grafo, vtmp);
+    }
+    GRAFO_D_FREE(grafo->region_v);
+    GRAFO_D_FREE(grafo->region_a);
+    if(grafo->indice_vt) _tabla_h_destruir(grafo->indice_vt);
+    if(grafo->indice_ar) _tabla_h_destruir(grafo->indice_ar);
+    if(grafo->version) grafo_d_version_liberar(grafo->version);
+#ifdef GRAFO_D_IDS_32
+    GRAFO_D_FREE(grafo->nodos_id);
+    GRAFO_D_FREE(grafo->ids_libres);
+#endif
+#ifdef GRAFO_D_CONCURRENTE
+    pthread_rwlock_destroy(&(grafo->bloqueo));
+#endif
+#ifdef _GD_TORNIQUETE
+    pthread_mutex_destroy(&(grafo->torniquete));
+#endif
+    GRAFO_D_FREE(grafo);
+    return;
+}
+
+/*----------------------------Operaciones sobre los vertices-----------------------------*/
+
+/*  Inserta un vertice con los datos que contenga el agumento vt, devuelve la direccion
+    de memoria que identifica al vertice como elemento unico del grafo, las demas operaciones
+    que esperan un argumento vertice toman este valor de retorno para identificar el vertice
+*/
+static Vertice* grafo_d_insertar_vertice(Grafo_D* grafo, Vertice vt) {
+    Nodo_V* nuevo = (Nodo_V*)GRAFO_D_MALLOC(sizeof(Nodo_V));
+    if(!nuevo) return NULL;
+    nuevo->lista_ady=NULL;
+    nuevo->indice_ady=NULL;
+    nuevo->bloque=NULL;
+    nuevo->sig=NULL;
+    nuevo->vt=vt;
+    nuevo->grado_s=0;
+    _grafo_d_iniciar_nodo_v(nuevo);
+#ifdef GRAFO_D_IDS_32
+    if(!_grafo_d_asignar_id(grafo, nuevo)) {
+        GRAFO_D_FREE(nuevo);
+        return NULL;
+    }
+#endif
+    if(grafo->indice_vt && !_tabla_h_insertar(grafo->indice_vt, grafo->hash_vt(&vt), nuevo)) {
+#ifdef GRAFO_D_IDS_32
+        _grafo_d_liberar_id(grafo, nuevo->id);
+#endif
+        GRAFO_D_FREE(nuevo);
+        return NULL;
+    }
+    //Vertices se insetan por el final en tiempo constante
+    if(grafo->lista_fin==NULL) {
         grafo->lista_ady=nuevo;
         grafo->lista_fin=nuevo;
     }
@@ -261,6 +1554,7 @@ static Vertice* grafo_d_insertar_vertice(Grafo_D* grafo, Vertice vt) {
         grafo->lista_fin=nuevo;
     }
     ++(grafo->orden);
+    if(grafo->diario) _grafo_d_diario_registrar(grafo, _GD_DIARIO_INS_V, nuevo, NULL, 0, &vt);
     return &(nuevo->vt);
 }
 
@@ -269,9 +1563,20 @@ static Vertice* grafo_d_insertar_vertice(Grafo_D* grafo, Vertice vt) {
 */
 static Vertice* grafo_d_buscar_vertice(const Grafo_D* grafo, Vertice ref) {
     assert(grafo->cmp_vt!=NULL);
+    if(grafo->indice_vt) {
+        size_t hash=grafo->hash_vt(&ref);
+        _Nodo_H* hptr=_tabla_h_cubeta(grafo->indice_vt, hash);
+        while(hptr!=NULL) {
+            Nodo_V* nodo=(Nodo_V*)hptr->elem;
+            if(hptr->hash==hash && _GD_CMP_VT(grafo->cmp_vt, &(nodo->vt),&ref))
+                return &(nodo->vt);
+            hptr=hptr->sig;
+        }
+        return NULL;
+    }
     Nodo_V* vptr = grafo->lista_ady;
     while(vptr!=NULL) {
-        if(grafo->cmp_vt(&(vptr->vt),&ref))
+        if(_GD_CMP_VT(grafo->cmp_vt, &(vptr->vt),&ref))
             return &(vptr->vt);
         vptr=vptr->sig;
     }
@@ -280,26 +1585,44 @@ static Vertice* grafo_d_buscar_vertice(const Grafo_D* grafo, Vertice ref) {
 
 /*  Regresa un vector almacenado dinamicamente que contine los vertices que hacen que
     funcion grafo->cmp_vt() regrese verdadero. El vector esta reservado con memoria dinamica
-    por lo que necesita ser liberado con una llamada a free()
+    por lo que necesita ser liberado con una llamada a GRAFO_D_FREE()
 */
 static const Vect_V* grafo_d_buscar_vertices(const Grafo_D* grafo, Vertice ref) {
     assert(grafo->cmp_vt!=NULL);
-    Vect_V* vectmp = (Vect_V*)malloc(sizeof(Vect_V)+sizeof(Vertice*)*(grafo->orden));
+    if(grafo->indice_vt) {
+        size_t hash=grafo->hash_vt(&ref), total=0;
+        _Nodo_H* hptr=_tabla_h_cubeta(grafo->indice_vt, hash);
+        for(; hptr!=NULL; hptr=hptr->sig)
+            if(hptr->hash==hash && _GD_CMP_VT(grafo->cmp_vt, &(((Nodo_V*)hptr->elem)->vt),&ref)) ++total;
+        Vect_V* vector = (Vect_V*)GRAFO_D_MALLOC(sizeof(Vect_V)+sizeof(Vertice*)*total);
+        if(!vector) return NULL;
+        vector->tamano=0;
+        hptr=_tabla_h_cubeta(grafo->indice_vt, hash);
+        for(; hptr!=NULL; hptr=hptr->sig) {
+            Nodo_V* nodo=(Nodo_V*)hptr->elem;
+            if(hptr->hash==hash && _GD_CMP_VT(grafo->cmp_vt, &(nodo->vt),&ref)) {
+                vector->vertices[vector->tamano]=&(nodo->vt);
+                ++(vector->tamano);
+            }
+        }
+        return (const Vect_V*)vector;
+    }
+    Vect_V* vectmp = (Vect_V*)GRAFO_D_MALLOC(sizeof(Vect_V)+sizeof(Vertice*)*(grafo->orden));
     if(!vectmp) return NULL;
     vectmp->tamano=0;
     Nodo_V* vptr=grafo->lista_ady;
     while(vptr!=NULL) {
-        if(grafo->cmp_vt(&(vptr->vt), &ref)) {
+        if(_GD_CMP_VT(grafo->cmp_vt, &(vptr->vt), &ref)) {
             vectmp->vertices[vectmp->tamano]=&(vptr->vt);
             ++(vectmp->tamano);
         }
         vptr=vptr->sig;
     }
-    Vect_V* vector = (Vect_V*)malloc(sizeof(Vect_V)+sizeof(Vertice*)*(vectmp->tamano));
-    if(!vector) {free(vectmp); return NULL;}
+    Vect_V* vector = (Vect_V*)GRAFO_D_MALLOC(sizeof(Vect_V)+sizeof(Vertice*)*(vectmp->tamano));
+    if(!vector) {GRAFO_D_FREE(vectmp); return NULL;}
     for(int i=0; i<vectmp->tamano; ++i) vector->vertices[i]=vectmp->vertices[i];
     vector->tamano=vectmp->tamano;
-    free(vectmp);
+    GRAFO_D_FREE(vectmp);
     return (const Vect_V*)vector;
 }
 
@@ -311,17 +1634,20 @@ static const Vect_V* grafo_d_buscar_vertices(const Grafo_D* grafo, Vertice ref)
 */
 static void grafo_d_eliminar_vertice(Grafo_D* grafo, Vertice* vt) {
     Nodo_V* vptr = grafo->lista_ady, *vprev=NULL, *vtmp;
+    size_t id=grafo->diario ? _grafo_d_diario_id(grafo, _GD_NODO_V(vt)) : 0;
+#ifdef GRAFO_D_IDS_32
+    uint32_t clave=_GD_NODO_V(vt)->id;
+#else
+    Nodo_V* clave=_GD_NODO_V(vt);
+#endif
     //Recorremos todos los vertices
     while(vptr!=NULL) {
         Nodo_A* aptr = vptr->lista_ady, *aprev=NULL, *atmp;
         //Si el nodo actual contiene el vertice a eliminar
         if(vt==&(vptr->vt)) {
             //Borramos todas las aristas que salen del vertice
-            while(aptr!=NULL) {
-                atmp=aptr;
-                aptr=aptr->sig;
-                free(atmp);
-            }
+            for(; aptr!=NULL; aptr=aptr->sig) _grafo_d_desindexar_arista(grafo, aptr);
+            _grafo_d_liberar_aristas(vptr);
             //Actualizamos el numero de aristas del grafo
             grafo->tamano-=vptr->grado_s;
             //Movemos solamente el puntero de vertice actual
@@ -334,8 +1660,11 @@ static void grafo_d_eliminar_vertice(Grafo_D* grafo, Vertice* vt) {
             //Conectamos la lista saltando el vertice eliminado
             if(vprev!=NULL) vprev->sig=vptr; 
             else grafo->lista_ady=vptr;
-            //Eliminamos el vertice y actualizamos orden
-            free(vtmp);
+            //Eliminamos el vertice del indice hash, el vertice y actualizamos orden
+            if(grafo->indice_vt)
+                _tabla_h_eliminar(grafo->indice_vt, vtmp);
+            if(vtmp->indice_ady) _tabla_h_destruir(vtmp->indice_ady);
+            _grafo_d_liberar_nodo_v(grafo, vtmp);
             --(grafo->orden);
         }
         //Si es cualquier otro vertice
@@ -343,17 +1672,20 @@ static void grafo_d_eliminar_vertice(Grafo_D* grafo, Vertice* vt) {
             //Recorremos todas sus aristas
             while(aptr!=NULL) {
                 //Si la arista termina en el vertice a eliminar
-                if(vt==&(aptr->fin->vt)) {
+                if(aptr->fin==clave) {
                     //Movemos solamente el puntero de arista actual
                     atmp=aptr;
                     aptr=aptr->sig;
                     //Conectamos la lista saltando el vertice eliminado
                     if(aprev!=NULL) aprev->sig=aptr;
                     else vptr->lista_ady=aptr;
-                    //Eliminamos la arista y actualizamos grado, tamano
-                    free(atmp);
+                    //Actualizamos grado, tamano, indices y eliminamos la arista
                     --(vptr->grado_s);
                     --(grafo->tamano);
+                    _grafo_d_ady_quitar(vptr, atmp);
+                    vptr->bloque=NULL;
+                    _grafo_d_desindexar_arista(grafo, atmp);
+                    _grafo_d_liberar_arista(vptr, atmp);
                 }
                 else {
                     //Si fue una arista regular avanzamos aptr y aprev
@@ -366,67 +1698,102 @@ static void grafo_d_eliminar_vertice(Grafo_D* grafo, Vertice* vt) {
             vptr=vptr->sig;
         }
     }
+#ifdef GRAFO_D_IDS_32
+    _grafo_d_liberar_id(grafo, clave);
+#endif
+    if(grafo->diario) _grafo_d_diario_registrar(grafo, _GD_DIARIO_ELI_V, NULL, NULL, id, NULL);
     return;
 }
 
 /*----------------------------Operaciones sobre las aristas------------------------------*/
 
+/*  !!!FUNCION DE USO INTERNO!!!
+    Enlaza la arista nuevo (con su vertice fin ya asignado) al principio de la lista de
+    adyacencia del vertice inicio y actualiza su grado y su tabla de vecinos. Solo modifica
+    inicio, el tamano del grafo debe actualizarse aparte.
+*/
+static inline void _grafo_d_enlazar_en_vertice(Nodo_V* inicio, Nodo_A* nuevo) {
+    nuevo->sig=inicio->lista_ady;
+    inicio->lista_ady=nuevo;
+    ++(inicio->grado_s);
+    _grafo_d_ady_agregar(inicio, nuevo);
+    inicio->bloque=NULL;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Enlaza la arista nuevo (con su vertice fin ya asignado) al principio de la lista de
+    adyacencia del vertice inicio y actualiza el grado, el tamano y la tabla de vecinos
+*/
+static inline void _grafo_d_enlazar_arista(Grafo_D* grafo, Nodo_V* inicio, Nodo_A* nuevo) {
+    _grafo_d_enlazar_en_vertice(inicio, nuevo);
+    ++(grafo->tamano);
+}
+
 /*  Inserta una arista entre el vertice ini y el vertice fin que va de ini a fin. Los datos de la
     arista seran los suministrados mediante el argumento ar. La funcion devuelve la direccion de memoria
     (identificador) de la arista como elemento unico del grafo.
 */
 static Arista* grafo_d_insertar_arista(Grafo_D* grafo, Arista ar, const Vertice* ini, const Vertice* fin) {
-    Nodo_A* nuevo = (Nodo_A*)malloc(sizeof(Nodo_A));
-    if(!nuevo) return NULL;
-    nuevo->ar=ar; nuevo->fin=NULL;
-    Nodo_V* vptr=grafo->lista_ady, *inicio=NULL;
+    Nodo_V* vptr=grafo->lista_ady, *inicio=NULL, *final=NULL;
     //Encontramos los nodos correspondientes a ini y a fin
-    while(nuevo->fin==NULL || inicio==NULL) {
+    while(final==NULL || inicio==NULL) {
         if(ini==&(vptr->vt)) inicio=vptr;
-        if(fin==&(vptr->vt)) nuevo->fin=vptr;
+        if(fin==&(vptr->vt)) final=vptr;
         vptr=vptr->sig;
     }
+    Nodo_A* nuevo=_grafo_d_reservar_arista(inicio);
+    if(!nuevo) return NULL;
+    nuevo->ar=ar; nuevo->fin=_GD_CLAVE_V(final);
+    if(!_grafo_d_indexar_aristas(grafo, nuevo, NULL)) {_grafo_d_liberar_arista(inicio, nuevo); return NULL;}
     //La arista se inserta por el principio
-    nuevo->sig=inicio->lista_ady;
-    inicio->lista_ady=nuevo;
-    ++(inicio->grado_s);
-    ++(grafo->tamano);
+    _grafo_d_enlazar_arista(grafo, inicio, nuevo);
+    if(grafo->diario) _grafo_d_diario_registrar(grafo, _GD_DIARIO_INS_A, inicio, final, 0, &ar);
     return &(nuevo->ar);
 }
 
+/*  !!!FUNCION DE USO INTERNO!!!
+    Inserta el par de aristas conjugadas de grafo_d_insertar_arista_par() y grafo_d_insertar_arpar()
+    y escribe sus nodos en ini_fin y fin_ini. Regresa falso si no hubo memoria.
+*/
+static bool _grafo_d_insertar_par(Grafo_D* grafo, Arista ar, const Vertice* ini, const Vertice* fin,
+    Nodo_A** ini_fin, Nodo_A** fin_ini) {
+    Nodo_V* vptr=grafo->lista_ady, *inicio=NULL, *final=NULL;
+    //Encontramos los nodos correspondientes a ini y a fin
+    while(final==NULL || inicio==NULL) {
+        if(ini==&(vptr->vt)) inicio=vptr;
+        if(fin==&(vptr->vt)) final=vptr;
+        vptr=vptr->sig;
+    }
+    *ini_fin=_grafo_d_reservar_arista(inicio);
+    if(!*ini_fin) return false;
+    *fin_ini=_grafo_d_reservar_arista(final);
+    if(!*fin_ini) {_grafo_d_liberar_arista(inicio, *ini_fin); return false;}
+    (*ini_fin)->ar=(*fin_ini)->ar=ar;
+    (*ini_fin)->fin=_GD_CLAVE_V(final);
+    (*fin_ini)->fin=_GD_CLAVE_V(inicio);
+    if(!_grafo_d_indexar_aristas(grafo, *ini_fin, *fin_ini)) {
+        _grafo_d_liberar_arista(inicio, *ini_fin);
+        _grafo_d_liberar_arista(final, *fin_ini);
+        return false;
+    }
+    //Las aristas se insertan por el principio
+    _grafo_d_enlazar_arista(grafo, inicio, *ini_fin);
+    _grafo_d_enlazar_arista(grafo, final, *fin_ini);
+    if(grafo->diario) _grafo_d_diario_registrar(grafo, _GD_DIARIO_INS_PAR, inicio, final, 0, &ar);
+    return true;
+}
+
 /*  Inseta un par de aristas conjugadas (una arista de ini a fin y otra de fin a ini) entre dos vertices.
     Los datos para ambas aristas estan dados por el paramentro ar. La funcion devuelve un vector alamacenado
     dinamicamente de tamano 2 que contine ambas aristas. Debido a que el vector que regresa la funcion es
-    dinamicamente alojado en memoria debe ser liberado con una llamada free()
+    dinamicamente alojado en memoria debe ser liberado con una llamada GRAFO_D_FREE()
 */
 static Vect_A* grafo_d_insertar_arista_par(Grafo_D* grafo, Arista ar, const Vertice* ini, const Vertice* fin) {
-    Nodo_A* ini_fin = (Nodo_A*)malloc(sizeof(Nodo_A));
-    if(!ini_fin) return NULL;
-    Nodo_A* fin_ini = (Nodo_A*)malloc(sizeof(Nodo_A));
-    if(!fin_ini) {free(ini_fin); return NULL;}
-    Vect_A* vect = (Vect_A*)malloc(sizeof(Vect_A)+sizeof(Arista*)*2);
-    if(!vect) {free(ini_fin); free(fin_ini); return NULL;}
+    Vect_A* vect = (Vect_A*)GRAFO_D_MALLOC(sizeof(Vect_A)+sizeof(Arista*)*2);
+    if(!vect) return NULL;
     vect->tamano=2;
-    ini_fin->ar=fin_ini->ar=ar;
-    ini_fin->fin=fin_ini->fin=NULL;
-    Nodo_V* vptr=grafo->lista_ady;
-    while(ini_fin->fin==NULL || fin_ini->fin==NULL) {
-        if(ini==&(vptr->vt)) {
-            fin_ini->fin=vptr;
-            ini_fin->sig=vptr->lista_ady;
-            vptr->lista_ady=ini_fin;
-            ++(vptr->grado_s);
-        }
-        if(fin==&(vptr->vt)) {
-            ini_fin->fin=vptr;
-            fin_ini->sig=vptr->lista_ady;
-            vptr->lista_ady=fin_ini;
-            ++(vptr->grado_s);
-        }
-        vptr=vptr->sig;
-    }
-
-    grafo->tamano+=2;
+    Nodo_A *ini_fin, *fin_ini;
+    if(!_grafo_d_insertar_par(grafo, ar, ini, fin, &ini_fin, &fin_ini)) {GRAFO_D_FREE(vect); return NULL;}
     vect->aristas[0]=&(ini_fin->ar);
     vect->aristas[1]=&(fin_ini->ar);
     return vect;
@@ -436,30 +1803,8 @@ static Vect_A* grafo_d_insertar_arista_par(Grafo_D* grafo, Arista ar, const Vert
     la informacion suministrada al paramentro ar. La funcion regresa si la insersion se realizo o no.
 */
 static bool grafo_d_insertar_arpar(Grafo_D* grafo, Arista ar, const Vertice* ini, const Vertice* fin) {
-    Nodo_A* ini_fin = (Nodo_A*)malloc(sizeof(Nodo_A));
-    if(!ini_fin) return false;
-    Nodo_A* fin_ini = (Nodo_A*)malloc(sizeof(Nodo_A));
-    if(!fin_ini) {free(ini_fin); return false;}
-    ini_fin->ar=fin_ini->ar=ar;
-    ini_fin->fin=fin_ini->fin=NULL;
-    Nodo_V* vptr=grafo->lista_ady;
-    while(ini_fin->fin==NULL || fin_ini->fin==NULL) {
-        if(ini==&(vptr->vt)) {
-            fin_ini->fin=vptr;
-            ini_fin->sig=vptr->lista_ady;
-            vptr->lista_ady=ini_fin;
-            ++(vptr->grado_s);
-        }
-        if(fin==&(vptr->vt)) {
-            ini_fin->fin=vptr;
-            fin_ini->sig=vptr->lista_ady;
-            vptr->lista_ady=fin_ini;
-            ++(vptr->grado_s);
-        }
-        vptr=vptr->sig;
-    }
-    grafo->tamano+=2;
-    return true;
+    Nodo_A *ini_fin, *fin_ini;
+    return _grafo_d_insertar_par(grafo, ar, ini, fin, &ini_fin, &fin_ini);
 }
 
 /*  Regresa la direccion de memoria(identificador) del la primer arista que haga que la
@@ -467,11 +1812,22 @@ static bool grafo_d_insertar_arpar(Grafo_D* grafo, Arista ar, const Vertice* ini
 */
 static Arista* grafo_d_buscar_arista(const Grafo_D* grafo, Arista ref) {
     assert(grafo->cmp_ar!=NULL);
+    if(grafo->indice_ar) {
+        size_t hash=grafo->hash_ar(&ref);
+        _Nodo_H* hptr=_tabla_h_cubeta(grafo->indice_ar, hash);
+        while(hptr!=NULL) {
+            Nodo_A* nodo=(Nodo_A*)hptr->elem;
+            if(hptr->hash==hash && _GD_CMP_AR(grafo->cmp_ar, &(nodo->ar),&ref))
+                return &(nodo->ar);
+            hptr=hptr->sig;
+        }
+        return NULL;
+    }
     Nodo_V* vptr = grafo->lista_ady;
     while(vptr!=NULL) {
         Nodo_A* aptr = vptr->lista_ady;
         while(aptr!=NULL) {
-            if(grafo->cmp_ar(&(aptr->ar),&ref)) {
+            if(_GD_CMP_AR(grafo->cmp_ar, &(aptr->ar),&ref)) {
                 return &(aptr->ar);
             }
             aptr=aptr->sig;
@@ -483,18 +1839,38 @@ static Arista* grafo_d_buscar_arista(const Grafo_D* grafo, Arista ref) {
 
 /*  Regresa un vector almacenado dinamicamente con las direcciones de memoria de todas
     las aristas en el grafo que hagan que la funcion grafo->cmp_ar() regrese verdader.
-    El vector debera ser liberado mediante una llamada a la funcion free()
+    Si el grafo tiene indice hash de aristas se regresan en el orden descrito en
+    grafo_d_set_hash_ar(), de lo contrario en el orden del grafo, vertice por vertice.
+    El vector debera ser liberado mediante una llamada a la funcion GRAFO_D_FREE()
 */
 static const Vect_A* grafo_d_buscar_aristas(const Grafo_D* grafo, Arista ref) {
     assert(grafo->cmp_ar!=NULL);
-    Vect_A* vectmp = (Vect_A*)malloc(sizeof(Vect_A)+sizeof(Arista*)*(grafo->tamano));
+    if(grafo->indice_ar) {
+        size_t hash=grafo->hash_ar(&ref), total=0;
+        _Nodo_H* hptr=_tabla_h_cubeta(grafo->indice_ar, hash);
+        for(; hptr!=NULL; hptr=hptr->sig)
+            if(hptr->hash==hash && _GD_CMP_AR(grafo->cmp_ar, &(((Nodo_A*)hptr->elem)->ar),&ref)) ++total;
+        Vect_A* vector = (Vect_A*)GRAFO_D_MALLOC(sizeof(Vect_A)+sizeof(Arista*)*total);
+        if(!vector) return NULL;
+        vector->tamano=0;
+        hptr=_tabla_h_cubeta(grafo->indice_ar, hash);
+        for(; hptr!=NULL; hptr=hptr->sig) {
+            Nodo_A* nodo=(Nodo_A*)hptr->elem;
+            if(hptr->hash==hash && _GD_CMP_AR(grafo->cmp_ar, &(nodo->ar),&ref)) {
+                vector->aristas[vector->tamano]=&(nodo->ar);
+                ++(vector->tamano);
+            }
+        }
+        return (const Vect_A*)vector;
+    }
+    Vect_A* vectmp = (Vect_A*)GRAFO_D_MALLOC(sizeof(Vect_A)+sizeof(Arista*)*(grafo->tamano));
     if(!vectmp) return NULL;
     vectmp->tamano=0;
     Nodo_V* vptr = grafo->lista_ady;
     while(vptr!=NULL) {
         Nodo_A* aptr = vptr->lista_ady;
         while(aptr!=NULL) {
-            if(grafo->cmp_ar(&(aptr->ar), &ref)) {
+            if(_GD_CMP_AR(grafo->cmp_ar, &(aptr->ar), &ref)) {
                 vectmp->aristas[vectmp->tamano]=&(aptr->ar);
                 ++(vectmp->tamano); 
             }
@@ -502,50 +1878,87 @@ static const Vect_A* grafo_d_buscar_aristas(const Grafo_D* grafo, Arista ref) {
         }
         vptr=vptr->sig;
     }
-    Vect_A* vector = (Vect_A*)malloc(sizeof(Vect_A)+sizeof(Arista*)*(vectmp->tamano));
-    if(!vector) {free(vectmp); return NULL;}
+    Vect_A* vector = (Vect_A*)GRAFO_D_MALLOC(sizeof(Vect_A)+sizeof(Arista*)*(vectmp->tamano));
+    if(!vector) {GRAFO_D_FREE(vectmp); return NULL;}
     for(int i=0; i<vectmp->tamano; ++i) vector->aristas[i]=vectmp->aristas[i];
     vector->tamano=vectmp->tamano;
-    free(vectmp);
+    GRAFO_D_FREE(vectmp);
     return (const Vect_A*)vector;
 }
 
-/*  Regresa la primera arista que tenga como inicio al vertice ini y de fin al vertice fin*/
-static Arista* grafo_d_buscar_arista_entre_vert(const Grafo_D* grafo, const Vertice* ini, const Vertice* fin) {
-    Nodo_V* vptr = grafo->lista_ady;
-    while(ini!=&(vptr->vt)) vptr=vptr->sig;
-    Nodo_A* aptr = vptr->lista_ady;
-    while(aptr!=NULL) {
-        if(fin==&(aptr->fin->vt))
-            return &(aptr->ar);
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa la siguiente arista de la lista de adyacencia de vptr que termina en el vertice fin y
+    que hace que cmp_ar() regrese verdadero con ref (si cmp_ar no es NULL), o NULL si ya no hay
+    mas. *aptr y *hptr forman un cursor que debe iniciar en NULL: *aptr es la ultima arista
+    regresada y, si el vertice tiene tabla de vecinos, *hptr es el siguiente nodo de la cubeta
+    del vertice fin, de modo que cada llamada continua donde termino la anterior sin volver a
+    recorrer la cubeta desde el principio.
+*/
+static Nodo_A* _grafo_d_sig_arista_entre(const Nodo_V* vptr, Nodo_A** aptr, _Nodo_H** hptr,
+    const Nodo_V* fin, bool (*cmp_ar)(Arista*, Arista*), Arista* ref) {
+    if(vptr->indice_ady!=NULL) {
+        _Nodo_H* h=(*aptr==NULL) ? _tabla_h_cubeta(vptr->indice_ady, _GD_HASH_FIN(_GD_CLAVE_V(fin))) : *hptr;
+        for(; h!=NULL; h=h->sig) {
+            Nodo_A* nodo=(Nodo_A*)h->elem;
+            if(nodo->fin==_GD_CLAVE_V(fin) && (cmp_ar==NULL || _GD_CMP_AR(cmp_ar, &(nodo->ar), ref))) {
+                *aptr=nodo;
+                *hptr=h->sig;
+                return nodo;
+            }
+        }
+        *hptr=NULL;
+        return NULL;
     }
+    Nodo_A* ptr=(*aptr!=NULL) ? (*aptr)->sig : vptr->lista_ady;
+    for(; ptr!=NULL; ptr=ptr->sig)
+        if(ptr->fin==_GD_CLAVE_V(fin) && (cmp_ar==NULL || _GD_CMP_AR(cmp_ar, &(ptr->ar), ref))) {
+            *aptr=ptr;
+            return ptr;
+        }
     return NULL;
 }
 
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa un vector almacenado dinamicamente con todas las aristas de ini a fin que hagan que
+    cmp_ar() regrese verdadero con ref (si cmp_ar no es NULL). El vector se reserva una sola vez
+    con el tamano exacto del resultado.
+*/
+static const Vect_A* _grafo_d_aristas_entre(const Nodo_V* ini, const Nodo_V* fin,
+    bool (*cmp_ar)(Arista*, Arista*), Arista* ref) {
+    size_t total=0;
+    Nodo_A* aptr=NULL;
+    _Nodo_H* hptr=NULL;
+    while(_grafo_d_sig_arista_entre(ini, &aptr, &hptr, fin, cmp_ar, ref)!=NULL) ++total;
+    Vect_A* vector = (Vect_A*)GRAFO_D_MALLOC(sizeof(Vect_A)+sizeof(Arista*)*total);
+    if(!vector) return NULL;
+    vector->tamano=0;
+    aptr=NULL;
+    hptr=NULL;
+    while(_grafo_d_sig_arista_entre(ini, &aptr, &hptr, fin, cmp_ar, ref)!=NULL) {
+        vector->aristas[vector->tamano]=&(aptr->ar);
+        ++(vector->tamano);
+    }
+    return (const Vect_A*)vector;
+}
+
+/*  Regresa la primera arista que tenga como inicio al vertice ini y de fin al vertice fin.
+    Si el vertice ini rebasa GRAFO_D_UMBRAL_HASH_ADY aristas de salida la busqueda toma tiempo
+    O(1) promedio.
+*/
+static Arista* grafo_d_buscar_arista_entre_vert(const Grafo_D* grafo, const Vertice* ini, const Vertice* fin) {
+    (void)grafo;
+    Nodo_A* aptr=NULL;
+    _Nodo_H* hptr=NULL;
+    return _grafo_d_sig_arista_entre(_GD_NODO_V(ini), &aptr, &hptr, _GD_NODO_V(fin), NULL, NULL) ? &(aptr->ar) : NULL;
+}
+
 /*  Regresa un vector alamacenado dinamicamente con todas las aristas del grafo que tengan como
     inicio al vertice ini y de fin al vertice fin. El vector debera ser liberado mediante 
-    una llamada a la funcion free()
+    una llamada a la funcion GRAFO_D_FREE()
 */
 static const Vect_A* grafo_d_buscar_aristas_entre_vert(const Grafo_D* grafo, const Vertice* ini, const Vertice* fin) {
-    Nodo_V* vptr=grafo->lista_ady;
-    while(vptr!=NULL && ini!=&(vptr->vt)) vptr=vptr->sig;
-    Vect_A* vectmp = (Vect_A*)malloc(sizeof(Vect_A)+sizeof(Arista*)*vptr->grado_s);
-    if(!vectmp) return NULL;
-    vectmp->tamano=0;
-    Nodo_A* aptr=vptr->lista_ady;
-    while(aptr!=NULL) {
-        if(fin==&(aptr->fin->vt)) {
-            vectmp->aristas[vectmp->tamano]=&(aptr->ar);
-            ++(vectmp->tamano); 
-        }
-        aptr=aptr->sig;
-    }
-    Vect_A* vector = (Vect_A*)malloc(sizeof(Vect_A)+sizeof(Arista*)*(vectmp->tamano));
-    if(!vector) {free(vectmp); return NULL;}
-    for(int i=0; i<vectmp->tamano; ++i) vector->aristas[i]=vectmp->aristas[i];
-    vector->tamano=vectmp->tamano;
-    free(vectmp);
-    return (const Vect_A*)vector;
+    (void)grafo;
+    return _grafo_d_aristas_entre(_GD_NODO_V(ini), _GD_NODO_V(fin), NULL, NULL);
 }
 
 /*  Regresa la primera arista que haga que la funcion grafo->cmp_ar() regrese verdadero asi
@@ -553,41 +1966,34 @@ static const Vect_A* grafo_d_buscar_aristas_entre_vert(const Grafo_D* grafo, con
 */
 static Arista* grafo_d_buscar_arista_estricto(const Grafo_D* grafo, Arista ref, const Vertice* ini, const Vertice* fin) {
     assert(grafo->cmp_ar!=NULL);
-    Nodo_V* vptr = grafo->lista_ady;
-    while(ini!=&(vptr->vt)) vptr=vptr->sig;
-    Nodo_A* aptr = vptr->lista_ady;
-    while(aptr!=NULL) {
-        if(fin==&(aptr->fin->vt) && grafo->cmp_ar(&(aptr->ar), &ref))
-            return &(aptr->ar);
-    }
-    return NULL;
+    Nodo_A* aptr=NULL;
+    _Nodo_H* hptr=NULL;
+    return _grafo_d_sig_arista_entre(_GD_NODO_V(ini), &aptr, &hptr, _GD_NODO_V(fin), grafo->cmp_ar, &ref) ? &(aptr->ar) : NULL;
 }
 
 /*  Regresa un vector alamacenado dinamicamente con todas las aristas del grafo que hagan que la
     funcion grafo->cmp_ar() regrese verdadero asi como que tenga como inicio al vertice ini y de fin
-    al vertice fin. El vector debera ser liberado mediante una llamada a la funcion free()
+    al vertice fin. El vector debera ser liberado mediante una llamada a la funcion GRAFO_D_FREE()
 */
 static const Vect_A* grafo_d_buscar_aristas_estricto(const Grafo_D* grafo, Arista ref, const Vertice* ini, const Vertice* fin) {
     assert(grafo->cmp_ar!=NULL);
-    Nodo_V* vptr=grafo->lista_ady;
-    while(vptr!=NULL && ini!=&(vptr->vt)) vptr=vptr->sig;
-    Vect_A* vectmp = (Vect_A*)malloc(sizeof(Vect_A)+sizeof(Arista*)*vptr->grado_s);
-    if(!vectmp) return NULL;
-    vectmp->tamano=0;
-    Nodo_A* aptr=vptr->lista_ady;
-    while(aptr!=NULL) {
-        if(fin==&(aptr->fin->vt) && grafo->cmp_ar(&(aptr->ar), &ref)) {
-            vectmp->aristas[vectmp->tamano]=&(aptr->ar);
-            ++(vectmp->tamano); 
-        }
-        aptr=aptr->sig;
-    }
-    Vect_A* vector = (Vect_A*)malloc(sizeof(Vect_A)+sizeof(Arista*)*(vectmp->tamano));
-    if(!vector) {free(vectmp); return NULL;}
-    for(int i=0; i<vectmp->tamano; ++i) vector->aristas[i]=vectmp->aristas[i];
-    vector->tamano=vectmp->tamano;
-    free(vectmp);
-    return (const Vect_A*)vector;
+    return _grafo_d_aristas_entre(_GD_NODO_V(ini), _GD_NODO_V(fin), grafo->cmp_ar, &ref);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Quita la arista aptr, que esta en la posicion pos de la lista de adyacencia de vptr despues de
+    aprev (NULL si es la primera), actualiza grado, tamano e indices y la libera
+*/
+static void _grafo_d_desenlazar_arista(Grafo_D* grafo, Nodo_V* vptr, Nodo_A* aprev, Nodo_A* aptr, size_t pos) {
+    if(aprev!=NULL) aprev->sig=aptr->sig;
+    else vptr->lista_ady=aptr->sig;
+    --(vptr->grado_s);
+    --(grafo->tamano);
+    _grafo_d_ady_quitar(vptr, aptr);
+    vptr->bloque=NULL;
+    _grafo_d_desindexar_arista(grafo, aptr);
+    _grafo_d_liberar_arista(vptr, aptr);
+    if(grafo->diario) _grafo_d_diario_registrar(grafo, _GD_DIARIO_ELI_A, vptr, NULL, pos, NULL);
 }
 
 /*  Elimina la arista del grafo pasada como agumento ar. El argumento ar debe ser el
@@ -597,21 +2003,10 @@ static const Vect_A* grafo_d_buscar_aristas_estricto(const Grafo_D* grafo, Arist
 static void grafo_d_elminar_arista(Grafo_D* grafo, Arista* ar) {
     Nodo_V* vptr = grafo->lista_ady;
     while(vptr!=NULL) {
-        Nodo_A* aptr = vptr->lista_ady, *aprev;
-        if(aptr!=NULL && ar==&(aptr->ar)) {
-            vptr->lista_ady=aptr->sig;
-            free(aptr);
-            --(vptr->grado_s);
-            --(grafo->tamano);
-            return;
-        }
-        aprev=aptr; aptr=aptr->sig;        
-        while(aptr!=NULL) {
+        Nodo_A* aptr = vptr->lista_ady, *aprev=NULL;
+        for(size_t pos=0; aptr!=NULL; ++pos) {
             if(ar==&(aptr->ar)) {
-                aprev->sig=aptr->sig;
-                free(aptr);
-                --(vptr->grado_s);
-                --(grafo->tamano);
+                _grafo_d_desenlazar_arista(grafo, vptr, aprev, aptr, pos);
                 return;
             }
             aprev=aptr;
@@ -622,294 +2017,4352 @@ static void grafo_d_elminar_arista(Grafo_D* grafo, Arista* ar) {
     return;
 }
 
-/*----------------------------Operaciones de Representacion Matricial------------------------------*/
-typedef struct matriz_ady {
-    size_t orden;
-    Arista* datos[];
-} Matriz_Ady;
-
-typedef struct matriz_peso {
-    size_t orden;
-    peso_t datos[];
-} Matriz_Peso;
+/*--------------------------Insercion Concurrente de Aristas------------------------------*/
+#if defined(__GNUC__) || defined(__clang__)
 
-/*  Devuelve el elemento de una matriz de adyacencia o de pesos que corresponde a la arista del
-    grafo que tiene inicio en el vertice agrado en la posicion i y fin el vertice agregado en
-    la posicion j.
+/*  Version de grafo_d_insertar_arista() que puede llamarse desde varios hilos a la vez sobre el
+    mismo grafo sin ningun candado, para cargar aristas en paralelo. La arista se enlaza al
+    principio de la lista de ini con una operacion compare-and-swap y el grado de ini y el tamano
+    del grafo se incrementan de forma atomica; no se recorre la lista de vertices, por lo que ini
+    y fin deben ser identificadores validos. Mientras dure la carga:
+    - Solo pueden ejecutarse otras llamadas a esta funcion sobre el grafo, ninguna otra operacion
+      (ni consultas) puede ejecutarse a la vez, tampoco en modo concurrente.
+    - Los indices hash (de aristas y de vecinos) no se actualizan.
+    Cada arista se reserva por separado y no en los nodos locales o lotes del vertice.
+    Al terminar la carga, cuando todos los hilos hayan terminado de insertar, debe llamarse una
+    vez a grafo_d_fin_carga_atomica() para reconstruir los indices.
 */
-#define GD_MATRIZ_INDEX(matriz, i, j) (*(matriz->datos+i*matriz->orden+j))
+static Arista* grafo_d_insertar_arista_atomica(Grafo_D* grafo, Arista ar, const Vertice* ini, const Vertice* fin) {
+    Nodo_A* nuevo = (Nodo_A*)GRAFO_D_MALLOC(sizeof(Nodo_A));
+    if(!nuevo) return NULL;
+    Nodo_V* inicio=_GD_NODO_V(ini);
+    nuevo->ar=ar;
+    nuevo->fin=_GD_CLAVE_V(_GD_NODO_V(fin));
+    nuevo->sig=__atomic_load_n(&(inicio->lista_ady), __ATOMIC_RELAXED);
+    while(!__atomic_compare_exchange_n(&(inicio->lista_ady), &(nuevo->sig), nuevo,
+        true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    __atomic_add_fetch(&(inicio->grado_s), 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&(grafo->tamano), 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&(inicio->bloque), NULL, __ATOMIC_RELAXED);
+    return &(nuevo->ar);
+}
 
-/*  Regresa una matiz de adyacencia de (grafo->orden)x(grafo->orden) almacenada dinamicamente cuyos
-    ejes estan ordenados de acuerdo a el orden en el que los vertices fueron insertados en el grafo.
-    La matriz contine la direccion de memoria a un dato tipo Arista en cada celda de la matriz.
-    Todo acceso a la matriz de hacerse mediante la MACRO GD_MATRIZ_INDEX(matriz, i, j). La memoria
-    reservada para la matriz debe de ser liberada mediante una llamada a la funcion free()
+/*  Termina una carga de aristas hecha con grafo_d_insertar_arista_atomica(): reconstruye las
+    tablas de vecinos de los vertices que rebasan GRAFO_D_UMBRAL_HASH_ADY y el indice hash de
+    aristas si existe. Si el grafo tiene un diario se crea un punto de control, ya que las
+    aristas no se registraron. Regresa false si no hubo memoria para reconstruir el indice de aristas, en cuyo caso el grafo
+    queda sin el.
 */
-static Matriz_Ady* grafo_d_crear_mat_ady(const Grafo_D* grafo) {
-    Matriz_Ady* matriz_ady=(Matriz_Ady*)malloc(
-        sizeof(Matriz_Ady)+sizeof(Arista*)*grafo->orden*grafo->orden
-    );
-    if(!matriz_ady) return NULL;
-    matriz_ady->orden=grafo->orden;
-    Nodo_V* ini=grafo->lista_ady;
-    for(int i=0; i<grafo->orden; ++i, ini=ini->sig) {
-        Nodo_V* fin=grafo->lista_ady;
-        for(int j=0; j<grafo->orden; ++j, fin=fin->sig) {
-            Arista** ptr_celda=(matriz_ady->datos)+i*grafo->orden+j;
-            Nodo_A* aptr=ini->lista_ady;
-            *ptr_celda=NULL;
-            while(aptr!=NULL) {
-                if(fin==aptr->fin) { 
-                    *ptr_celda=&(aptr->ar);
-                    break;
-                }
-                aptr=aptr->sig;
-            }
+static bool grafo_d_fin_carga_atomica(Grafo_D* grafo) {
+    Nodo_V* vptr=grafo->lista_ady;
+    while(vptr!=NULL) {
+        if(vptr->indice_ady!=NULL) {
+            _tabla_h_destruir(vptr->indice_ady);
+            vptr->indice_ady=NULL;
         }
+        //Se promueve con la primer arista de la lista si el grado rebasa el umbral
+        if(vptr->lista_ady!=NULL) _grafo_d_ady_agregar(vptr, vptr->lista_ady);
+        vptr=vptr->sig;
     }
-    return matriz_ady;
+    //Las aristas cargadas no estan en el diario, se reemplaza con un punto de control
+    if(grafo->diario && !_grafo_d_diario_checkpoint(grafo)) return false;
+    if(grafo->indice_ar) return grafo_d_set_hash_ar(grafo, grafo->hash_ar);
+    return true;
 }
 
-/*  Regresa una matiz de adyacencia de (grafo->orden)x(grafo->orden) almacenada dinamicamente cuyos
-    ejes estan ordenados de acuerdo a el orden en el que los vertices fueron insertados en el grafo.
-    La matriz contine la direccion de memoria a un dato tipo peso_t en cada celda de la matriz. El
-    valor de cada celda esta determinado por el resultado de la funcion grafo->calc_peso() sobre la
-    arista correspondiente a cada posicion. Todo acceso a la matriz de hacerse mediante la MACRO
-    GD_MATRIZ_INDEX(matriz, i, j). La memoria reservada para la matriz debe de ser liberada mediante
-    una llamada a la funcion free()
+#endif
+
+/*-----------------------------------Iteradores---------------------------------------*/
+
+/*  Los iteradores permiten recorrer los resultados de una busqueda uno a uno sin reservar memoria
+    dinamica. Se crean por valor con alguna de las funciones grafo_d_iter_...() y se avanzan con
+    iter_v_siguiente()/iter_a_siguiente() hasta que estas regresan NULL. Las funciones
+    iter_v_llenar()/iter_a_llenar() copian los siguientes resultados a un arreglo del usuario.
+    El grafo no debe modificarse mientras un iterador se este usando.
 */
-static Matriz_Peso* grafo_d_crear_mat_peso(const Grafo_D* grafo) {
-    Matriz_Peso* matriz_peso=(Matriz_Peso*)malloc(
-        sizeof(Matriz_Peso)+sizeof(peso_t)*grafo->orden*grafo->orden
-    );
-    if(!matriz_peso) return NULL;
-    matriz_peso->orden=grafo->orden;
-    Nodo_V* ini=grafo->lista_ady;
-    for(int i=0; i<grafo->orden; ++i, ini=ini->sig) {
-        Nodo_V* fin=grafo->lista_ady;
-        for(int j=0; j<grafo->orden; ++j, fin=fin->sig) {
-            peso_t* ptr_celda=(matriz_peso->datos)+i*grafo->orden+j;
-            Nodo_A* aptr=ini->lista_ady;
-            *ptr_celda=PESO_NO_ARISTA;
-            while(aptr!=NULL) {
-                if(fin==aptr->fin) { 
-                    *ptr_celda=grafo->calc_peso(&(aptr->ar));
-                    break;
-                }
-                aptr=aptr->sig;
-            }
-        }
+typedef struct iter_v {
+    const Grafo_D* grafo;
+    Nodo_V* vptr;
+    _Nodo_H* hptr;
+    size_t hash;
+    bool filtro;
+    Vertice ref;
+} Iter_V;
+
+typedef struct iter_a {
+    const Grafo_D* grafo;
+    Nodo_V* vptr;
+    Nodo_A* aptr;
+    Nodo_V* fin;
+    _Nodo_H* hptr;
+    size_t hash;
+    bool todos;
+    bool filtro;
+    Arista ref;
+} Iter_A;
+
+/*  Regresa un iterador sobre todos los vertices del grafo en el orden en que fueron insertados*/
+static inline Iter_V grafo_d_iter_vertices(const Grafo_D* grafo) {
+    Iter_V it;
+    it.grafo=grafo;
+    it.vptr=grafo->lista_ady;
+    it.hptr=NULL;
+    it.hash=0;
+    it.filtro=false;
+    return it;
+}
+
+/*  Regresa un iterador sobre los vertices que hacen que grafo->cmp_vt() regrese verdadero con ref,
+    equivalente a grafo_d_buscar_vertices(). Si el grafo tiene indice hash de vertices solo se
+    visitan los vertices de la cubeta correspondiente.
+*/
+static inline Iter_V grafo_d_iter_vertices_filtro(const Grafo_D* grafo, Vertice ref) {
+    assert(grafo->cmp_vt!=NULL);
+    Iter_V it=grafo_d_iter_vertices(grafo);
+    it.filtro=true;
+    it.ref=ref;
+    if(grafo->indice_vt) {
+        it.vptr=NULL;
+        it.hash=grafo->hash_vt(&ref);
+        it.hptr=_tabla_h_cubeta(grafo->indice_vt, it.hash);
     }
-    return matriz_peso;
+    return it;
 }
 
-/*------------------------------Opraciones de busqueda de Caminos--------------------------------*/
-//  !!!ESTRUCTURA DE USO INTERNO!!!
-typedef struct _nodo_c {
-    struct _nodo_c* sig;
-    Nodo_V* vt_actual;
-    Nodo_A* ar_puente;
-    struct _nodo_c* nd_padre;
-    peso_t dist_orig;
-} _Nodo_C;
+/*  Regresa el siguiente vertice del iterador o NULL si ya no hay mas*/
+static Vertice* iter_v_siguiente(Iter_V* it) {
+    while(it->hptr!=NULL) {
+        _Nodo_H* hptr=it->hptr;
+        it->hptr=hptr->sig;
+        Nodo_V* nodo=(Nodo_V*)hptr->elem;
+        if(hptr->hash==it->hash && _GD_CMP_VT(it->grafo->cmp_vt, &(nodo->vt), &(it->ref)))
+            return &(nodo->vt);
+    }
+    while(it->vptr!=NULL) {
+        Nodo_V* nodo=it->vptr;
+        it->vptr=nodo->sig;
+        if(!it->filtro || _GD_CMP_VT(it->grafo->cmp_vt, &(nodo->vt), &(it->ref)))
+            return &(nodo->vt);
+    }
+    return NULL;
+}
+
+/*  Copia al arreglo buf a lo mas cap de los siguientes vertices del iterador y regresa cuantos
+    fueron copiados. Llamadas sucesivas continuan donde termino la anterior.
+*/
+static size_t iter_v_llenar(Iter_V* it, Vertice** buf, size_t cap) {
+    size_t n=0;
+    Vertice* vt;
+    while(n<cap && (vt=iter_v_siguiente(it))!=NULL) buf[n++]=vt;
+    return n;
+}
+
+/*  Regresa un iterador sobre todas las aristas del grafo, vertice por vertice*/
+static inline Iter_A grafo_d_iter_aristas(const Grafo_D* grafo) {
+    Iter_A it;
+    it.grafo=grafo;
+    it.vptr=grafo->lista_ady;
+    it.aptr=NULL;
+    it.fin=NULL;
+    it.hptr=NULL;
+    it.hash=0;
+    it.todos=true;
+    it.filtro=false;
+    return it;
+}
+
+/*  Regresa un iterador sobre las aristas que hacen que grafo->cmp_ar() regrese verdadero con ref,
+    equivalente a grafo_d_buscar_aristas(). Si el grafo tiene indice hash de aristas solo se
+    visitan las aristas de la cubeta correspondiente.
+*/
+static inline Iter_A grafo_d_iter_aristas_filtro(const Grafo_D* grafo, Arista ref) {
+    assert(grafo->cmp_ar!=NULL);
+    Iter_A it=grafo_d_iter_aristas(grafo);
+    it.filtro=true;
+    it.ref=ref;
+    if(grafo->indice_ar) {
+        it.vptr=NULL;
+        it.hash=grafo->hash_ar(&ref);
+        it.hptr=_tabla_h_cubeta(grafo->indice_ar, it.hash);
+    }
+    return it;
+}
+
+/*  Regresa un iterador sobre las aristas que salen del vertice vt*/
+static inline Iter_A grafo_d_iter_aristas_de(const Grafo_D* grafo, const Vertice* vt) {
+    Iter_A it=grafo_d_iter_aristas(grafo);
+    it.vptr=_GD_NODO_V(vt);
+    it.todos=false;
+    return it;
+}
+
+/*  Regresa un iterador sobre las aristas que van del vertice ini al vertice fin, equivalente a
+    grafo_d_buscar_aristas_entre_vert()
+*/
+static inline Iter_A grafo_d_iter_aristas_entre_vert(const Grafo_D* grafo, const Vertice* ini, const Vertice* fin) {
+    Iter_A it=grafo_d_iter_aristas_de(grafo, ini);
+    it.fin=_GD_NODO_V(fin);
+    return it;
+}
+
+/*  Regresa un iterador sobre las aristas que van del vertice ini al vertice fin y que hacen que
+    grafo->cmp_ar() regrese verdadero con ref, equivalente a grafo_d_buscar_aristas_estricto()
+*/
+static inline Iter_A grafo_d_iter_aristas_estricto(const Grafo_D* grafo, Arista ref, const Vertice* ini, const Vertice* fin) {
+    assert(grafo->cmp_ar!=NULL);
+    Iter_A it=grafo_d_iter_aristas_entre_vert(grafo, ini, fin);
+    it.filtro=true;
+    it.ref=ref;
+    return it;
+}
+
+/*  Regresa la siguiente arista del iterador o NULL si ya no hay mas*/
+static Arista* iter_a_siguiente(Iter_A* it) {
+    bool (*cmp_ar)(Arista*, Arista*)=it->filtro ? it->grafo->cmp_ar : NULL;
+    //Entre dos vertices hptr es el cursor de la tabla de vecinos, no del indice de aristas
+    while(it->fin==NULL && it->hptr!=NULL) {
+        _Nodo_H* hptr=it->hptr;
+        it->hptr=hptr->sig;
+        Nodo_A* nodo=(Nodo_A*)hptr->elem;
+        if(hptr->hash==it->hash && _GD_CMP_AR(cmp_ar, &(nodo->ar), &(it->ref))) {
+            it->aptr=nodo;
+            return &(nodo->ar);
+        }
+    }
+    while(it->vptr!=NULL) {
+        Nodo_A* aptr;
+        if(it->fin!=NULL)
+            aptr=_grafo_d_sig_arista_entre(it->vptr, &(it->aptr), &(it->hptr), it->fin, cmp_ar, &(it->ref));
+        else {
+            aptr=(it->aptr!=NULL) ? it->aptr->sig : it->vptr->lista_ady;
+            while(aptr!=NULL && cmp_ar!=NULL && !_GD_CMP_AR(cmp_ar, &(aptr->ar), &(it->ref)))
+                aptr=aptr->sig;
+        }
+        if(aptr!=NULL) {
+            it->aptr=aptr;
+            return &(aptr->ar);
+        }
+        it->vptr=it->todos ? it->vptr->sig : NULL;
+        it->aptr=NULL;
+    }
+    return NULL;
+}
+
+/*  Regresa el vertice en el que termina la ultima arista regresada por iter_a_siguiente()*/
+static inline Vertice* iter_a_destino(const Iter_A* it) {
+    return &(_GD_FIN(it->grafo, it->aptr)->vt);
+}
+
+/*  Copia al arreglo buf a lo mas cap de las siguientes aristas del iterador y regresa cuantas
+    fueron copiadas. Llamadas sucesivas continuan donde termino la anterior.
+*/
+static size_t iter_a_llenar(Iter_A* it, Arista** buf, size_t cap) {
+    size_t n=0;
+    Arista* ar;
+    while(n<cap && (ar=iter_a_siguiente(it))!=NULL) buf[n++]=ar;
+    return n;
+}
+
+/*-----------------------------Busquedas en Paralelo------------------------------------*/
+#ifdef GRAFO_D_HILOS
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa el numero de hilos a usar: hilos, o uno por nucleo disponible si hilos es 0
+*/
+static inline unsigned _grafo_d_num_hilos(unsigned hilos) {
+    if(hilos>0) return hilos;
+    long nucleos=sysconf(_SC_NPROCESSORS_ONLN);
+    return (nucleos>0) ? (unsigned)nucleos : 1;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Ejecuta cuerpo sobre cada una de las n tareas del arreglo tareas, cada una en su propio hilo.
+    La primer tarea y las que no se puedan lanzar en un hilo nuevo se ejecutan en el hilo actual.
+*/
+static void _grafo_d_lanzar_hilos(void* tareas, size_t tam_tarea, unsigned n, void* (*cuerpo)(void*)) {
+    pthread_t* ids=(pthread_t*)GRAFO_D_MALLOC(sizeof(pthread_t)*n);
+    bool* lanzado=(bool*)GRAFO_D_CALLOC(n, sizeof(bool));
+    for(unsigned t=1; t<n; ++t)
+        if(ids && lanzado) lanzado[t]=pthread_create(&ids[t], NULL, cuerpo, (char*)tareas+tam_tarea*t)==0;
+    cuerpo(tareas);
+    for(unsigned t=1; t<n; ++t) {
+        if(lanzado && lanzado[t]) pthread_join(ids[t], NULL);
+        else cuerpo((char*)tareas+tam_tarea*t);
+    }
+    GRAFO_D_FREE(ids); GRAFO_D_FREE(lanzado);
+}
+
+
+/*  !!!ESTRUCTURA DE USO INTERNO!!!
+    Trabajo asignado a cada hilo de una busqueda en paralelo: un rango [ini, fin) del arreglo
+    de vertices y un arreglo dinamico propio donde se acumulan los resultados encontrados.
+*/
+typedef struct _tarea_busq {
+    const Grafo_D* grafo;
+    Nodo_V** vertices;
+    size_t ini, fin;
+    const void* ref;
+    void** res;
+    size_t tamano;
+    size_t capacidad;
+    bool error;
+} _Tarea_Busq;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Agrega un resultado al arreglo de la tarea duplicando su capacidad cuando se llena
+*/
+static inline void _tarea_busq_agregar(_Tarea_Busq* tarea, void* elem) {
+    if(tarea->tamano==tarea->capacidad) {
+        size_t capacidad=tarea->capacidad ? tarea->capacidad*2 : 64;
+        void** res=(void**)GRAFO_D_REALLOC(tarea->res, sizeof(void*)*capacidad);
+        if(!res) {tarea->error=true; return;}
+        tarea->res=res;
+        tarea->capacidad=capacidad;
+    }
+    tarea->res[tarea->tamano++]=elem;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Cuerpo de cada hilo de grafo_d_buscar_vertices_par()
+*/
+static void* _grafo_d_hilo_busq_v(void* arg) {
+    _Tarea_Busq* tarea=(_Tarea_Busq*)arg;
+    Vertice* ref=(Vertice*)tarea->ref;
+    for(size_t i=tarea->ini; i<tarea->fin && !tarea->error; ++i)
+        if(_GD_CMP_VT(tarea->grafo->cmp_vt, &(tarea->vertices[i]->vt), ref))
+            _tarea_busq_agregar(tarea, &(tarea->vertices[i]->vt));
+    return NULL;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Cuerpo de cada hilo de grafo_d_buscar_aristas_par()
+*/
+static void* _grafo_d_hilo_busq_a(void* arg) {
+    _Tarea_Busq* tarea=(_Tarea_Busq*)arg;
+    Arista* ref=(Arista*)tarea->ref;
+    for(size_t i=tarea->ini; i<tarea->fin && !tarea->error; ++i) {
+        Nodo_A* aptr=tarea->vertices[i]->lista_ady;
+        for(; aptr!=NULL; aptr=aptr->sig)
+            if(_GD_CMP_AR(tarea->grafo->cmp_ar, &(aptr->ar), ref))
+                _tarea_busq_agregar(tarea, &(aptr->ar));
+    }
+    return NULL;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Reparte los vertices del grafo entre hilos tareas y ejecuta la funcion cuerpo en cada una.
+    Si por_aristas es verdadero los rangos se eligen para que cada hilo reciba un numero similar
+    de aristas. Regresa un arreglo dinamico con todos los resultados en el mismo orden que la
+    version secuencial y escribe su tamano en total; regresa NULL si no hubo memoria.
+*/
+static void** _grafo_d_buscar_par(const Grafo_D* grafo, const void* ref, unsigned hilos,
+    bool por_aristas, void* (*cuerpo)(void*), size_t* total) {
+    hilos=_grafo_d_num_hilos(hilos);
+    if(hilos>grafo->orden) hilos=grafo->orden ? (unsigned)grafo->orden : 1;
+    Nodo_V** vertices=(Nodo_V**)GRAFO_D_MALLOC(sizeof(Nodo_V*)*(grafo->orden ? grafo->orden : 1));
+    _Tarea_Busq* tareas=(_Tarea_Busq*)GRAFO_D_CALLOC(hilos, sizeof(_Tarea_Busq));
+    void** res=NULL;
+    if(!vertices || !tareas) goto salir;
+
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig) vertices[i]=vptr;
+
+    //Repartimos los rangos de vertices entre las tareas
+    size_t carga_total=por_aristas ? grafo->tamano+grafo->orden : grafo->orden;
+    size_t pos=0, carga=0;
+    for(unsigned t=0; t<hilos; ++t) {
+        size_t meta=carga_total/hilos*(t+1);
+        tareas[t].grafo=grafo;
+        tareas[t].vertices=vertices;
+        tareas[t].ref=ref;
+        tareas[t].ini=pos;
+        while(pos<grafo->orden && (carga<meta || t==hilos-1)) {
+            carga+=por_aristas ? vertices[pos]->grado_s+1 : 1;
+            ++pos;
+        }
+        tareas[t].fin=pos;
+    }
+
+    _grafo_d_lanzar_hilos(tareas, sizeof(_Tarea_Busq), hilos, cuerpo);
+
+    //Unimos los resultados de cada tarea en orden
+    *total=0;
+    for(unsigned t=0; t<hilos; ++t) {
+        if(tareas[t].error) goto salir;
+        *total+=tareas[t].tamano;
+    }
+    res=(void**)GRAFO_D_MALLOC(sizeof(void*)*(*total ? *total : 1));
+    if(!res) goto salir;
+    pos=0;
+    for(unsigned t=0; t<hilos; ++t)
+        for(size_t i=0; i<tareas[t].tamano; ++i) res[pos++]=tareas[t].res[i];
+
+salir:
+    if(tareas) for(unsigned t=0; t<hilos; ++t) GRAFO_D_FREE(tareas[t].res);
+    GRAFO_D_FREE(vertices); GRAFO_D_FREE(tareas);
+    return res;
+}
+
+/*  Version en paralelo de grafo_d_buscar_vertices(). Los vertices se reparten entre el numero de
+    hilos indicado (0 usa un hilo por nucleo disponible) que evaluan grafo->cmp_vt() de forma
+    concurrente, por lo que esta funcion debe poder llamarse desde varios hilos a la vez. El
+    resultado es identico al de la version secuencial y debe liberarse con GRAFO_D_FREE(). Si el
+    grafo tiene indice hash de vertices se usa la version secuencial, que ya es O(1) promedio.
+*/
+static const Vect_V* grafo_d_buscar_vertices_par(const Grafo_D* grafo, Vertice ref, unsigned hilos) {
+    assert(grafo->cmp_vt!=NULL);
+    if(grafo->indice_vt) return grafo_d_buscar_vertices(grafo, ref);
+    size_t total;
+    void** res=_grafo_d_buscar_par(grafo, &ref, hilos, false, _grafo_d_hilo_busq_v, &total);
+    if(!res) return NULL;
+    Vect_V* vector = (Vect_V*)GRAFO_D_MALLOC(sizeof(Vect_V)+sizeof(Vertice*)*total);
+    if(!vector) {GRAFO_D_FREE(res); return NULL;}
+    for(size_t i=0; i<total; ++i) vector->vertices[i]=(Vertice*)res[i];
+    vector->tamano=total;
+    GRAFO_D_FREE(res);
+    return (const Vect_V*)vector;
+}
+
+/*  Version en paralelo de grafo_d_buscar_aristas(). Los vertices se reparten entre el numero de
+    hilos indicado (0 usa un hilo por nucleo disponible) de modo que cada hilo recorra un numero
+    similar de aristas evaluando grafo->cmp_ar() de forma concurrente, por lo que esta funcion debe
+    poder llamarse desde varios hilos a la vez. El resultado es identico al de la version
+    secuencial y debe liberarse con GRAFO_D_FREE(). Si el grafo tiene indice hash de aristas se usa
+    la version secuencial.
+*/
+static const Vect_A* grafo_d_buscar_aristas_par(const Grafo_D* grafo, Arista ref, unsigned hilos) {
+    assert(grafo->cmp_ar!=NULL);
+    if(grafo->indice_ar) return grafo_d_buscar_aristas(grafo, ref);
+    size_t total;
+    void** res=_grafo_d_buscar_par(grafo, &ref, hilos, true, _grafo_d_hilo_busq_a, &total);
+    if(!res) return NULL;
+    Vect_A* vector = (Vect_A*)GRAFO_D_MALLOC(sizeof(Vect_A)+sizeof(Arista*)*total);
+    if(!vector) {GRAFO_D_FREE(res); return NULL;}
+    for(size_t i=0; i<total; ++i) vector->aristas[i]=(Arista*)res[i];
+    vector->tamano=total;
+    GRAFO_D_FREE(res);
+    return (const Vect_A*)vector;
+}
+
+#endif
+
+/*----------------------------Operaciones de Representacion Matricial------------------------------*/
+typedef struct matriz_ady {
+    size_t orden;
+    Arista* datos[];
+} Matriz_Ady;
+
+typedef struct matriz_peso {
+    size_t orden;
+    peso_t datos[];
+} Matriz_Peso;
+
+/*  Devuelve el elemento de una matriz de adyacencia o de pesos que corresponde a la arista del
+    grafo que tiene inicio en el vertice agrado en la posicion i y fin el vertice agregado en
+    la posicion j.
+*/
+#define GD_MATRIZ_INDEX(matriz, i, j) (*(matriz->datos+i*matriz->orden+j))
+
+/*  Matriz de pesos simetrica almacenada de forma empaquetada. Solo se guarda el triangulo
+    superior (incluyendo la diagonal) por renglones, es decir orden*(orden+1)/2 celdas.
+*/
+typedef struct matriz_peso_sim {
+    size_t orden;
+    peso_t datos[];
+} Matriz_Peso_Sim;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Calcula la posicion dentro del arreglo empaquetado de la celda (i, j) de una matriz
+    simetrica de orden n. Las posiciones (i, j) y (j, i) corresponden a la misma celda.
+*/
+static inline size_t _gd_pos_sim(size_t n, size_t i, size_t j) {
+    if(i>j) {size_t tmp=i; i=j; j=tmp;}
+    return i*(2*n-i+1)/2+(j-i);
+}
+
+/*  Devuelve el elemento de una matriz simetrica empaquetada que corresponde a la arista entre
+    el vertice agregado en la posicion i y el vertice agregado en la posicion j. El orden de los
+    indices es indiferente: GD_MATRIZ_SIM_INDEX(matriz, i, j) y GD_MATRIZ_SIM_INDEX(matriz, j, i)
+    hacen referencia a la misma celda.
+*/
+#define GD_MATRIZ_SIM_INDEX(matriz, i, j) \
+    (*((matriz)->datos+_gd_pos_sim((matriz)->orden, (i), (j))))
+
+/*  !!!ESTRUCTURA DE USO INTERNO!!!
+    Relaciona la direccion de un Nodo_V con la posicion del vertice en la lista de
+    adyacencia del grafo. Un arreglo de estas entradas ordenado por direccion permite
+    traducir el destino de una arista a su posicion en O(log(orden)).
+*/
+typedef struct _indice_v {
+    uintptr_t nodo;
+    size_t pos;
+} _Indice_V;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Funcion de comparacion para ordenar un arreglo de _Indice_V con qsort()
+*/
+static int _cmp_indice_v(const void* a, const void* b) {
+    uintptr_t na=((const _Indice_V*)a)->nodo, nb=((const _Indice_V*)b)->nodo;
+    return (na>nb)-(na<nb);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa un arreglo dinamicamente almacenado de grafo->orden entradas _Indice_V ordenado
+    por la direccion de cada Nodo_V. Debe liberarse con una llamada a GRAFO_D_FREE()
+*/
+static _Indice_V* _grafo_d_crear_indice_v(const Grafo_D* grafo) {
+    _Indice_V* indice=(_Indice_V*)GRAFO_D_MALLOC(sizeof(_Indice_V)*(grafo->orden ? grafo->orden : 1));
+    if(!indice) return NULL;
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig) {
+        indice[i].nodo=(uintptr_t)vptr;
+        indice[i].pos=i;
+    }
+    qsort(indice, grafo->orden, sizeof(_Indice_V), _cmp_indice_v);
+    return indice;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Busca mediante busqueda binaria la posicion del Nodo_V nodo en un indice creado con
+    _grafo_d_crear_indice_v(). El nodo debe pertenecer al grafo con el que se creo el indice.
+*/
+static size_t _grafo_d_pos_indice_v(const _Indice_V* indice, size_t orden, const Nodo_V* nodo) {
+    size_t ini=0, fin=orden;
+    uintptr_t clave=(uintptr_t)nodo;
+    while(ini<fin) {
+        size_t mitad=ini+(fin-ini)/2;
+        if(indice[mitad].nodo<clave) ini=mitad+1;
+        else fin=mitad;
+    }
+    assert(ini<orden && indice[ini].nodo==clave);
+    return indice[ini].pos;
+}
+
+/*  Regresa una matiz de adyacencia de (grafo->orden)x(grafo->orden) almacenada dinamicamente cuyos
+    ejes estan ordenados de acuerdo a el orden en el que los vertices fueron insertados en el grafo.
+    La matriz contine la direccion de memoria a un dato tipo Arista en cada celda de la matriz.
+    Todo acceso a la matriz de hacerse mediante la MACRO GD_MATRIZ_INDEX(matriz, i, j). La memoria
+    reservada para la matriz debe de ser liberada mediante una llamada a la funcion GRAFO_D_FREE()
+*/
+static Matriz_Ady* grafo_d_crear_mat_ady(const Grafo_D* grafo) {
+    Matriz_Ady* matriz_ady=(Matriz_Ady*)GRAFO_D_MALLOC(
+        sizeof(Matriz_Ady)+sizeof(Arista*)*grafo->orden*grafo->orden
+    );
+    if(!matriz_ady) return NULL;
+    matriz_ady->orden=grafo->orden;
+    Nodo_V* ini=grafo->lista_ady;
+    for(int i=0; i<grafo->orden; ++i, ini=ini->sig) {
+        Nodo_V* fin=grafo->lista_ady;
+        for(int j=0; j<grafo->orden; ++j, fin=fin->sig) {
+            Arista** ptr_celda=(matriz_ady->datos)+i*grafo->orden+j;
+            Nodo_A* aptr=ini->lista_ady;
+            *ptr_celda=NULL;
+            while(aptr!=NULL) {
+                if(_GD_CLAVE_V(fin)==aptr->fin) { 
+                    *ptr_celda=&(aptr->ar);
+                    break;
+                }
+                aptr=aptr->sig;
+            }
+        }
+    }
+    return matriz_ady;
+}
+
+/*  Regresa una matiz de adyacencia de (grafo->orden)x(grafo->orden) almacenada dinamicamente cuyos
+    ejes estan ordenados de acuerdo a el orden en el que los vertices fueron insertados en el grafo.
+    La matriz contine la direccion de memoria a un dato tipo peso_t en cada celda de la matriz. El
+    valor de cada celda esta determinado por el resultado de la funcion grafo->calc_peso() sobre la
+    arista correspondiente a cada posicion. Todo acceso a la matriz de hacerse mediante la MACRO
+    GD_MATRIZ_INDEX(matriz, i, j). La memoria reservada para la matriz debe de ser liberada mediante
+    una llamada a la funcion GRAFO_D_FREE()
+*/
+static Matriz_Peso* grafo_d_crear_mat_peso(const Grafo_D* grafo) {
+    Matriz_Peso* matriz_peso=(Matriz_Peso*)GRAFO_D_MALLOC(
+        sizeof(Matriz_Peso)+sizeof(peso_t)*grafo->orden*grafo->orden
+    );
+    if(!matriz_peso) return NULL;
+    matriz_peso->orden=grafo->orden;
+    Nodo_V* ini=grafo->lista_ady;
+    for(int i=0; i<grafo->orden; ++i, ini=ini->sig) {
+        Nodo_V* fin=grafo->lista_ady;
+        for(int j=0; j<grafo->orden; ++j, fin=fin->sig) {
+            peso_t* ptr_celda=(matriz_peso->datos)+i*grafo->orden+j;
+            Nodo_A* aptr=ini->lista_ady;
+            *ptr_celda=PESO_NO_ARISTA;
+            while(aptr!=NULL) {
+                if(_GD_CLAVE_V(fin)==aptr->fin) { 
+                    *ptr_celda=_GD_PESO(grafo->calc_peso, &(aptr->ar));
+                    break;
+                }
+                aptr=aptr->sig;
+            }
+        }
+    }
+    return matriz_peso;
+}
+
+/*  Regresa si la matriz de pesos del grafo es simetrica, es decir si para todo par de vertices
+    (i, j) el peso de la arista de i a j es igual al peso de la arista de j a i. Un grafo
+    construido unicamente con grafo_d_insertar_arpar() o grafo_d_insertar_arista_par() siempre
+    es simetrico. Esta funcion permite decidir si se puede usar grafo_d_crear_mat_peso_sim().
+*/
+static bool grafo_d_es_simetrico(const Grafo_D* grafo) {
+    Nodo_V* vptr=grafo->lista_ady;
+    while(vptr!=NULL) {
+        Nodo_A* aptr=vptr->lista_ady;
+        while(aptr!=NULL) {
+            //Solo la primer arista hacia cada destino define la celda de la matriz
+            Nodo_A* primera=vptr->lista_ady;
+            while(primera->fin!=aptr->fin) primera=primera->sig;
+            if(primera==aptr) {
+                Nodo_A* conjugada=_GD_FIN(grafo, aptr)->lista_ady;
+                while(conjugada!=NULL && conjugada->fin!=_GD_CLAVE_V(vptr))
+                    conjugada=conjugada->sig;
+                if(conjugada==NULL) return false;
+                if(_GD_PESO(grafo->calc_peso, &(aptr->ar))!=_GD_PESO(grafo->calc_peso, &(conjugada->ar)))
+                    return false;
+            }
+            aptr=aptr->sig;
+        }
+        vptr=vptr->sig;
+    }
+    return true;
+}
+
+/*  Regresa una matriz de pesos simetrica empaquetada de (grafo->orden)x(grafo->orden) que ocupa
+    la mitad de memoria que la regresada por grafo_d_crear_mat_peso(). Los ejes estan ordenados
+    de acuerdo a el orden en el que los vertices fueron insertados en el grafo. Se asume que el
+    grafo es simetrico (ver grafo_d_es_simetrico()); de no ser asi cada celda toma el peso de la
+    primer arista encontrada en cualquiera de los dos sentidos. Todo acceso a la matriz debe
+    hacerse mediante la MACRO GD_MATRIZ_SIM_INDEX(matriz, i, j). La memoria reservada para la
+    matriz debe de ser liberada mediante una llamada a la funcion GRAFO_D_FREE()
+*/
+static Matriz_Peso_Sim* grafo_d_crear_mat_peso_sim(const Grafo_D* grafo) {
+    size_t n=grafo->orden;
+    Matriz_Peso_Sim* matriz=(Matriz_Peso_Sim*)GRAFO_D_MALLOC(
+        sizeof(Matriz_Peso_Sim)+sizeof(peso_t)*(n*(n+1)/2)
+    );
+    if(!matriz) return NULL;
+    _Indice_V* indice=_grafo_d_crear_indice_v(grafo);
+    if(!indice) {GRAFO_D_FREE(matriz); return NULL;}
+    matriz->orden=n;
+    for(size_t k=0; k<n*(n+1)/2; ++k) matriz->datos[k]=PESO_NO_ARISTA;
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig) {
+        Nodo_A* aptr=vptr->lista_ady;
+        while(aptr!=NULL) {
+            size_t j=_grafo_d_pos_indice_v(indice, n, _GD_FIN(grafo, aptr));
+            peso_t* ptr_celda=&GD_MATRIZ_SIM_INDEX(matriz, i, j);
+            if(*ptr_celda==PESO_NO_ARISTA)
+                *ptr_celda=_GD_PESO(grafo->calc_peso, &(aptr->ar));
+            aptr=aptr->sig;
+        }
+    }
+    GRAFO_D_FREE(indice);
+    return matriz;
+}
+
+/*  Matriz de adyacencia de bits, cada celda ocupa un unico bit que indica si existe al menos una
+    arista entre el vertice del renglon y el de la columna. Cada renglon se rellena con ceros hasta
+    un multiplo de GD_BITS_VECTOR bits para que las operaciones sobre renglones completos trabajen
+    con palabras enteras y el compilador pueda vectorizarlas. Ocupa 64 veces menos memoria que una
+    Matriz_Ady del mismo orden.
+*/
+typedef struct matriz_bits {
+    size_t orden;
+    size_t palabras;
+    uint64_t datos[];
+} Matriz_Bits;
+
+/*  Numero de bits al que se rellena cada renglon de una Matriz_Bits, debe ser multiplo de 64.
+    Por defecto corresponde al ancho de un registro AVX2.
+*/
+#ifndef GD_BITS_VECTOR
+#define GD_BITS_VECTOR 256
+#endif
+
+/*  Devuelve 1 si existe una arista del vertice agregado en la posicion i al vertice agregado en
+    la posicion j en la matriz de bits, 0 en caso contrario.
+*/
+#define GD_MATRIZ_BIT(matriz, i, j) \
+    (((matriz)->datos[(i)*(matriz)->palabras+((j)>>6)]>>((j)&63))&1u)
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Cuenta el numero de bits encendidos en una palabra de 64 bits
+*/
+static inline size_t _gd_popcount(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_popcountll(x);
+#else
+    x=x-((x>>1)&0x5555555555555555ULL);
+    x=(x&0x3333333333333333ULL)+((x>>2)&0x3333333333333333ULL);
+    x=(x+(x>>4))&0x0F0F0F0F0F0F0F0FULL;
+    return (size_t)((x*0x0101010101010101ULL)>>56);
+#endif
+}
+
+/*  Regresa una matriz de bits de (grafo->orden)x(grafo->orden) almacenada dinamicamente cuyos ejes
+    estan ordenados de acuerdo a el orden en el que los vertices fueron insertados en el grafo.
+    Todo acceso a la matriz debe hacerse mediante la MACRO GD_MATRIZ_BIT(matriz, i, j). La memoria
+    reservada para la matriz debe de ser liberada mediante una llamada a la funcion GRAFO_D_FREE()
+*/
+static Matriz_Bits* grafo_d_crear_mat_bits(const Grafo_D* grafo) {
+    size_t n=grafo->orden;
+    size_t palabras=(n+GD_BITS_VECTOR-1)/GD_BITS_VECTOR*(GD_BITS_VECTOR/64);
+    Matriz_Bits* matriz=(Matriz_Bits*)GRAFO_D_CALLOC(1,
+        sizeof(Matriz_Bits)+sizeof(uint64_t)*palabras*n
+    );
+    if(!matriz) return NULL;
+    _Indice_V* indice=_grafo_d_crear_indice_v(grafo);
+    if(!indice) {GRAFO_D_FREE(matriz); return NULL;}
+    matriz->orden=n;
+    matriz->palabras=palabras;
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig) {
+        uint64_t* renglon=matriz->datos+i*palabras;
+        Nodo_A* aptr=vptr->lista_ady;
+        while(aptr!=NULL) {
+            size_t j=_grafo_d_pos_indice_v(indice, n, _GD_FIN(grafo, aptr));
+            renglon[j>>6]|=(uint64_t)1<<(j&63);
+            aptr=aptr->sig;
+        }
+    }
+    GRAFO_D_FREE(indice);
+    return matriz;
+}
+
+/*  Regresa el numero de vertices k tales que existe una arista de i a k y una arista de j a k,
+    es decir el numero de vecinos en comun entre los vertices de las posiciones i y j.
+*/
+static size_t matriz_bits_vecinos_comunes(const Matriz_Bits* matriz, size_t i, size_t j) {
+    const uint64_t* ri=matriz->datos+i*matriz->palabras;
+    const uint64_t* rj=matriz->datos+j*matriz->palabras;
+    size_t total=0;
+    for(size_t w=0; w<matriz->palabras; ++w)
+        total+=_gd_popcount(ri[w]&rj[w]);
+    return total;
+}
+
+/*  Regresa el numero de triangulos del grafo representado por la matriz. Cada triangulo se
+    cuenta una sola vez como la terna i<j<k con aristas i->j, i->k y j->k, por lo que el
+    resultado corresponde a los triangulos de un grafo no dirigido cuando la matriz es
+    simetrica (ver grafo_d_es_simetrico()). Los lazos se ignoran.
+*/
+static size_t matriz_bits_contar_triangulos(const Matriz_Bits* matriz) {
+    size_t total=0;
+    for(size_t i=0; i<matriz->orden; ++i) {
+        const uint64_t* ri=matriz->datos+i*matriz->palabras;
+        for(size_t j=i+1; j<matriz->orden; ++j) {
+            if(!GD_MATRIZ_BIT(matriz, i, j)) continue;
+            const uint64_t* rj=matriz->datos+j*matriz->palabras;
+            //Solo se cuentan los vecinos k>j
+            size_t w=(j+1)>>6;
+            if(w>=matriz->palabras) continue;
+            uint64_t mascara=~(uint64_t)0<<((j+1)&63);
+            total+=_gd_popcount(ri[w]&rj[w]&mascara);
+            for(++w; w<matriz->palabras; ++w)
+                total+=_gd_popcount(ri[w]&rj[w]);
+        }
+    }
+    return total;
+}
+
+/*  Transforma la matriz en su cerradura transitiva mediante el algoritmo de Warshall, despues
+    de la operacion GD_MATRIZ_BIT(matriz, i, j) es 1 si y solo si existe un camino de al menos
+    una arista del vertice i al vertice j. Cada paso combina renglones completos palabra por
+    palabra, por lo que el costo es O(orden^3/64).
+*/
+static void matriz_bits_cerradura_transitiva(Matriz_Bits* matriz) {
+    for(size_t k=0; k<matriz->orden; ++k) {
+        const uint64_t* rk=matriz->datos+k*matriz->palabras;
+        for(size_t i=0; i<matriz->orden; ++i) {
+            if(!GD_MATRIZ_BIT(matriz, i, k)) continue;
+            uint64_t* ri=matriz->datos+i*matriz->palabras;
+            for(size_t w=0; w<matriz->palabras; ++w)
+                ri[w]|=rk[w];
+        }
+    }
+    return;
+}
+
+/*------------------------------Opraciones de busqueda de Caminos--------------------------------*/
+//  !!!ESTRUCTURA DE USO INTERNO!!!
+typedef struct _nodo_c {
+    struct _nodo_c* sig;
+    Nodo_V* vt_actual;
+    Nodo_A* ar_puente;
+    struct _nodo_c* nd_padre;
+    peso_t dist_orig;
+} _Nodo_C;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Busca en la lista de Nodos_C el Nodo_C que hace referencia a el Nodo_V
+    pasado como segundo argumento.
+*/
+static _Nodo_C* _get_nodo_c_vertice(_Nodo_C* cptr, Nodo_V* vt) {
+    while(cptr!=NULL) {
+        if(cptr->vt_actual==vt) return cptr;
+        cptr=cptr->sig;
+    }
+    return NULL;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Busca en la lista de Nodos_C el Nodo_C con el valor de dist_orig minimo 
+    (y finito) en toda la lista.
+*/
+static _Nodo_C* _get_nodo_c_minimo(_Nodo_C* cptr) {
+    _Nodo_C* minimo = cptr;
+    while(cptr!=NULL) {
+        if(cptr->dist_orig < minimo->dist_orig)
+            minimo=cptr;
+        cptr=cptr->sig;
+    }
+    if(minimo->dist_orig!=PESO_NO_ARISTA)
+        return minimo;
+    return NULL;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Libera el espacio de memoria de la lista de Nodos_C apuntada por
+    el puntero cptr. cptr debe ser la cabeza de la lista para evitar
+    perdida de memoria
+*/
+static void _liberar_lista_c(_Nodo_C* cptr) {
+    _Nodo_C* ctmp;
+    while(cptr!=NULL) {
+        ctmp=cptr;
+        cptr=cptr->sig;
+        GRAFO_D_FREE(ctmp);
+    }
+    return;
+}
+
+typedef struct camino_d {
+    Vertice** vts;
+    Arista** ars;
+    size_t saltos;
+    peso_t longitud;
+} Camino_D;
+
+static inline bool es_camino_valido(Camino_D* camino) {
+    return camino->vts!=NULL;
+}
+
+/*  Libera la memoria reservada para el camino que se pasa como argumento
+    de la funcion. El puntero que apuntaba al camino se vuelve invalido
+    despues de esta operacion.
+*/
+static void camino_d_destruir(Camino_D* camino) {
+    if(camino->vts) GRAFO_D_FREE(camino->vts);
+    if(camino->ars) GRAFO_D_FREE(camino->ars);
+    GRAFO_D_FREE(camino);
+    return;
+}
+
+/*  Encuentra el camino mas corto entre el vertice ini y fin utilizando el algoritmo
+    de Dijkstra. El camino se regresa como un struct tipo Camino_D dinamicamente almacenado
+    en memoria y por lo tanto debera de liberarse utilizando la funcion camino_d_destruir.
+    En caso de error la funcion regresa NULL. En caso de que no exista ningun camino entre
+    el los vertice ini y fin, la funcion regresa un camino invalido, no NULL, e igualmente
+    debera ser liberado usando camino_d_destruir. 
+*/
+static Camino_D* grafo_d_dijkstra(const Grafo_D* grafo, const Vertice* ini, const Vertice* fin) {
+    if(!grafo->calc_peso) return NULL;
+
+    Nodo_V* vptr; Nodo_A* aptr; _Nodo_C* cptr;
+    _Nodo_C* visitados=NULL;
+    _Nodo_C* no_visitados=NULL;
+    vptr=grafo->lista_ady;
+    //Inicializamos listas de visitados y no visitados
+    while(vptr!=NULL) {
+        cptr=(_Nodo_C*)GRAFO_D_MALLOC(sizeof(_Nodo_C));
+        if(!cptr) {
+            _liberar_lista_c(visitados);
+            _liberar_lista_c(no_visitados);
+            return NULL;
+        }
+        if(ini!=&(vptr->vt)) {
+            cptr->sig=no_visitados;
+            cptr->vt_actual=vptr;
+            cptr->ar_puente=NULL;
+            cptr->nd_padre=NULL;
+            cptr->dist_orig=PESO_NO_ARISTA;
+            no_visitados=cptr;
+        }
+        else {
+            cptr->sig=NULL;
+            cptr->vt_actual=vptr;
+            cptr->ar_puente=NULL;
+            cptr->nd_padre=NULL;
+            cptr->dist_orig=0;
+            visitados=cptr;
+        }
+        vptr=vptr->sig;
+    }
+
+    /*----------------Parte Iterativa----------------
+        Ejecutamos Dijkstra hasta encontrar el camino
+        mas corto hasta el vertice fin */
+    _Nodo_C* nodo_ref = visitados;
+    while(fin!=&(nodo_ref->vt_actual->vt)) {
+
+        //Para cada arista de salida del vertice
+        aptr = nodo_ref->vt_actual->lista_ady;
+        while(aptr!=NULL) {
+            _Nodo_C* nodo_fin = _get_nodo_c_vertice(no_visitados, _GD_FIN(grafo, aptr));
+            if(nodo_fin!=NULL) {
+                peso_t dp=nodo_ref->dist_orig+_GD_PESO(grafo->calc_peso, &(aptr->ar));
+                if(dp < nodo_fin->dist_orig) {
+                    nodo_fin->dist_orig = dp;
+                    nodo_fin->nd_padre  = nodo_ref;
+                    nodo_fin->ar_puente = aptr;
+                }
+            }
+            aptr=aptr->sig;
+        }
+
+        //Acualizar nodo_ref
+        nodo_ref = _get_nodo_c_minimo(no_visitados);
+
+        //Si no existen vertices alcanzables regresamos un camino invalido
+        if(nodo_ref==NULL) {
+            _liberar_lista_c(visitados);
+            _liberar_lista_c(no_visitados);
+            Camino_D* camino=(Camino_D*)GRAFO_D_MALLOC(sizeof(Camino_D));
+            if(!camino) return NULL;
+            camino->vts=NULL; camino->ars=NULL;
+            camino->saltos=0; camino->longitud=0;
+            return camino;
+        };
+
+        //Pasar nuevo nodo_ref de no_visitados a visitados
+        if(nodo_ref==no_visitados) {
+            no_visitados=no_visitados->sig;
+            nodo_ref->sig=visitados;
+            visitados=nodo_ref;
+        }
+        else {
+            cptr=no_visitados;
+            while(cptr->sig!=nodo_ref)
+                cptr=cptr->sig;
+            cptr->sig=nodo_ref->sig;
+            nodo_ref->sig=visitados;
+            visitados=nodo_ref;
+        }
+    }
+
+    _liberar_lista_c(no_visitados);
+
+    Camino_D* camino = (Camino_D*)GRAFO_D_MALLOC(sizeof(Camino_D));
+    if(!camino) {_liberar_lista_c(visitados); return NULL;}
+    camino->longitud=nodo_ref->dist_orig;
+    camino->saltos=0;
+    cptr=nodo_ref;
+    while(cptr->nd_padre!=NULL) {
+        ++(camino->saltos);
+        cptr=cptr->nd_padre;
+    }
+
+    camino->vts=(Vertice**)GRAFO_D_MALLOC(sizeof(Vertice*)*(camino->saltos+1));
+    if(!camino->vts) {
+        _liberar_lista_c(visitados);
+        GRAFO_D_FREE(camino);
+        return NULL;
+    }
+    camino->vts[0]=(Vertice*)ini;
+    camino->ars=NULL;
+    
+    //Si el camino no tiene aristas regresamos un camino trivial
+    if(camino->saltos==0) {
+        _liberar_lista_c(visitados);
+        return camino;
+    }
+
+    camino->ars=(Arista**)GRAFO_D_MALLOC(sizeof(Arista*)*camino->saltos);
+    if(!camino->ars) {
+        _liberar_lista_c(visitados);
+        GRAFO_D_FREE(camino->vts); GRAFO_D_FREE(camino);
+        return NULL;
+    }
+    cptr=nodo_ref;
+    for(size_t i=camino->saltos; i>0; --i) {
+        camino->vts[i]=&(cptr->vt_actual->vt);
+        camino->ars[i-1]=&(cptr->ar_puente->ar);
+        cptr=cptr->nd_padre;
+    }
+    
+    _liberar_lista_c(visitados);
+    return camino;
+}
+
+/*  !!!ESTRUCTURA DE USO INTERNO!!!
+    Monticulo binario de minimos indexado por la posicion de cada vertice. Permite reducir la
+    distancia de un vertice que ya esta en el monticulo en O(log(n)). pos[v] es la posicion de v
+    dentro de elems o GD_NO_POSICION si v no esta en el monticulo.
+*/
+typedef struct _monticulo {
+    size_t tamano;
+    size_t* elems;
+    size_t* pos;
+    peso_t* dist;
+} _Monticulo;
+
+/*  Posicion invalida que regresan las funciones que buscan la posicion de un vertice*/
+#define GD_NO_POSICION SIZE_MAX
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Crea un monticulo vacio para n vertices con todas las distancias en PESO_NO_ARISTA
+*/
+static _Monticulo* _monticulo_crear(size_t n) {
+    _Monticulo* m=(_Monticulo*)GRAFO_D_MALLOC(sizeof(_Monticulo));
+    if(!m) return NULL;
+    m->tamano=0;
+    m->elems=(size_t*)GRAFO_D_MALLOC(sizeof(size_t)*(n ? n : 1));
+    m->pos=(size_t*)GRAFO_D_MALLOC(sizeof(size_t)*(n ? n : 1));
+    m->dist=(peso_t*)GRAFO_D_MALLOC(sizeof(peso_t)*(n ? n : 1));
+    if(!m->elems || !m->pos || !m->dist) {
+        GRAFO_D_FREE(m->elems); GRAFO_D_FREE(m->pos); GRAFO_D_FREE(m->dist); GRAFO_D_FREE(m);
+        return NULL;
+    }
+    for(size_t i=0; i<n; ++i) {
+        m->pos[i]=GD_NO_POSICION;
+        m->dist[i]=PESO_NO_ARISTA;
+    }
+    return m;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static void _monticulo_destruir(_Monticulo* m) {
+    GRAFO_D_FREE(m->elems); GRAFO_D_FREE(m->pos); GRAFO_D_FREE(m->dist); GRAFO_D_FREE(m);
+    return;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Sube el elemento en la posicion i hasta restaurar la propiedad del monticulo
+*/
+static void _monticulo_subir(_Monticulo* m, size_t i) {
+    size_t v=m->elems[i];
+    while(i>0) {
+        size_t padre=(i-1)/2;
+        if(!(m->dist[v]<m->dist[m->elems[padre]])) break;
+        m->elems[i]=m->elems[padre];
+        m->pos[m->elems[i]]=i;
+        i=padre;
+    }
+    m->elems[i]=v;
+    m->pos[v]=i;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Asigna la distancia d al vertice v, insertandolo si no estaba en el monticulo. Solo debe
+    usarse para reducir distancias.
+*/
+static void _monticulo_actualizar(_Monticulo* m, size_t v, peso_t d) {
+    m->dist[v]=d;
+    if(m->pos[v]==GD_NO_POSICION) {
+        m->elems[m->tamano]=v;
+        m->pos[v]=m->tamano;
+        ++(m->tamano);
+    }
+    _monticulo_subir(m, m->pos[v]);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Extrae el vertice con menor distancia, el monticulo no debe estar vacio
+*/
+static size_t _monticulo_extraer(_Monticulo* m) {
+    size_t min=m->elems[0];
+    m->pos[min]=GD_NO_POSICION;
+    --(m->tamano);
+    if(m->tamano==0) return min;
+    size_t v=m->elems[m->tamano], i=0;
+    while(2*i+1<m->tamano) {
+        size_t hijo=2*i+1;
+        if(hijo+1<m->tamano && m->dist[m->elems[hijo+1]]<m->dist[m->elems[hijo]]) ++hijo;
+        if(!(m->dist[m->elems[hijo]]<m->dist[v])) break;
+        m->elems[i]=m->elems[hijo];
+        m->pos[m->elems[i]]=i;
+        i=hijo;
+    }
+    m->elems[i]=v;
+    m->pos[v]=i;
+    return min;
+}
+
+/*  !!!ESTRUCTURA DE USO INTERNO!!!
+    Estado de _gd_dijkstra_pos() que recibe la funcion que relaja las aristas de cada vertice.
+    puente[v] son los datos de la arista por la que se llego a v.
+*/
+typedef struct _dijkstra_d {
+    _Monticulo* m;
+    bool* visitado;
+    size_t* padre;
+    Arista** puente;
+    peso_t (*calc_peso)(Arista*);
+} _Dijkstra_D;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Relaja la arista ar con el peso indicado que va del vertice u al vertice v, el cual no debe
+    haberse visitado
+*/
+static inline void _gd_relajar(_Dijkstra_D* d, size_t u, size_t v, peso_t peso, Arista* ar) {
+    peso_t dp=d->m->dist[u]+peso;
+    if(dp<d->m->dist[v]) {
+        _monticulo_actualizar(d->m, v, dp);
+        d->padre[v]=u;
+        d->puente[v]=ar;
+    }
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Algoritmo de Dijkstra con un monticulo binario sobre un grafo de solo lectura de n vertices
+    identificados por su posicion, comun a las versiones, los grafos mapeados y los comprimidos.
+    relajar(datos, d, u) llama a _gd_relajar() con cada arista de salida de u que no termine en
+    un vertice visitado y vertice(datos, i) regresa los datos del vertice en la posicion i para
+    el camino. calc_peso se guarda en d para que relajar() lo use. Regresa NULL si ini o fin no
+    son posiciones validas o no hubo memoria.
+*/
+static Camino_D* _gd_dijkstra_pos(size_t n, size_t ini, size_t fin, peso_t (*calc_peso)(Arista*), const void* datos,
+    void (*relajar)(const void*, _Dijkstra_D*, size_t), Vertice* (*vertice)(const void*, size_t)) {
+    if(ini>=n || fin>=n) return NULL;
+    _Dijkstra_D d;
+    d.m=_monticulo_crear(n);
+    d.padre=(size_t*)GRAFO_D_MALLOC(sizeof(size_t)*n);
+    d.puente=(Arista**)GRAFO_D_MALLOC(sizeof(Arista*)*n);
+    d.visitado=(bool*)GRAFO_D_CALLOC(n, sizeof(bool));
+    d.calc_peso=calc_peso;
+    Camino_D* camino=NULL;
+    if(!d.m || !d.padre || !d.puente || !d.visitado) goto salir;
+
+    _monticulo_actualizar(d.m, ini, 0);
+    d.padre[ini]=GD_NO_POSICION;
+    while(d.m->tamano>0) {
+        size_t u=_monticulo_extraer(d.m);
+        d.visitado[u]=true;
+        if(u==fin) break;
+        relajar(datos, &d, u);
+    }
+
+    camino=(Camino_D*)GRAFO_D_MALLOC(sizeof(Camino_D));
+    if(!camino) goto salir;
+    camino->vts=NULL; camino->ars=NULL;
+    camino->saltos=0; camino->longitud=0;
+    //Si no existe camino regresamos un camino invalido
+    if(!d.visitado[fin]) goto salir;
+    camino->longitud=d.m->dist[fin];
+    for(size_t v=fin; v!=ini; v=d.padre[v]) ++(camino->saltos);
+    camino->vts=(Vertice**)GRAFO_D_MALLOC(sizeof(Vertice*)*(camino->saltos+1));
+    if(camino->saltos>0) camino->ars=(Arista**)GRAFO_D_MALLOC(sizeof(Arista*)*camino->saltos);
+    if(!camino->vts || (camino->saltos>0 && !camino->ars)) {
+        camino_d_destruir(camino);
+        camino=NULL;
+        goto salir;
+    }
+    size_t v=fin;
+    for(size_t i=camino->saltos; i>0; --i, v=d.padre[v]) {
+        camino->vts[i]=vertice(datos, v);
+        camino->ars[i-1]=d.puente[v];
+    }
+    camino->vts[0]=vertice(datos, ini);
+
+salir:
+    if(d.m) _monticulo_destruir(d.m);
+    GRAFO_D_FREE(d.padre); GRAFO_D_FREE(d.puente); GRAFO_D_FREE(d.visitado);
+    return camino;
+}
+
+/*----------------------------------Versiones del Grafo-----------------------------------*/
+
+/*  Una version es una copia inmutable del grafo en el momento en que se creo con
+    grafo_d_snapshot(). Las versiones pueden consultarse desde cualquier numero de hilos sin
+    ningun candado mientras el grafo original se sigue modificando, y nunca observan una
+    modificacion a medias. Cada vertice de una version se guarda en un bloque inmutable con
+    sus datos y los de sus aristas de salida; los vertices que no cambiaron desde la version
+    anterior comparten su bloque con ella, por lo que crear una version solo copia los vertices
+    modificados. Las versiones cuentan referencias y se liberan con grafo_d_version_liberar().
+    Dentro de una version los vertices se identifican por su posicion [0, orden) en el orden de
+    la lista de vertices del grafo al momento de crearla.
+*/
+
+//  !!!ESTRUCTURAS DE USO INTERNO!!!
+typedef struct _arista_ver {
+    Arista ar;
+    uintptr_t fin;
+} _Arista_Ver;
+
+typedef struct _bloque_v {
+    size_t referencias;
+    uintptr_t clave;
+    Vertice vt;
+    size_t grado_s;
+    _Arista_Ver aristas[];
+} _Bloque_V;
+
+typedef struct grafo_d_version {
+    size_t referencias;
+    size_t orden;
+    size_t tamano;
+    _Bloque_V** bloques;
+    _Indice_V* indice;
+    bool (*cmp_vt)(Vertice*, Vertice*);
+    bool (*cmp_ar)(Arista*, Arista*);
+    peso_t (*calc_peso)(Arista*);
+} Grafo_D_Version;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Libera la referencia a los primeros n bloques de un arreglo de bloques
+*/
+static void _grafo_d_liberar_bloques(_Bloque_V** bloques, size_t n) {
+    for(size_t i=0; i<n; ++i)
+        if(_GD_REF_DEC(bloques[i]->referencias)==0) GRAFO_D_FREE(bloques[i]);
+    return;
+}
+
+/*  Agrega una referencia a la version, cada referencia debe liberarse con
+    grafo_d_version_liberar()
+*/
+static inline const Grafo_D_Version* grafo_d_version_retener(const Grafo_D_Version* version) {
+    _GD_REF_INC(((Grafo_D_Version*)version)->referencias);
+    return version;
+}
+
+/*  Libera una referencia a la version, al liberar la ultima se libera su memoria y los bloques
+    que no comparta con otras versiones. Los identificadores y caminos obtenidos de la version
+    se vuelven invalidos al liberar su ultima referencia.
+*/
+static void grafo_d_version_liberar(const Grafo_D_Version* version) {
+    Grafo_D_Version* ver=(Grafo_D_Version*)version;
+    if(_GD_REF_DEC(ver->referencias)!=0) return;
+    _grafo_d_liberar_bloques(ver->bloques, ver->orden);
+    GRAFO_D_FREE(ver->bloques);
+    GRAFO_D_FREE(ver->indice);
+    GRAFO_D_FREE(ver);
+    return;
+}
+
+/*  Crea una version inmutable del estado actual del grafo y regresa una referencia a ella que
+    debe liberarse con grafo_d_version_liberar(). Los vertices que no fueron modificados desde
+    la version anterior comparten sus datos con ella, por lo que el costo es O(orden) mas el
+    tamano de los vertices modificados. Si los datos de un vertice o de sus aristas se modifican
+    directamente mediante su identificador debe llamarse a grafo_d_marcar_modificado() antes.
+    Los datos de vertices y aristas se copian, por lo que deben poder copiarse por asignacion.
+    Regresa NULL si no hubo memoria.
+*/
+static const Grafo_D_Version* grafo_d_snapshot(Grafo_D* grafo) {
+    Grafo_D_Version* ver=(Grafo_D_Version*)GRAFO_D_MALLOC(sizeof(Grafo_D_Version));
+    if(!ver) return NULL;
+    size_t n=grafo->orden ? grafo->orden : 1;
+    ver->bloques=(_Bloque_V**)GRAFO_D_MALLOC(sizeof(_Bloque_V*)*n);
+    ver->indice=(_Indice_V*)GRAFO_D_MALLOC(sizeof(_Indice_V)*n);
+    if(!ver->bloques || !ver->indice) {
+        GRAFO_D_FREE(ver->bloques); GRAFO_D_FREE(ver->indice); GRAFO_D_FREE(ver);
+        return NULL;
+    }
+    ver->orden=grafo->orden;
+    ver->tamano=grafo->tamano;
+    ver->cmp_vt=grafo->cmp_vt;
+    ver->cmp_ar=grafo->cmp_ar;
+    ver->calc_peso=grafo->calc_peso;
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig) {
+        _Bloque_V* bloque=vptr->bloque;
+        if(bloque!=NULL) _GD_REF_INC(bloque->referencias);
+        else {
+            //El vertice cambio desde la version anterior, se copia en un bloque nuevo
+            bloque=(_Bloque_V*)GRAFO_D_MALLOC(sizeof(_Bloque_V)+sizeof(_Arista_Ver)*vptr->grado_s);
+            if(!bloque) {
+                _grafo_d_liberar_bloques(ver->bloques, i);
+                GRAFO_D_FREE(ver->bloques); GRAFO_D_FREE(ver->indice); GRAFO_D_FREE(ver);
+                return NULL;
+            }
+            bloque->referencias=1;
+            bloque->clave=(uintptr_t)vptr;
+            bloque->vt=vptr->vt;
+            bloque->grado_s=vptr->grado_s;
+            Nodo_A* aptr=vptr->lista_ady;
+            for(size_t k=0; aptr!=NULL; ++k, aptr=aptr->sig) {
+                bloque->aristas[k].ar=aptr->ar;
+                bloque->aristas[k].fin=(uintptr_t)_GD_FIN(grafo, aptr);
+            }
+        }
+        ver->bloques[i]=bloque;
+        ver->indice[i].nodo=bloque->clave;
+        ver->indice[i].pos=i;
+    }
+    qsort(ver->indice, ver->orden, sizeof(_Indice_V), _cmp_indice_v);
+    //El grafo conserva una referencia a la ultima version para reutilizar sus bloques
+    vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig) vptr->bloque=ver->bloques[i];
+    ver->referencias=2;
+    if(grafo->version) grafo_d_version_liberar(grafo->version);
+    grafo->version=ver;
+    return ver;
+}
+
+/*  Regresa el numero de vertices de la version*/
+static inline size_t grafo_d_version_orden(const Grafo_D_Version* ver) {return ver->orden;}
+
+/*  Regresa el numero de aristas de la version*/
+static inline size_t grafo_d_version_tamano(const Grafo_D_Version* ver) {return ver->tamano;}
+
+/*  Regresa los datos del vertice en la posicion i de la version*/
+static inline const Vertice* grafo_d_version_vertice(const Grafo_D_Version* ver, size_t i) {
+    return &(ver->bloques[i]->vt);
+}
+
+/*  Regresa el grado de salida del vertice en la posicion i de la version*/
+static inline size_t grafo_d_version_grado(const Grafo_D_Version* ver, size_t i) {
+    return ver->bloques[i]->grado_s;
+}
+
+/*  Regresa los datos de la k-esima arista de salida del vertice en la posicion i, las aristas
+    estan en el mismo orden que en la lista de adyacencia del grafo
+*/
+static inline const Arista* grafo_d_version_arista(const Grafo_D_Version* ver, size_t i, size_t k) {
+    return &(ver->bloques[i]->aristas[k].ar);
+}
+
+/*  Regresa la posicion del vertice en el que termina la k-esima arista de salida del vertice
+    en la posicion i
+*/
+static inline size_t grafo_d_version_destino(const Grafo_D_Version* ver, size_t i, size_t k) {
+    return _grafo_d_pos_indice_v(ver->indice, ver->orden, (const Nodo_V*)ver->bloques[i]->aristas[k].fin);
+}
+
+/*  Regresa la posicion dentro de la version del vertice identificado por vt en el grafo del que
+    se creo la version, o GD_NO_POSICION si el vertice no existia al crearla. vt debe seguir
+    siendo un identificador valido en el grafo.
+*/
+static size_t grafo_d_version_posicion(const Grafo_D_Version* ver, const Vertice* vt) {
+    uintptr_t clave=(uintptr_t)_GD_NODO_V(vt);
+    size_t ini=0, fin=ver->orden;
+    while(ini<fin) {
+        size_t mitad=ini+(fin-ini)/2;
+        if(ver->indice[mitad].nodo<clave) ini=mitad+1;
+        else fin=mitad;
+    }
+    if(ini<ver->orden && ver->indice[ini].nodo==clave) return ver->indice[ini].pos;
+    return GD_NO_POSICION;
+}
+
+/*  Regresa la posicion del primer vertice de la version que haga que cmp_vt() regrese
+    verdadero, o GD_NO_POSICION si ninguno lo hace. Se usa el cmp_vt() que tenia el grafo al
+    crear la version.
+*/
+static size_t grafo_d_version_buscar_vertice(const Grafo_D_Version* ver, Vertice ref) {
+    assert(ver->cmp_vt!=NULL);
+    for(size_t i=0; i<ver->orden; ++i)
+        if(_GD_CMP_VT(ver->cmp_vt, &(ver->bloques[i]->vt), &ref)) return i;
+    return GD_NO_POSICION;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static void _grafo_d_version_relajar(const void* datos, _Dijkstra_D* d, size_t u) {
+    const Grafo_D_Version* ver=(const Grafo_D_Version*)datos;
+    _Bloque_V* bloque=ver->bloques[u];
+    for(size_t k=0; k<bloque->grado_s; ++k) {
+        size_t v=_grafo_d_pos_indice_v(ver->indice, ver->orden, (const Nodo_V*)bloque->aristas[k].fin);
+        if(d->visitado[v]) continue;
+        _gd_relajar(d, u, v, _GD_PESO(d->calc_peso, &(bloque->aristas[k].ar)), &(bloque->aristas[k].ar));
+    }
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static Vertice* _grafo_d_version_vertice(const void* datos, size_t i) {
+    return &(((const Grafo_D_Version*)datos)->bloques[i]->vt);
+}
+
+/*  Encuentra el camino mas corto entre los vertices de las posiciones ini y fin de la version
+    utilizando el algoritmo de Dijkstra con un monticulo binario y el calc_peso() que tenia el
+    grafo al crear la version. El resultado tiene la misma forma que el de grafo_d_dijkstra():
+    debe liberarse con camino_d_destruir() y es un camino invalido si fin no es alcanzable. Los
+    vertices y aristas del camino apuntan a los datos de la version, por lo que son validos
+    mientras se conserve una referencia a ella. Regresa NULL si ini o fin no son posiciones
+    validas o en caso de error.
+*/
+static Camino_D* grafo_d_version_dijkstra(const Grafo_D_Version* ver, size_t ini, size_t fin) {
+    if(!ver->calc_peso) return NULL;
+    return _gd_dijkstra_pos(ver->orden, ini, fin, ver->calc_peso, ver, _grafo_d_version_relajar, _grafo_d_version_vertice);
+}
+
+/*-----------------------------------Formato Binario------------------------------------*/
+
+/*  grafo_d_guardar_binario() escribe el grafo en un archivo binario compacto que
+    grafo_d_mapear() puede cargar sin interpretar ni copiar sus datos, de modo que el tiempo de
+    carga no depende del tamano del grafo. El archivo no contiene apuntadores, solo posiciones,
+    y tiene la forma de una matriz dispersa comprimida por filas (CSR):
+    - Cabecera con numero magico, version del formato, banderas, orden, tamano y los tamanos de
+      Vertice, Arista y peso_t con los que se escribio.
+    - indices: orden+1 enteros de 64 bits, las aristas de salida del vertice i son las que estan
+      en las posiciones [indices[i], indices[i+1]).
+    - destinos: tamano enteros de 32 bits con la posicion del vertice en el que termina cada arista.
+    - vertices: los datos de los orden vertices en el orden de la lista de vertices del grafo.
+    - aristas: los datos de las tamano aristas, las de cada vertice en el orden de su lista de
+      adyacencia.
+    - pesos: opcional, el resultado de calc_peso() para cada arista.
+    Cada seccion empieza en un multiplo de 64 bytes. Los datos se escriben tal como estan en
+    memoria, por lo que Vertice y Arista no deben contener apuntadores y el archivo solo puede
+    leerse en una arquitectura con el mismo orden de bytes y con los mismos tipos de datos, lo
+    cual se verifica al cargarlo.
+*/
+
+#define GD_BIN_VERSION 1
+#define GD_BIN_CON_PESOS 0x1u
+
+//  !!!ESTRUCTURA DE USO INTERNO!!!
+typedef struct _cabecera_bin {
+    char magia[8];
+    uint32_t version;
+    uint32_t banderas;
+    uint64_t orden;
+    uint64_t tamano;
+    uint32_t tam_vertice;
+    uint32_t tam_arista;
+    uint32_t tam_peso;
+    uint32_t orden_bytes;
+    uint64_t off_indices;
+    uint64_t off_destinos;
+    uint64_t off_vertices;
+    uint64_t off_aristas;
+    uint64_t off_pesos;
+    uint64_t bytes;
+} _Cabecera_Bin;
+
+static const char _gd_bin_magia[8]={'G','R','A','F','O','_','D','\0'};
+#define _GD_BIN_ORDEN_BYTES 0x01020304u
+#define _GD_BIN_ALINEAR(n) (((n)+63)&~(uint64_t)63)
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Calcula la posicion de cada seccion de un archivo con orden vertices y tamano aristas
+*/
+static void _grafo_d_bin_secciones(_Cabecera_Bin* cab, uint64_t orden, uint64_t tamano, bool con_pesos) {
+    memset(cab, 0, sizeof(_Cabecera_Bin));
+    memcpy(cab->magia, _gd_bin_magia, sizeof(cab->magia));
+    cab->version=GD_BIN_VERSION;
+    cab->banderas=con_pesos ? GD_BIN_CON_PESOS : 0;
+    cab->orden=orden;
+    cab->tamano=tamano;
+    cab->tam_vertice=sizeof(Vertice);
+    cab->tam_arista=sizeof(Arista);
+    cab->tam_peso=sizeof(peso_t);
+    cab->orden_bytes=_GD_BIN_ORDEN_BYTES;
+    cab->off_indices=_GD_BIN_ALINEAR(sizeof(_Cabecera_Bin));
+    cab->off_destinos=_GD_BIN_ALINEAR(cab->off_indices+sizeof(uint64_t)*(orden+1));
+    cab->off_vertices=_GD_BIN_ALINEAR(cab->off_destinos+sizeof(uint32_t)*tamano);
+    cab->off_aristas=_GD_BIN_ALINEAR(cab->off_vertices+sizeof(Vertice)*orden);
+    cab->off_pesos=_GD_BIN_ALINEAR(cab->off_aristas+sizeof(Arista)*tamano);
+    cab->bytes=con_pesos ? cab->off_pesos+sizeof(peso_t)*tamano : cab->off_pesos;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe ceros hasta que el archivo llegue a la posicion off
+*/
+static bool _grafo_d_bin_rellenar(FILE* archivo, uint64_t* escritos, uint64_t off) {
+    static const char ceros[64]={0};
+    size_t n=(size_t)(off-*escritos);
+    if(n>0 && fwrite(ceros, 1, n, archivo)!=n) return false;
+    *escritos=off;
+    return true;
+}
+
+/*  Escribe el grafo en el archivo ruta con el formato binario descrito arriba. Si con_pesos es
+    verdadero se guarda tambien el peso de cada arista calculado con el calc_peso() del grafo. El
+    grafo no puede tener mas de UINT32_MAX vertices. Regresa falso si no se pudo escribir el
+    archivo o no hubo memoria.
+*/
+static bool grafo_d_guardar_binario(const Grafo_D* grafo, const char* ruta, bool con_pesos) {
+    if(grafo->orden>UINT32_MAX || (con_pesos && !grafo->calc_peso)) return false;
+    _Cabecera_Bin cab;
+    _grafo_d_bin_secciones(&cab, grafo->orden, grafo->tamano, con_pesos);
+    _Indice_V* indice=_grafo_d_crear_indice_v(grafo);
+    if(!indice) return false;
+    FILE* archivo=fopen(ruta, "wb");
+    if(!archivo) {
+        GRAFO_D_FREE(indice);
+        return false;
+    }
+    uint64_t escritos=sizeof(_Cabecera_Bin);
+    bool ok=fwrite(&cab, sizeof(_Cabecera_Bin), 1, archivo)==1;
+
+    ok=ok && _grafo_d_bin_rellenar(archivo, &escritos, cab.off_indices);
+    uint64_t acum=0;
+    for(Nodo_V* vptr=grafo->lista_ady; ok && vptr!=NULL; vptr=vptr->sig) {
+        ok=fwrite(&acum, sizeof(uint64_t), 1, archivo)==1;
+        acum+=vptr->grado_s;
+    }
+    ok=ok && fwrite(&acum, sizeof(uint64_t), 1, archivo)==1;
+    escritos+=sizeof(uint64_t)*(cab.orden+1);
+
+    ok=ok && _grafo_d_bin_rellenar(archivo, &escritos, cab.off_destinos);
+    for(Nodo_V* vptr=grafo->lista_ady; ok && vptr!=NULL; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; ok && aptr!=NULL; aptr=aptr->sig) {
+            uint32_t destino=(uint32_t)_grafo_d_pos_indice_v(indice, grafo->orden, _GD_FIN(grafo, aptr));
+            ok=fwrite(&destino, sizeof(uint32_t), 1, archivo)==1;
+        }
+    escritos+=sizeof(uint32_t)*cab.tamano;
+
+    ok=ok && _grafo_d_bin_rellenar(archivo, &escritos, cab.off_vertices);
+    for(Nodo_V* vptr=grafo->lista_ady; ok && vptr!=NULL; vptr=vptr->sig)
+        ok=fwrite(&(vptr->vt), sizeof(Vertice), 1, archivo)==1;
+    escritos+=sizeof(Vertice)*cab.orden;
+
+    ok=ok && _grafo_d_bin_rellenar(archivo, &escritos, cab.off_aristas);
+    for(Nodo_V* vptr=grafo->lista_ady; ok && vptr!=NULL; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; ok && aptr!=NULL; aptr=aptr->sig)
+            ok=fwrite(&(aptr->ar), sizeof(Arista), 1, archivo)==1;
+    escritos+=sizeof(Arista)*cab.tamano;
+
+    ok=ok && _grafo_d_bin_rellenar(archivo, &escritos, cab.off_pesos);
+    if(con_pesos) {
+        for(Nodo_V* vptr=grafo->lista_ady; ok && vptr!=NULL; vptr=vptr->sig)
+            for(Nodo_A* aptr=vptr->lista_ady; ok && aptr!=NULL; aptr=aptr->sig) {
+                peso_t peso=_GD_PESO(grafo->calc_peso, &(aptr->ar));
+                ok=fwrite(&peso, sizeof(peso_t), 1, archivo)==1;
+            }
+    }
+    GRAFO_D_FREE(indice);
+    if(fclose(archivo)!=0) ok=false;
+    return ok;
+}
+
+/*  Grafo de solo lectura cargado con grafo_d_mapear(). Los arreglos apuntan directamente al
+    contenido del archivo, los vertices se identifican por su posicion [0, orden) y las aristas
+    por su posicion [0, tamano) en el arreglo de aristas. Se libera con grafo_d_mapa_cerrar().
+*/
+typedef struct grafo_d_mapa {
+    size_t orden;
+    size_t tamano;
+    const uint64_t* indices;
+    const uint32_t* destinos;
+    const Vertice* vertices;
+    const Arista* aristas;
+    const peso_t* pesos;        //NULL si el archivo no tiene pesos
+    void* base;
+    size_t bytes;
+    bool mapeado;
+} Grafo_D_Mapa;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Verifica que la cabecera corresponda a un archivo de bytes bytes compatible con los tipos
+    de datos con los que se compilo la libreria
+*/
+static bool _grafo_d_bin_validar(const _Cabecera_Bin* cab, size_t bytes) {
+    if(bytes<sizeof(_Cabecera_Bin)) return false;
+    if(memcmp(cab->magia, _gd_bin_magia, sizeof(cab->magia))!=0) return false;
+    if(cab->version!=GD_BIN_VERSION || cab->orden_bytes!=_GD_BIN_ORDEN_BYTES) return false;
+    if(cab->tam_vertice!=sizeof(Vertice) || cab->tam_arista!=sizeof(Arista) || cab->tam_peso!=sizeof(peso_t))
+        return false;
+    if(cab->orden>UINT32_MAX || cab->tamano>SIZE_MAX/sizeof(Arista)) return false;
+    _Cabecera_Bin esperada;
+    _grafo_d_bin_secciones(&esperada, cab->orden, cab->tamano, cab->banderas&GD_BIN_CON_PESOS);
+    if(cab->off_indices!=esperada.off_indices || cab->off_destinos!=esperada.off_destinos ||
+       cab->off_vertices!=esperada.off_vertices || cab->off_aristas!=esperada.off_aristas ||
+       cab->off_pesos!=esperada.off_pesos || cab->bytes!=esperada.bytes || cab->bytes>bytes)
+        return false;
+    const uint64_t* indices=(const uint64_t*)((const char*)cab+cab->off_indices);
+    return indices[0]==0 && indices[cab->orden]==cab->tamano;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Obtiene el contenido completo del archivo ruta y escribe su tamano en bytes. Si se definio
+    GRAFO_D_MMAP el archivo se proyecta en memoria y mapeado se vuelve verdadero, de lo contrario
+    se lee con una sola lectura. Debe liberarse con _grafo_d_soltar_archivo(). Regresa NULL si no
+    se pudo leer el archivo o no hubo memoria.
+*/
+static void* _grafo_d_abrir_archivo(const char* ruta, size_t* bytes, bool* mapeado) {
+    void* base=NULL;
+    *mapeado=false;
+#ifdef GRAFO_D_MMAP
+    int fd=open(ruta, O_RDONLY);
+    struct stat info;
+    if(fd<0) return NULL;
+    if(fstat(fd, &info)==0 && info.st_size>0) {
+        *bytes=(size_t)info.st_size;
+        base=mmap(NULL, *bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(base==MAP_FAILED) base=NULL;
+        else *mapeado=true;
+    }
+    close(fd);
+    if(*mapeado) return base;
+#endif
+    FILE* archivo=fopen(ruta, "rb");
+    long fin=-1;
+    if(!archivo) return NULL;
+    if(fseek(archivo, 0, SEEK_END)==0) fin=ftell(archivo);
+    if(fin>=0 && fseek(archivo, 0, SEEK_SET)==0) {
+        *bytes=(size_t)fin;
+        base=GRAFO_D_MALLOC(*bytes ? *bytes : 1);
+        if(base && fread(base, 1, *bytes, archivo)!=*bytes) {
+            GRAFO_D_FREE(base);
+            base=NULL;
+        }
+    }
+    fclose(archivo);
+    return base;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static void _grafo_d_soltar_archivo(void* base, size_t bytes, bool mapeado) {
+#ifdef GRAFO_D_MMAP
+    if(mapeado) {
+        munmap(base, bytes);
+        return;
+    }
+#else
+    (void)bytes; (void)mapeado;
+#endif
+    GRAFO_D_FREE(base);
+}
+
+/*  Carga un grafo guardado con grafo_d_guardar_binario() sin interpretar ni copiar su contenido.
+    Si se definio GRAFO_D_MMAP el archivo se proyecta en memoria con mmap() y las paginas se leen
+    del disco conforme se consultan, de lo contrario se lee completo con una sola lectura. Solo
+    se verifica la cabecera, el contenido de las secciones se asume correcto: si el archivo puede
+    estar danado o no es de confianza debe verificarse con grafo_d_mapa_validar() antes de
+    consultarlo, ya que un indice o destino invalido hace que las consultas lean fuera del
+    archivo. Regresa NULL si el archivo no existe, no es un grafo en formato binario, se escribio
+    con tipos de datos distintos o no hubo memoria.
+*/
+static Grafo_D_Mapa* grafo_d_mapear(const char* ruta) {
+    Grafo_D_Mapa* mapa=(Grafo_D_Mapa*)GRAFO_D_MALLOC(sizeof(Grafo_D_Mapa));
+    if(!mapa) return NULL;
+    mapa->base=_grafo_d_abrir_archivo(ruta, &(mapa->bytes), &(mapa->mapeado));
+    if(!mapa->base) {
+        GRAFO_D_FREE(mapa);
+        return NULL;
+    }
+    const _Cabecera_Bin* cab=(const _Cabecera_Bin*)mapa->base;
+    if(!_grafo_d_bin_validar(cab, mapa->bytes)) {
+        _grafo_d_soltar_archivo(mapa->base, mapa->bytes, mapa->mapeado);
+        GRAFO_D_FREE(mapa);
+        return NULL;
+    }
+    const char* base=(const char*)mapa->base;
+    mapa->orden=cab->orden;
+    mapa->tamano=cab->tamano;
+    mapa->indices=(const uint64_t*)(base+cab->off_indices);
+    mapa->destinos=(const uint32_t*)(base+cab->off_destinos);
+    mapa->vertices=(const Vertice*)(base+cab->off_vertices);
+    mapa->aristas=(const Arista*)(base+cab->off_aristas);
+    mapa->pesos=(cab->banderas&GD_BIN_CON_PESOS) ? (const peso_t*)(base+cab->off_pesos) : NULL;
+    return mapa;
+}
+
+/*  Libera el grafo cargado con grafo_d_mapear(), los datos y caminos obtenidos de el se vuelven
+    invalidos
+*/
+static void grafo_d_mapa_cerrar(Grafo_D_Mapa* mapa) {
+    _grafo_d_soltar_archivo(mapa->base, mapa->bytes, mapa->mapeado);
+    GRAFO_D_FREE(mapa);
+    return;
+}
+
+/*  Verifica el contenido de las secciones de un grafo cargado con grafo_d_mapear(): que los
+    indices no decrezcan y que cada destino sea la posicion de un vertice. Recorre todos los
+    indices y destinos, por lo que su costo es proporcional al tamano del archivo. Regresa falso
+    si el contenido no es valido.
+*/
+static bool grafo_d_mapa_validar(const Grafo_D_Mapa* mapa) {
+    for(size_t i=0; i<mapa->orden; ++i)
+        if(mapa->indices[i]>mapa->indices[i+1]) return false;
+    for(size_t a=0; a<mapa->tamano; ++a)
+        if(mapa->destinos[a]>=mapa->orden) return false;
+    return true;
+}
+
+/*  Regresa el grado de salida del vertice en la posicion i*/
+static inline size_t grafo_d_mapa_grado(const Grafo_D_Mapa* mapa, size_t i) {
+    return (size_t)(mapa->indices[i+1]-mapa->indices[i]);
+}
+
+/*  Regresa la posicion de la k-esima arista de salida del vertice en la posicion i*/
+static inline size_t grafo_d_mapa_arista(const Grafo_D_Mapa* mapa, size_t i, size_t k) {
+    return (size_t)mapa->indices[i]+k;
+}
+
+/*  Regresa la posicion del vertice en el que termina la arista en la posicion a*/
+static inline size_t grafo_d_mapa_destino(const Grafo_D_Mapa* mapa, size_t a) {
+    return mapa->destinos[a];
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static void _grafo_d_mapa_relajar(const void* datos, _Dijkstra_D* d, size_t u) {
+    const Grafo_D_Mapa* mapa=(const Grafo_D_Mapa*)datos;
+    for(size_t a=mapa->indices[u]; a<mapa->indices[u+1]; ++a) {
+        size_t v=mapa->destinos[a];
+        if(d->visitado[v]) continue;
+        Arista* ar=(Arista*)&(mapa->aristas[a]);
+        _gd_relajar(d, u, v, d->calc_peso ? _GD_PESO(d->calc_peso, ar) : mapa->pesos[a], ar);
+    }
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static Vertice* _grafo_d_mapa_vertice(const void* datos, size_t i) {
+    return (Vertice*)&(((const Grafo_D_Mapa*)datos)->vertices[i]);
+}
+
+/*  Encuentra el camino mas corto entre los vertices de las posiciones ini y fin utilizando el
+    algoritmo de Dijkstra con un monticulo binario. Si calc_peso es NULL se usan los pesos
+    guardados en el archivo, que debe tenerlos. El resultado tiene la misma forma que el de
+    grafo_d_dijkstra(): debe liberarse con camino_d_destruir() y es un camino invalido si fin no
+    es alcanzable. Los vertices y aristas del camino apuntan al contenido del archivo, son de
+    solo lectura y validos hasta cerrarlo. Regresa NULL si ini o fin no son posiciones validas
+    o en caso de error.
+*/
+static Camino_D* grafo_d_mapa_dijkstra(const Grafo_D_Mapa* mapa, size_t ini, size_t fin, peso_t (*calc_peso)(Arista*)) {
+    if(!calc_peso && !mapa->pesos) return NULL;
+    return _gd_dijkstra_pos(mapa->orden, ini, fin, calc_peso, mapa, _grafo_d_mapa_relajar, _grafo_d_mapa_vertice);
+}
+
+/*  Crea un grafo dinamico con el contenido de un grafo cargado con grafo_d_mapear(). Los vertices
+    y las aristas de cada vertice quedan en el mismo orden que en el grafo que se guardo. El grafo
+    creado no tiene funciones hash y usa las funciones por defecto. El contenido del mapa se
+    verifica con grafo_d_mapa_validar() antes de crear el grafo. Regresa NULL si el contenido no
+    es valido o no hubo memoria.
+*/
+static Grafo_D* grafo_d_desde_mapa(const Grafo_D_Mapa* mapa) {
+    if(!grafo_d_mapa_validar(mapa)) return NULL;
+    Grafo_D* grafo=grafo_d_crear();
+    Nodo_V** nodos=(Nodo_V**)GRAFO_D_MALLOC(sizeof(Nodo_V*)*(mapa->orden ? mapa->orden : 1));
+    if(!grafo || !nodos) goto error;
+    for(size_t i=0; i<mapa->orden; ++i) {
+        Vertice* vt=grafo_d_insertar_vertice(grafo, mapa->vertices[i]);
+        if(!vt) goto error;
+        nodos[i]=_GD_NODO_V(vt);
+    }
+    for(size_t i=0; i<mapa->orden; ++i) {
+        //Las aristas se enlazan por el inicio, se recorren al reves para conservar su orden
+        for(size_t a=mapa->indices[i+1]; a>mapa->indices[i]; --a) {
+            Nodo_A* nuevo=_grafo_d_reservar_arista(nodos[i]);
+            if(!nuevo) goto error;
+            nuevo->ar=mapa->aristas[a-1];
+            nuevo->fin=_GD_CLAVE_V(nodos[mapa->destinos[a-1]]);
+            _grafo_d_enlazar_arista(grafo, nodos[i], nuevo);
+        }
+    }
+    GRAFO_D_FREE(nodos);
+    return grafo;
+
+error:
+    GRAFO_D_FREE(nodos);
+    if(grafo) grafo_d_destruir(grafo);
+    return NULL;
+}
+
+/*----------------------------------Grafo Comprimido-------------------------------------*/
+
+/*  grafo_d_comprimir() crea una copia de solo lectura del grafo en la que las listas de
+    adyacencia ocupan en promedio entre uno y dos bytes por arista en lugar de un Nodo_A. Los
+    vertices se identifican por su posicion [0, orden) en el orden de la lista de vertices del
+    grafo y las aristas por su posicion [0, tamano). Las aristas de cada vertice se ordenan por
+    la posicion de su destino y los destinos se guardan como diferencias codificadas en enteros
+    de longitud variable (7 bits por byte, el bit alto indica que el numero continua):
+    - Por cada vertice: su grado, la diferencia entre el primer destino y la posicion del
+      vertice (con signo, codificada en zigzag) y la diferencia de cada destino con el anterior.
+    - Cada GD_COMP_BLOQUE vertices se guarda la posicion del bloque dentro de los datos
+      comprimidos y la de su primer arista, por lo que localizar un vertice decodifica a lo mas
+      GD_COMP_BLOQUE-1 vertices anteriores.
+    Los datos de vertices y aristas (y opcionalmente los pesos) se guardan sin comprimir en
+    arreglos contiguos, las aristas en el orden de sus destinos. La compresion es mejor entre
+    mas cercanas sean las posiciones de los vecinos de cada vertice.
+*/
+
+#define GD_COMP_BLOQUE 16
+
+//  !!!ESTRUCTURA DE USO INTERNO!!!
+typedef struct _bloque_c {
+    uint64_t desp;
+    uint64_t arista;
+} _Bloque_C;
+
+/*  Grafo de solo lectura creado con grafo_d_comprimir(), se libera con
+    grafo_d_comprimido_destruir()
+*/
+typedef struct grafo_d_comprimido {
+    size_t orden;
+    size_t tamano;
+    Vertice* vertices;
+    Arista* aristas;
+    peso_t* pesos;              //NULL si se comprimio sin pesos
+    _Bloque_C* bloques;
+    uint8_t* datos;
+    size_t bytes;               //Tamano de datos
+} Grafo_D_Comprimido;
+
+/*  Iterador sobre las aristas de salida de un vertice de un grafo comprimido. Despues de cada
+    llamada exitosa a iter_c_siguiente(), destino es la posicion del vertice en el que termina
+    la arista y arista es la posicion de la arista.
+*/
+typedef struct iter_c {
+    const uint8_t* p;
+    size_t restantes;
+    size_t origen;
+    size_t destino;
+    size_t arista;
+    bool primera;
+} Iter_C;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Decodifica un entero de longitud variable y avanza p al siguiente
+*/
+static inline uint64_t _gd_leer_varint(const uint8_t** p) {
+    const uint8_t* q=*p;
+    uint64_t v=*q++;
+    //La mayoria de las diferencias caben en un byte
+    if(v&0x80) {
+        v&=0x7f;
+        unsigned desp=7;
+        uint8_t b;
+        do {
+            b=*q++;
+            v|=(uint64_t)(b&0x7f)<<desp;
+            desp+=7;
+        } while(b&0x80);
+    }
+    *p=q;
+    return v;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe v como entero de longitud variable en buf y regresa el numero de bytes escritos
+*/
+static inline size_t _gd_escribir_varint(uint8_t* buf, uint64_t v) {
+    size_t n=0;
+    while(v>=0x80) {
+        buf[n++]=(uint8_t)(v|0x80);
+        v>>=7;
+    }
+    buf[n++]=(uint8_t)v;
+    return n;
+}
+
+//  !!!ESTRUCTURA DE USO INTERNO!!!
+typedef struct _arista_c {
+    size_t destino;
+    size_t k;
+    Nodo_A* nodo;
+} _Arista_C;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Ordena las aristas de un vertice por destino conservando el orden de la lista entre las que
+    tienen el mismo destino
+*/
+static int _cmp_arista_c(const void* a, const void* b) {
+    const _Arista_C* x=(const _Arista_C*)a, *y=(const _Arista_C*)b;
+    if(x->destino!=y->destino) return (x->destino>y->destino)-(x->destino<y->destino);
+    return (x->k>y->k)-(x->k<y->k);
+}
+
+/*  Libera un grafo creado con grafo_d_comprimir(), los datos y caminos obtenidos de el se
+    vuelven invalidos
+*/
+static void grafo_d_comprimido_destruir(Grafo_D_Comprimido* comp) {
+    GRAFO_D_FREE(comp->vertices); GRAFO_D_FREE(comp->aristas); GRAFO_D_FREE(comp->pesos);
+    GRAFO_D_FREE(comp->bloques); GRAFO_D_FREE(comp->datos);
+    GRAFO_D_FREE(comp);
+    return;
+}
+
+/*  Crea una copia comprimida de solo lectura del grafo con el formato descrito arriba. Si
+    con_pesos es verdadero se guarda tambien el peso de cada arista calculado con el calc_peso()
+    del grafo. Los datos de vertices y aristas se copian por asignacion. El grafo comprimido no
+    depende del grafo original, que puede modificarse o destruirse. Regresa NULL si no hubo
+    memoria.
+*/
+static Grafo_D_Comprimido* grafo_d_comprimir(const Grafo_D* grafo, bool con_pesos) {
+    if(con_pesos && !grafo->calc_peso) return NULL;
+    Grafo_D_Comprimido* comp=(Grafo_D_Comprimido*)GRAFO_D_CALLOC(1, sizeof(Grafo_D_Comprimido));
+    if(!comp) return NULL;
+    comp->orden=grafo->orden;
+    comp->tamano=grafo->tamano;
+    size_t num_bloques=(grafo->orden+GD_COMP_BLOQUE-1)/GD_COMP_BLOQUE;
+    size_t max_grado=1;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr!=NULL; vptr=vptr->sig)
+        if(vptr->grado_s>max_grado) max_grado=vptr->grado_s;
+    //Se reservan dos bytes por arista y se crece si hace falta
+    size_t capacidad=2*grafo->tamano+10*grafo->orden+16;
+    _Indice_V* indice=_grafo_d_crear_indice_v(grafo);
+    _Arista_C* orden_ar=(_Arista_C*)GRAFO_D_MALLOC(sizeof(_Arista_C)*max_grado);
+    comp->vertices=(Vertice*)GRAFO_D_MALLOC(sizeof(Vertice)*(grafo->orden ? grafo->orden : 1));
+    comp->aristas=(Arista*)GRAFO_D_MALLOC(sizeof(Arista)*(grafo->tamano ? grafo->tamano : 1));
+    if(con_pesos) comp->pesos=(peso_t*)GRAFO_D_MALLOC(sizeof(peso_t)*(grafo->tamano ? grafo->tamano : 1));
+    comp->bloques=(_Bloque_C*)GRAFO_D_MALLOC(sizeof(_Bloque_C)*(num_bloques ? num_bloques : 1));
+    comp->datos=(uint8_t*)GRAFO_D_MALLOC(capacidad);
+    if(!indice || !orden_ar || !comp->vertices || !comp->aristas || (con_pesos && !comp->pesos)
+        || !comp->bloques || !comp->datos) goto error;
+
+    size_t a=0;
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig) {
+        if(i%GD_COMP_BLOQUE==0) {
+            comp->bloques[i/GD_COMP_BLOQUE].desp=comp->bytes;
+            comp->bloques[i/GD_COMP_BLOQUE].arista=a;
+        }
+        //Cada arista ocupa a lo mas 10 bytes
+        if(comp->bytes+10*(vptr->grado_s+2)>capacidad) {
+            size_t nueva=2*capacidad+10*(vptr->grado_s+2);
+            uint8_t* tmp=(uint8_t*)GRAFO_D_REALLOC(comp->datos, nueva);
+            if(!tmp) goto error;
+            comp->datos=tmp;
+            capacidad=nueva;
+        }
+        comp->vertices[i]=vptr->vt;
+        size_t k=0;
+        for(Nodo_A* aptr=vptr->lista_ady; aptr!=NULL; ++k, aptr=aptr->sig) {
+            orden_ar[k].destino=_grafo_d_pos_indice_v(indice, grafo->orden, _GD_FIN(grafo, aptr));
+            orden_ar[k].k=k;
+            orden_ar[k].nodo=aptr;
+        }
+        qsort(orden_ar, k, sizeof(_Arista_C), _cmp_arista_c);
+        comp->bytes+=_gd_escribir_varint(comp->datos+comp->bytes, k);
+        for(size_t j=0; j<k; ++j, ++a) {
+            uint64_t dif;
+            if(j==0) {
+                int64_t d=(int64_t)orden_ar[0].destino-(int64_t)i;
+                dif=((uint64_t)d<<1)^(uint64_t)(d>>63);
+            }
+            else dif=orden_ar[j].destino-orden_ar[j-1].destino;
+            comp->bytes+=_gd_escribir_varint(comp->datos+comp->bytes, dif);
+            comp->aristas[a]=orden_ar[j].nodo->ar;
+            if(con_pesos) comp->pesos[a]=_GD_PESO(grafo->calc_peso, &(orden_ar[j].nodo->ar));
+        }
+    }
+    GRAFO_D_FREE(indice);
+    GRAFO_D_FREE(orden_ar);
+    uint8_t* tmp=(uint8_t*)GRAFO_D_REALLOC(comp->datos, comp->bytes ? comp->bytes : 1);
+    if(tmp) comp->datos=tmp;
+    return comp;
+
+error:
+    GRAFO_D_FREE(indice);
+    GRAFO_D_FREE(orden_ar);
+    grafo_d_comprimido_destruir(comp);
+    return NULL;
+}
+
+/*  Regresa el numero de vertices del grafo comprimido*/
+static inline size_t grafo_d_comprimido_orden(const Grafo_D_Comprimido* comp) {return comp->orden;}
+
+/*  Regresa el numero de aristas del grafo comprimido*/
+static inline size_t grafo_d_comprimido_tamano(const Grafo_D_Comprimido* comp) {return comp->tamano;}
+
+/*  Regresa los datos del vertice en la posicion i*/
+static inline const Vertice* grafo_d_comprimido_vertice(const Grafo_D_Comprimido* comp, size_t i) {
+    return &(comp->vertices[i]);
+}
+
+/*  Regresa los datos de la arista en la posicion a*/
+static inline const Arista* grafo_d_comprimido_arista(const Grafo_D_Comprimido* comp, size_t a) {
+    return &(comp->aristas[a]);
+}
+
+/*  Regresa un iterador sobre las aristas de salida del vertice en la posicion i, en orden
+    creciente de la posicion de su destino. Ejemplo:
+    Iter_C it=grafo_d_comprimido_vecinos(comp, i);
+    while(iter_c_siguiente(&it)) procesar(it.destino, grafo_d_comprimido_arista(comp, it.arista));
+*/
+static Iter_C grafo_d_comprimido_vecinos(const Grafo_D_Comprimido* comp, size_t i) {
+    const _Bloque_C* bloque=&(comp->bloques[i/GD_COMP_BLOQUE]);
+    const uint8_t* p=comp->datos+bloque->desp;
+    size_t arista=bloque->arista;
+    //Se saltan los vertices anteriores del bloque
+    for(size_t j=i-i%GD_COMP_BLOQUE; j<i; ++j) {
+        size_t grado=(size_t)_gd_leer_varint(&p);
+        arista+=grado;
+        for(size_t k=0; k<grado; ++k) while(*p++&0x80);
+    }
+    Iter_C it;
+    it.restantes=(size_t)_gd_leer_varint(&p);
+    it.p=p;
+    it.origen=i;
+    it.destino=GD_NO_POSICION;
+    it.arista=arista;
+    it.primera=true;
+    return it;
+}
+
+/*  Avanza el iterador a la siguiente arista, regresa falso si ya no hay mas*/
+static inline bool iter_c_siguiente(Iter_C* it) {
+    if(it->restantes==0) return false;
+    uint64_t dif=_gd_leer_varint(&(it->p));
+    if(it->primera) {
+        it->destino=(size_t)((int64_t)it->origen+(int64_t)((dif>>1)^(~(dif&1)+1)));
+        it->primera=false;
+    }
+    else {
+        it->destino+=(size_t)dif;
+        ++(it->arista);
+    }
+    --(it->restantes);
+    return true;
+}
+
+/*  Regresa el grado de salida del vertice en la posicion i*/
+static inline size_t grafo_d_comprimido_grado(const Grafo_D_Comprimido* comp, size_t i) {
+    return grafo_d_comprimido_vecinos(comp, i).restantes;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static void _grafo_d_comprimido_relajar(const void* datos, _Dijkstra_D* d, size_t u) {
+    const Grafo_D_Comprimido* comp=(const Grafo_D_Comprimido*)datos;
+    Iter_C it=grafo_d_comprimido_vecinos(comp, u);
+    while(iter_c_siguiente(&it)) {
+        if(d->visitado[it.destino]) continue;
+        Arista* ar=&(comp->aristas[it.arista]);
+        _gd_relajar(d, u, it.destino, d->calc_peso ? _GD_PESO(d->calc_peso, ar) : comp->pesos[it.arista], ar);
+    }
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static Vertice* _grafo_d_comprimido_vertice(const void* datos, size_t i) {
+    return &(((const Grafo_D_Comprimido*)datos)->vertices[i]);
+}
+
+/*  Encuentra el camino mas corto entre los vertices de las posiciones ini y fin utilizando el
+    algoritmo de Dijkstra con un monticulo binario, decodificando las listas de adyacencia
+    conforme se visitan. Si calc_peso es NULL se usan los pesos guardados al comprimir, que debe
+    tenerlos. El resultado tiene la misma forma que el de grafo_d_dijkstra(): debe liberarse con
+    camino_d_destruir() y es un camino invalido si fin no es alcanzable. Los vertices y aristas
+    del camino apuntan a los datos del grafo comprimido y son validos hasta destruirlo. Regresa
+    NULL si ini o fin no son posiciones validas o en caso de error.
+*/
+static Camino_D* grafo_d_comprimido_dijkstra(const Grafo_D_Comprimido* comp, size_t ini, size_t fin, peso_t (*calc_peso)(Arista*)) {
+    if(!calc_peso && !comp->pesos) return NULL;
+    return _gd_dijkstra_pos(comp->orden, ini, fin, calc_peso, comp, _grafo_d_comprimido_relajar, _grafo_d_comprimido_vertice);
+}
+
+/*------------------------------Carga de Archivos de Texto--------------------------------*/
+
+/*  grafo_d_cargar_texto() agrega al grafo los vertices y aristas de un archivo de texto en uno
+    de los formatos siguientes:
+    - GD_TEXTO_DIMACS: formato .gr de los retos de caminos mas cortos de DIMACS. Las lineas
+      "c ..." son comentarios, la linea "p sp n m" indica el numero de vertices n, que se
+      identifican de 1 a n, y cada linea "a u v w" es una arista de u a v con peso w.
+    - GD_TEXTO_LISTA: lista de aristas con una arista por linea "u,v[,campos...]" donde u y v son
+      identificadores enteros no negativos de los vertices. Los campos pueden separarse con
+      comas, punto y coma, tabuladores o espacios. Las lineas que empiezan con '#' o '%' y las
+      que no empiezan con dos enteros (como una fila de encabezados) se ignoran.
+    Las funciones del usuario convierten el texto en datos:
+    - leer_vt(id, vt) escribe en vt los datos del vertice con el identificador id. Si es NULL
+      se usa (Vertice)id, lo cual no es posible si se definio STRUCT_VERTICE.
+    - leer_ar(campos, largos, n, ar) escribe en ar los datos de una arista a partir de los n
+      campos de la linea que siguen a u y v (en DIMACS el peso). Los campos no terminan en '\0',
+      largos[i] indica la longitud de campos[i]. Si es NULL se convierte el primer campo a
+      numero, o se usa 0 si no hay campos, lo cual no es posible si se definio STRUCT_ARISTA.
+    Ambas regresan falso si el texto no es valido.
+*/
+
+#define GD_TEXTO_DIMACS 0
+#define GD_TEXTO_LISTA 1
+#define GD_TEXTO_MAX_CAMPOS 16
+
+#if defined(GRAFO_D_HILOS) && (defined(__GNUC__) || defined(__clang__))
+#define _GD_CARGA_PAR
+#endif
+
+//  !!!ESTRUCTURAS DE USO INTERNO!!!
+typedef struct _arista_txt {
+    size_t ini;
+    size_t fin;
+    Arista ar;
+} _Arista_Txt;
+
+typedef struct _tarea_texto {
+    const char* ini;
+    const char* fin;
+    int formato;
+    bool (*leer_ar)(const char**, const size_t*, size_t, Arista*);
+    _Arista_Txt* aristas;
+    size_t tamano;
+    size_t capacidad;
+    size_t max_id;
+    size_t orden_p;
+    //Enlace en paralelo: la tarea enlaza las aristas de todas las tareas que empiezan en un
+    //vertice con identificador en [id_ini, id_fin)
+    const struct _tarea_texto* tareas;
+    unsigned num_tareas;
+    size_t id_ini;
+    size_t id_fin;
+    size_t enlazadas;
+    Nodo_V** nodos;
+    bool error;
+} _Tarea_Texto;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Convierte el texto [p, p+largo) en un entero no negativo, regresa falso si no lo es
+*/
+static inline bool _gd_leer_natural(const char* p, size_t largo, size_t* val) {
+    if(largo==0) return false;
+    size_t res=0;
+    for(size_t i=0; i<largo; ++i) {
+        if(p[i]<'0' || p[i]>'9' || res>(SIZE_MAX-9)/10) return false;
+        res=res*10+(size_t)(p[i]-'0');
+    }
+    *val=res;
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Convierte el texto [p, p+largo) en un numero real, regresa falso si no lo es
+*/
+static bool _gd_leer_real(const char* p, size_t largo, double* val) {
+    char buf[64];
+    if(largo==0 || largo>=sizeof(buf)) return false;
+    memcpy(buf, p, largo);
+    buf[largo]='\0';
+    char* fin;
+    *val=strtod(buf, &fin);
+    return *fin=='\0';
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Lector de aristas por defecto: convierte el primer campo a numero
+*/
+static bool _grafo_d_leer_ar_default(const char** campos, const size_t* largos, size_t n, Arista* ar) {
+#ifdef STRUCT_ARISTA
+    (void)campos; (void)largos; (void)n; (void)ar;
+    return false;
+#else
+    double val=0;
+    if(n>0 && !_gd_leer_real(campos[0], largos[0], &val)) return false;
+    *ar=(Arista)val;
+    return true;
+#endif
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Separa la linea [p, fin) en campos, regresa el numero de campos encontrados
+*/
+static size_t _gd_separar_campos(const char* p, const char* fin, const char** campos, size_t* largos) {
+    size_t n=0;
+    while(p<fin && n<GD_TEXTO_MAX_CAMPOS) {
+        while(p<fin && (*p==' ' || *p=='\t' || *p==',' || *p==';' || *p=='\r')) ++p;
+        if(p==fin) break;
+        const char* campo=p;
+        while(p<fin && *p!=' ' && *p!='\t' && *p!=',' && *p!=';' && *p!='\r') ++p;
+        campos[n]=campo;
+        largos[n]=(size_t)(p-campo);
+        ++n;
+    }
+    return n;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Interpreta las lineas del fragmento de texto de una tarea y acumula sus aristas
+*/
+static void* _grafo_d_hilo_texto(void* arg) {
+    _Tarea_Texto* tarea=(_Tarea_Texto*)arg;
+    const char* campos[GD_TEXTO_MAX_CAMPOS];
+    size_t largos[GD_TEXTO_MAX_CAMPOS];
+    const char* p=tarea->ini;
+    while(p<tarea->fin && !tarea->error) {
+        const char* fin=(const char*)memchr(p, '\n', (size_t)(tarea->fin-p));
+        if(!fin) fin=tarea->fin;
+        size_t n=_gd_separar_campos(p, fin, campos, largos);
+        p=fin+1;
+        if(n==0) continue;
+        size_t u, v, k=0;
+        if(tarea->formato==GD_TEXTO_DIMACS) {
+            if(largos[0]!=1) continue;
+            if(campos[0][0]=='p') {
+                if(n<4 || !_gd_leer_natural(campos[2], largos[2], &(tarea->orden_p))) tarea->error=true;
+                continue;
+            }
+            if(campos[0][0]!='a') continue;
+            if(n<3 || !_gd_leer_natural(campos[1], largos[1], &u) || !_gd_leer_natural(campos[2], largos[2], &v)) {
+                tarea->error=true;
+                continue;
+            }
+            k=3;
+        }
+        else {
+            if(campos[0][0]=='#' || campos[0][0]=='%') continue;
+            if(n<2 || !_gd_leer_natural(campos[0], largos[0], &u) || !_gd_leer_natural(campos[1], largos[1], &v))
+                continue;
+            k=2;
+        }
+        if(tarea->tamano==tarea->capacidad) {
+            size_t capacidad=tarea->capacidad ? tarea->capacidad*2 : 1024;
+            _Arista_Txt* aristas=(_Arista_Txt*)GRAFO_D_REALLOC(tarea->aristas, sizeof(_Arista_Txt)*capacidad);
+            if(!aristas) {tarea->error=true; continue;}
+            tarea->aristas=aristas;
+            tarea->capacidad=capacidad;
+        }
+        _Arista_Txt* nueva=&(tarea->aristas[tarea->tamano]);
+        if(!tarea->leer_ar(campos+k, largos+k, n-k, &(nueva->ar))) {
+            tarea->error=true;
+            continue;
+        }
+        nueva->ini=u;
+        nueva->fin=v;
+        if(u>tarea->max_id) tarea->max_id=u;
+        if(v>tarea->max_id) tarea->max_id=v;
+        ++(tarea->tamano);
+    }
+    return NULL;
+}
+
+#ifdef _GD_CARGA_PAR
+/*  !!!FUNCION DE USO INTERNO!!!
+    Enlaza las aristas de todas las tareas cuyo vertice de inicio pertenece a la tarea. Cada
+    tarea es duena de un rango distinto de vertices, por lo que sus listas se modifican sin
+    operaciones atomicas, y las aristas se recorren en el orden del archivo como con un hilo.
+*/
+static void* _grafo_d_hilo_enlazar(void* arg) {
+    _Tarea_Texto* tarea=(_Tarea_Texto*)arg;
+    for(unsigned t=0; t<tarea->num_tareas && !tarea->error; ++t)
+        for(size_t i=0; i<tarea->tareas[t].tamano; ++i) {
+            const _Arista_Txt* a=&(tarea->tareas[t].aristas[i]);
+            if(a->ini<tarea->id_ini || a->ini>=tarea->id_fin) continue;
+            Nodo_A* nuevo=_grafo_d_reservar_arista(tarea->nodos[a->ini]);
+            if(!nuevo) {tarea->error=true; break;}
+            nuevo->ar=a->ar;
+            nuevo->fin=_GD_CLAVE_V(tarea->nodos[a->fin]);
+            _grafo_d_enlazar_en_vertice(tarea->nodos[a->ini], nuevo);
+            ++(tarea->enlazadas);
+        }
+    return NULL;
+}
+
+#endif
+
+/*  Agrega al grafo los vertices y aristas del archivo de texto ruta en el formato indicado (ver
+    arriba). Se agrega un vertice por cada identificador de 1 a n en DIMACS y por cada
+    identificador que aparezca en alguna arista en una lista de aristas, en orden creciente de
+    identificador; los identificadores se usan como posiciones de un arreglo, por lo que deben ser
+    densos. Si se definio GRAFO_D_HILOS el archivo se divide en fragmentos que se interpretan en
+    paralelo con el numero de hilos indicado (0 usa un hilo por nucleo disponible), por lo que
+    leer_ar() debe poder llamarse desde varios hilos a la vez, y las aristas se enlazan tambien en
+    paralelo, cada hilo las de un rango distinto de vertices de inicio. Las listas de adyacencia
+    quedan en el mismo orden con cualquier numero de hilos: las aristas de cada vertice en orden
+    inverso al del archivo. El archivo se lee con mmap() si se definio GRAFO_D_MMAP.
+    Regresa falso si el archivo no se pudo leer, tiene una linea invalida, un identificador fuera
+    de rango, leer_vt() fallo o no hubo memoria. Si el error ocurre al interpretar el archivo o
+    los vertices el grafo no se modifica; si no hubo memoria al crear los vertices o aristas el
+    grafo puede quedar con parte de ellos.
+*/
+static bool grafo_d_cargar_texto(Grafo_D* grafo, const char* ruta, int formato,
+    bool (*leer_vt)(size_t, Vertice*), bool (*leer_ar)(const char**, const size_t*, size_t, Arista*),
+    unsigned hilos) {
+#ifdef STRUCT_VERTICE
+    assert(leer_vt!=NULL);
+#endif
+#ifdef STRUCT_ARISTA
+    assert(leer_ar!=NULL);
+#endif
+    size_t bytes;
+    bool mapeado;
+    char* texto=(char*)_grafo_d_abrir_archivo(ruta, &bytes, &mapeado);
+    if(!texto) return false;
+#ifdef _GD_CARGA_PAR
+    hilos=_grafo_d_num_hilos(hilos);
+    //Fragmentos de menos de 64KB no compensan el costo de crear un hilo
+    if(hilos>bytes/65536+1) hilos=(unsigned)(bytes/65536+1);
+#else
+    hilos=1;
+#endif
+    _Tarea_Texto* tareas=(_Tarea_Texto*)GRAFO_D_CALLOC(hilos, sizeof(_Tarea_Texto));
+    Nodo_V** nodos=NULL;
+    Vertice* datos_vt=NULL;
+    bool ok=false;
+    if(!tareas) goto salir;
+
+    //Cada fragmento termina despues de un salto de linea
+    const char* pos=texto;
+    for(unsigned t=0; t<hilos; ++t) {
+        const char* fin=(t==hilos-1) ? texto+bytes : texto+bytes/hilos*(t+1);
+        if(fin<pos) fin=pos;
+        while(fin<texto+bytes && fin>texto && fin[-1]!='\n') ++fin;
+        tareas[t].ini=pos;
+        tareas[t].fin=fin;
+        tareas[t].formato=formato;
+        tareas[t].leer_ar=leer_ar ? leer_ar : _grafo_d_leer_ar_default;
+        tareas[t].orden_p=SIZE_MAX;
+        pos=fin;
+    }
+#ifdef _GD_CARGA_PAR
+    _grafo_d_lanzar_hilos(tareas, sizeof(_Tarea_Texto), hilos, _grafo_d_hilo_texto);
+#else
+    _grafo_d_hilo_texto(&tareas[0]);
+#endif
+
+    size_t max_id=0, orden_p=SIZE_MAX;
+    for(unsigned t=0; t<hilos; ++t) {
+        if(tareas[t].error) goto salir;
+        if(tareas[t].max_id>max_id) max_id=tareas[t].max_id;
+        if(tareas[t].orden_p!=SIZE_MAX) orden_p=tareas[t].orden_p;
+    }
+    if(formato==GD_TEXTO_DIMACS) {
+        if(orden_p==SIZE_MAX || max_id>orden_p) goto salir;
+        for(unsigned t=0; t<hilos; ++t)
+            for(size_t i=0; i<tareas[t].tamano; ++i)
+                if(tareas[t].aristas[i].ini==0 || tareas[t].aristas[i].fin==0) goto salir;
+        max_id=orden_p;
+    }
+    if(max_id==SIZE_MAX) goto salir;
+    nodos=(Nodo_V**)GRAFO_D_CALLOC(max_id+1, sizeof(Nodo_V*));
+    if(!nodos) goto salir;
+
+    //Se marcan los identificadores usados antes de crear los vertices en orden
+    if(formato==GD_TEXTO_DIMACS) {
+        for(size_t id=1; id<=max_id; ++id) nodos[id]=(Nodo_V*)nodos;
+    }
+    else {
+        for(unsigned t=0; t<hilos; ++t)
+            for(size_t i=0; i<tareas[t].tamano; ++i) {
+                nodos[tareas[t].aristas[i].ini]=(Nodo_V*)nodos;
+                nodos[tareas[t].aristas[i].fin]=(Nodo_V*)nodos;
+            }
+    }
+    //Todos los vertices se convierten antes de insertar el primero, por si leer_vt() falla
+    size_t num_vts=0;
+    for(size_t id=0; id<=max_id; ++id) num_vts+=(nodos[id]!=NULL);
+    datos_vt=(Vertice*)GRAFO_D_MALLOC(sizeof(Vertice)*(num_vts ? num_vts : 1));
+    if(!datos_vt) goto salir;
+    for(size_t id=0, k=0; id<=max_id; ++id) {
+        if(nodos[id]==NULL) continue;
+        if(leer_vt) {
+            if(!leer_vt(id, &(datos_vt[k]))) goto salir;
+        }
+#ifndef STRUCT_VERTICE
+        else datos_vt[k]=(Vertice)id;
+#endif
+        ++k;
+    }
+    for(size_t id=0, k=0; id<=max_id; ++id) {
+        if(nodos[id]==NULL) continue;
+        Vertice* nuevo=grafo_d_insertar_vertice(grafo, datos_vt[k++]);
+        if(!nuevo) goto salir;
+        nodos[id]=_GD_NODO_V(nuevo);
+    }
+
+    ok=true;
+#ifdef _GD_CARGA_PAR
+    //Cada hilo enlaza las aristas de un rango distinto de identificadores de inicio
+    size_t rango=max_id/hilos+1;
+    for(unsigned t=0; t<hilos; ++t) {
+        tareas[t].tareas=tareas;
+        tareas[t].num_tareas=hilos;
+        tareas[t].id_ini=rango*t;
+        tareas[t].id_fin=(t==hilos-1) ? SIZE_MAX : rango*(t+1);
+        tareas[t].nodos=nodos;
+    }
+    _grafo_d_lanzar_hilos(tareas, sizeof(_Tarea_Texto), hilos, _grafo_d_hilo_enlazar);
+    for(unsigned t=0; t<hilos; ++t) {
+        grafo->tamano+=tareas[t].enlazadas;
+        if(tareas[t].error) ok=false;
+    }
+#else
+    for(size_t i=0; i<tareas[0].tamano; ++i) {
+        Nodo_A* nuevo=_grafo_d_reservar_arista(nodos[tareas[0].aristas[i].ini]);
+        if(!nuevo) {ok=false; break;}
+        nuevo->ar=tareas[0].aristas[i].ar;
+        nuevo->fin=_GD_CLAVE_V(nodos[tareas[0].aristas[i].fin]);
+        _grafo_d_enlazar_arista(grafo, nodos[tareas[0].aristas[i].ini], nuevo);
+    }
+#endif
+    //Las aristas no se agregaron al indice de aristas ni al diario, aunque falten algunas
+    if(grafo->indice_ar && !grafo_d_set_hash_ar(grafo, grafo->hash_ar)) ok=false;
+    if(grafo->diario && !_grafo_d_diario_checkpoint(grafo)) ok=false;
+
+salir:
+    if(tareas) for(unsigned t=0; t<hilos; ++t) GRAFO_D_FREE(tareas[t].aristas);
+    GRAFO_D_FREE(tareas); GRAFO_D_FREE(nodos); GRAFO_D_FREE(datos_vt);
+    _grafo_d_soltar_archivo(texto, bytes, mapeado);
+    return ok;
+}
+
+/*------------------------------Escritura con Bufer------------------------------------*/
+
+/*  !!!ESTRUCTURA DE USO INTERNO!!!
+    Escritor que acumula texto en un bufer y solo llama a fwrite() cuando se llena, de modo que
+    escribir un numero no requiere una llamada a printf(). Si ocurre un error de escritura se
+    marca error y las escrituras siguientes se ignoran.
+*/
+typedef struct _escritor {
+    FILE* archivo;
+    char* buf;
+    size_t capacidad;
+    size_t usado;
+    bool error;
+} _Escritor;
+
+/*  Tamano del bufer que usan las funciones que escriben archivos de texto*/
+#define GD_TAM_BUFER_ES 65536
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static void _escritor_vaciar(_Escritor* e) {
+    if(e->usado>0 && !e->error && fwrite(e->buf, 1, e->usado, e->archivo)!=e->usado) e->error=true;
+    e->usado=0;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static void _escritor_bytes(_Escritor* e, const char* p, size_t n) {
+    if(e->usado+n>e->capacidad) {
+        _escritor_vaciar(e);
+        if(n>e->capacidad) {
+            if(!e->error && fwrite(p, 1, n, e->archivo)!=n) e->error=true;
+            return;
+        }
+    }
+    memcpy(e->buf+e->usado, p, n);
+    e->usado+=n;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static inline void _escritor_char(_Escritor* e, char c) {
+    if(e->usado==e->capacidad) _escritor_vaciar(e);
+    e->buf[e->usado++]=c;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static inline void _escritor_cadena(_Escritor* e, const char* cad) {
+    _escritor_bytes(e, cad, strlen(cad));
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe un entero sin signo en base 10 sin pasar por printf()
+*/
+static void _escritor_natural(_Escritor* e, uint64_t val) {
+    char tmp[20];
+    size_t n=0;
+    do {
+        tmp[n++]=(char)('0'+val%10);
+        val/=10;
+    } while(val>0);
+    if(e->usado+n>e->capacidad) _escritor_vaciar(e);
+    while(n>0) e->buf[e->usado++]=tmp[--n];
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static void _escritor_entero(_Escritor* e, int64_t val) {
+    if(val<0) {
+        _escritor_char(e, '-');
+        _escritor_natural(e, (uint64_t)0-(uint64_t)val);
+    }
+    else _escritor_natural(e, (uint64_t)val);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe un real con suficientes digitos para recuperarlo exactamente al leerlo
+*/
+static void _escritor_real(_Escritor* e, double val) {
+    char tmp[32];
+    int n=snprintf(tmp, sizeof(tmp), "%.17g", val);
+    _escritor_bytes(e, tmp, (size_t)n);
+}
+
+/*  Verdadero si peso_t es un tipo entero, y si es un tipo con signo*/
+#define _GD_PESO_ENTERO ((peso_t)0.5==(peso_t)0)
+#define _GD_PESO_SIGNO ((peso_t)-1<(peso_t)0)
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static void _escritor_peso(_Escritor* e, peso_t peso) {
+    if(!_GD_PESO_ENTERO) _escritor_real(e, (double)peso);
+    else if(_GD_PESO_SIGNO) _escritor_entero(e, (int64_t)peso);
+    else _escritor_natural(e, (uint64_t)peso);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Abre el archivo ruta para escritura con un bufer de GD_TAM_BUFER_ES bytes
+*/
+static bool _escritor_abrir(_Escritor* e, const char* ruta) {
+    e->usado=0;
+    e->error=false;
+    e->capacidad=GD_TAM_BUFER_ES;
+    e->buf=(char*)GRAFO_D_MALLOC(e->capacidad);
+    if(!e->buf) return false;
+    e->archivo=fopen(ruta, "wb");
+    if(!e->archivo) {
+        GRAFO_D_FREE(e->buf);
+        return false;
+    }
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Vacia el bufer, cierra el archivo y regresa falso si hubo algun error de escritura
+*/
+static bool _escritor_cerrar(_Escritor* e) {
+    _escritor_vaciar(e);
+    if(fclose(e->archivo)!=0) e->error=true;
+    GRAFO_D_FREE(e->buf);
+    return !e->error;
+}
+
+/*------------------------------Formato Matrix Market------------------------------------*/
+
+/*  Las funciones siguientes escriben y leen matrices en el formato de texto Matrix Market
+    (https://math.nist.gov/MatrixMarket/formats.html) para intercambiarlas con herramientas
+    numericas. Los indices de los archivos empiezan en 1 y corresponden a la posicion del vertice
+    en el grafo mas uno. Las matrices de pesos se escriben con campo "integer" si peso_t es un tipo
+    entero y "real" si no lo es. La escritura usa un bufer propio y formatea los enteros sin
+    printf(); la lectura carga el archivo completo (con mmap() si se definio GRAFO_D_MMAP) y lo
+    interpreta directamente. Al leer se aceptan matrices cuadradas con simetria "general" o
+    "symmetric" y campos "integer", "real" o "pattern"; "complex", "skew-symmetric" y "hermitian"
+    no son compatibles.
+*/
+
+/*  Escribe la matriz de pesos en el archivo ruta en formato Matrix Market. Si coordenado es
+    verdadero se usa el formato "coordinate" y solo se escriben las celdas distintas de
+    PESO_NO_ARISTA; si no se usa el formato "array", que incluye todas las celdas por columnas,
+    con PESO_NO_ARISTA en las celdas sin arista. Regresa falso si no se pudo escribir el archivo.
+*/
+static bool matriz_peso_guardar_mm(const Matriz_Peso* matriz, const char* ruta, bool coordenado) {
+    _Escritor e;
+    if(!_escritor_abrir(&e, ruta)) return false;
+    size_t n=matriz->orden;
+    _escritor_cadena(&e, coordenado ? "%%MatrixMarket matrix coordinate " : "%%MatrixMarket matrix array ");
+    _escritor_cadena(&e, _GD_PESO_ENTERO ? "integer general\n" : "real general\n");
+    _escritor_natural(&e, n);
+    _escritor_char(&e, ' ');
+    _escritor_natural(&e, n);
+    if(coordenado) {
+        size_t nnz=0;
+        for(size_t c=0; c<n*n; ++c) if(matriz->datos[c]!=PESO_NO_ARISTA) ++nnz;
+        _escritor_char(&e, ' ');
+        _escritor_natural(&e, nnz);
+        _escritor_char(&e, '\n');
+        for(size_t i=0; i<n && !e.error; ++i)
+            for(size_t j=0; j<n; ++j) {
+                peso_t peso=matriz->datos[i*n+j];
+                if(peso==PESO_NO_ARISTA) continue;
+                _escritor_natural(&e, i+1);
+                _escritor_char(&e, ' ');
+                _escritor_natural(&e, j+1);
+                _escritor_char(&e, ' ');
+                _escritor_peso(&e, peso);
+                _escritor_char(&e, '\n');
+            }
+    }
+    else {
+        _escritor_char(&e, '\n');
+        for(size_t j=0; j<n && !e.error; ++j)
+            for(size_t i=0; i<n; ++i) {
+                _escritor_peso(&e, matriz->datos[i*n+j]);
+                _escritor_char(&e, '\n');
+            }
+    }
+    return _escritor_cerrar(&e);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe la cabecera de una matriz de patron de orden n con nnz celdas no vacias
+*/
+static void _gd_mm_cabecera_patron(_Escritor* e, size_t n, size_t nnz) {
+    _escritor_cadena(e, "%%MatrixMarket matrix coordinate pattern general\n");
+    _escritor_natural(e, n);
+    _escritor_char(e, ' ');
+    _escritor_natural(e, n);
+    _escritor_char(e, ' ');
+    _escritor_natural(e, nnz);
+    _escritor_char(e, '\n');
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static inline void _gd_mm_celda_patron(_Escritor* e, size_t i, size_t j) {
+    _escritor_natural(e, i+1);
+    _escritor_char(e, ' ');
+    _escritor_natural(e, j+1);
+    _escritor_char(e, '\n');
+}
+
+/*  Escribe la matriz de adyacencia en el archivo ruta en formato Matrix Market "coordinate
+    pattern", con una entrada por cada celda que tiene una arista. Regresa falso si no se pudo
+    escribir el archivo.
+*/
+static bool matriz_ady_guardar_mm(const Matriz_Ady* matriz, const char* ruta) {
+    _Escritor e;
+    if(!_escritor_abrir(&e, ruta)) return false;
+    size_t n=matriz->orden, nnz=0;
+    for(size_t c=0; c<n*n; ++c) if(matriz->datos[c]!=NULL) ++nnz;
+    _gd_mm_cabecera_patron(&e, n, nnz);
+    for(size_t i=0; i<n && !e.error; ++i)
+        for(size_t j=0; j<n; ++j)
+            if(matriz->datos[i*n+j]!=NULL) _gd_mm_celda_patron(&e, i, j);
+    return _escritor_cerrar(&e);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa la posicion del bit encendido menos significativo de una palabra distinta de 0
+*/
+static inline size_t _gd_ctz(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(x);
+#else
+    size_t n=0;
+    while(!(x&1)) {x>>=1; ++n;}
+    return n;
+#endif
+}
+
+/*  Escribe la matriz de bits en el archivo ruta en formato Matrix Market "coordinate pattern",
+    con una entrada por cada bit encendido. Regresa falso si no se pudo escribir el archivo.
+*/
+static bool matriz_bits_guardar_mm(const Matriz_Bits* matriz, const char* ruta) {
+    _Escritor e;
+    if(!_escritor_abrir(&e, ruta)) return false;
+    size_t n=matriz->orden, nnz=0;
+    for(size_t c=0; c<n*matriz->palabras; ++c) nnz+=_gd_popcount(matriz->datos[c]);
+    _gd_mm_cabecera_patron(&e, n, nnz);
+    for(size_t i=0; i<n && !e.error; ++i) {
+        const uint64_t* renglon=matriz->datos+i*matriz->palabras;
+        for(size_t w=0; w<matriz->palabras; ++w)
+            for(uint64_t bits=renglon[w]; bits!=0; bits&=bits-1)
+                _gd_mm_celda_patron(&e, i, w*64+_gd_ctz(bits));
+    }
+    return _escritor_cerrar(&e);
+}
+
+//  !!!ESTRUCTURA DE USO INTERNO!!!
+typedef struct _cabecera_mm {
+    bool coordenado;
+    bool patron;
+    bool simetrico;
+    size_t orden;
+    size_t nnz;
+} _Cabecera_MM;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa verdadero si el texto [p, p+largo) es igual a pal sin distinguir mayusculas
+*/
+static bool _gd_igual_ci(const char* p, size_t largo, const char* pal) {
+    size_t i=0;
+    for(; i<largo && pal[i]!='\0'; ++i) {
+        char c=(p[i]>='A' && p[i]<='Z') ? (char)(p[i]-'A'+'a') : p[i];
+        if(c!=pal[i]) return false;
+    }
+    return i==largo && pal[i]=='\0';
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Obtiene el siguiente campo separado por espacios o saltos de linea a partir de *p, regresa
+    falso si no quedan campos
+*/
+static bool _gd_mm_campo(const char** p, const char* fin, const char** campo, size_t* largo) {
+    const char* q=*p;
+    while(q<fin && (*q==' ' || *q=='\t' || *q=='\n' || *q=='\r')) ++q;
+    if(q==fin) return false;
+    *campo=q;
+    while(q<fin && *q!=' ' && *q!='\t' && *q!='\n' && *q!='\r') ++q;
+    *largo=(size_t)(q-*campo);
+    *p=q;
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Interpreta la cabecera, los comentarios y la linea de tamanos de un archivo Matrix Market
+    y deja *p al inicio de las entradas. Regresa falso si el archivo no es compatible.
+*/
+static bool _gd_mm_cabecera(const char** p, const char* fin, _Cabecera_MM* cab) {
+    const char* linea=(const char*)memchr(*p, '\n', (size_t)(fin-*p));
+    if(!linea) return false;
+    const char* campos[5];
+    size_t largos[5], n=0;
+    const char* q=*p;
+    while(n<5 && _gd_mm_campo(&q, linea, &campos[n], &largos[n])) ++n;
+    if(n!=5 || !_gd_igual_ci(campos[0], largos[0], "%%matrixmarket") || !_gd_igual_ci(campos[1], largos[1], "matrix"))
+        return false;
+    if(_gd_igual_ci(campos[2], largos[2], "coordinate")) cab->coordenado=true;
+    else if(_gd_igual_ci(campos[2], largos[2], "array")) cab->coordenado=false;
+    else return false;
+    cab->patron=_gd_igual_ci(campos[3], largos[3], "pattern");
+    if(!cab->patron && !_gd_igual_ci(campos[3], largos[3], "real") &&
+       !_gd_igual_ci(campos[3], largos[3], "integer") && !_gd_igual_ci(campos[3], largos[3], "double"))
+        return false;
+    if(cab->patron && !cab->coordenado) return false;
+    if(_gd_igual_ci(campos[4], largos[4], "symmetric")) cab->simetrico=true;
+    else if(_gd_igual_ci(campos[4], largos[4], "general")) cab->simetrico=false;
+    else return false;
+    //Saltamos los comentarios
+    q=linea+1;
+    while(q<fin && *q=='%') {
+        linea=(const char*)memchr(q, '\n', (size_t)(fin-q));
+        q=linea ? linea+1 : fin;
+    }
+    const char* campo;
+    size_t largo, m;
+    if(!_gd_mm_campo(&q, fin, &campo, &largo) || !_gd_leer_natural(campo, largo, &(cab->orden))) return false;
+    if(!_gd_mm_campo(&q, fin, &campo, &largo) || !_gd_leer_natural(campo, largo, &m) || m!=cab->orden) return false;
+    if(cab->coordenado) {
+        if(!_gd_mm_campo(&q, fin, &campo, &largo) || !_gd_leer_natural(campo, largo, &(cab->nnz))) return false;
+    }
+    else cab->nnz=cab->simetrico ? cab->orden*(cab->orden+1)/2 : cab->orden*cab->orden;
+    *p=q;
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Lee la posicion (i, j) de la siguiente entrada de un archivo "coordinate" y la convierte a
+    indices desde 0
+*/
+static bool _gd_mm_posicion(const char** p, const char* fin, size_t orden, size_t* i, size_t* j) {
+    const char* campo;
+    size_t largo;
+    if(!_gd_mm_campo(p, fin, &campo, &largo) || !_gd_leer_natural(campo, largo, i)) return false;
+    if(!_gd_mm_campo(p, fin, &campo, &largo) || !_gd_leer_natural(campo, largo, j)) return false;
+    if(*i==0 || *j==0 || *i>orden || *j>orden) return false;
+    --(*i); --(*j);
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Lee el siguiente valor de una entrada y lo convierte a peso_t
+*/
+static bool _gd_mm_peso(const char** p, const char* fin, peso_t* peso) {
+    const char* campo;
+    size_t largo;
+    if(!_gd_mm_campo(p, fin, &campo, &largo)) return false;
+    if(_GD_PESO_ENTERO) {
+        char buf[32];
+        if(largo>=sizeof(buf)) return false;
+        memcpy(buf, campo, largo);
+        buf[largo]='\0';
+        char* resto;
+        if(_GD_PESO_SIGNO) *peso=(peso_t)strtoll(buf, &resto, 10);
+        else *peso=(peso_t)strtoull(buf, &resto, 10);
+        if(*resto=='\0') return true;
+    }
+    double val;
+    if(!_gd_leer_real(campo, largo, &val)) return false;
+    *peso=(peso_t)val;
+    return true;
+}
+
+/*  Lee una matriz de pesos de un archivo Matrix Market. Las celdas que no aparecen en un archivo
+    "coordinate" quedan en PESO_NO_ARISTA y las entradas de un archivo "pattern" tienen peso 1.
+    La memoria reservada para la matriz debe liberarse con GRAFO_D_FREE(). Regresa NULL si el
+    archivo no se pudo leer, no es compatible, tiene una entrada invalida o no hubo memoria.
+*/
+static Matriz_Peso* matriz_peso_cargar_mm(const char* ruta) {
+    size_t bytes;
+    bool mapeado;
+    const char* texto=(const char*)_grafo_d_abrir_archivo(ruta, &bytes, &mapeado);
+    if(!texto) return NULL;
+    const char* p=texto;
+    const char* fin=texto+bytes;
+    _Cabecera_MM cab;
+    Matriz_Peso* matriz=NULL;
+    if(!_gd_mm_cabecera(&p, fin, &cab)) goto salir;
+    if(cab.orden>0 && cab.orden>(SIZE_MAX-sizeof(Matriz_Peso))/sizeof(peso_t)/cab.orden) goto salir;
+    matriz=(Matriz_Peso*)GRAFO_D_MALLOC(sizeof(Matriz_Peso)+sizeof(peso_t)*cab.orden*cab.orden);
+    if(!matriz) goto salir;
+    matriz->orden=cab.orden;
+    size_t n=cab.orden;
+    for(size_t c=0; c<n*n; ++c) matriz->datos[c]=PESO_NO_ARISTA;
+    //Las entradas de un archivo "array" van por columnas y si es simetrico solo el triangulo inferior
+    size_t i=0, j=0;
+    for(size_t k=0; k<cab.nnz; ++k) {
+        peso_t peso=(peso_t)1;
+        if(cab.coordenado) {
+            if(!_gd_mm_posicion(&p, fin, n, &i, &j)) goto error;
+        }
+        else if(i==n) {
+            ++j;
+            i=cab.simetrico ? j : 0;
+        }
+        if(!cab.patron && !_gd_mm_peso(&p, fin, &peso)) goto error;
+        matriz->datos[i*n+j]=peso;
+        if(cab.simetrico) matriz->datos[j*n+i]=peso;
+        if(!cab.coordenado) ++i;
+    }
+    goto salir;
+
+error:
+    GRAFO_D_FREE(matriz);
+    matriz=NULL;
+salir:
+    _grafo_d_soltar_archivo((void*)texto, bytes, mapeado);
+    return matriz;
+}
+
+/*  Lee una matriz de adyacencia de un archivo Matrix Market "coordinate" como matriz de bits,
+    encendiendo el bit de cada entrada que aparezca en el archivo sin importar su valor. Una
+    Matriz_Ady contiene direcciones de aristas de un grafo y no puede reconstruirse desde un
+    archivo, por lo que esta funcion es la contraparte de matriz_ady_guardar_mm(). La memoria
+    reservada para la matriz debe liberarse con GRAFO_D_FREE(). Regresa NULL si el archivo no se
+    pudo leer, no es compatible, tiene una entrada invalida o no hubo memoria.
+*/
+static Matriz_Bits* matriz_bits_cargar_mm(const char* ruta) {
+    size_t bytes;
+    bool mapeado;
+    const char* texto=(const char*)_grafo_d_abrir_archivo(ruta, &bytes, &mapeado);
+    if(!texto) return NULL;
+    const char* p=texto;
+    const char* fin=texto+bytes;
+    _Cabecera_MM cab;
+    Matriz_Bits* matriz=NULL;
+    if(!_gd_mm_cabecera(&p, fin, &cab) || !cab.coordenado) goto salir;
+    size_t n=cab.orden;
+    size_t palabras=(n+GD_BITS_VECTOR-1)/GD_BITS_VECTOR*(GD_BITS_VECTOR/64);
+    matriz=(Matriz_Bits*)GRAFO_D_CALLOC(1, sizeof(Matriz_Bits)+sizeof(uint64_t)*palabras*n);
+    if(!matriz) goto salir;
+    matriz->orden=n;
+    matriz->palabras=palabras;
+    for(size_t k=0; k<cab.nnz; ++k) {
+        size_t i, j;
+        peso_t peso;
+        if(!_gd_mm_posicion(&p, fin, n, &i, &j) || (!cab.patron && !_gd_mm_peso(&p, fin, &peso))) {
+            GRAFO_D_FREE(matriz);
+            matriz=NULL;
+            break;
+        }
+        matriz->datos[i*palabras+(j>>6)]|=(uint64_t)1<<(j&63);
+        if(cab.simetrico) matriz->datos[j*palabras+(i>>6)]|=(uint64_t)1<<(i&63);
+    }
+
+salir:
+    _grafo_d_soltar_archivo((void*)texto, bytes, mapeado);
+    return matriz;
+}
+
+/*--------------------------------Diario de Operaciones----------------------------------*/
+
+/*  Un diario registra en un archivo binario cada operacion que modifica el grafo
+    (grafo_d_insertar_vertice, grafo_d_eliminar_vertice, grafo_d_insertar_arista,
+    grafo_d_insertar_arista_par, grafo_d_insertar_arpar y grafo_d_elminar_arista) para poder
+    reconstruirlo despues de una falla con grafo_d_diario_recuperar(). Cada cierto numero de
+    operaciones el diario crea un punto de control: guarda el grafo completo con
+    grafo_d_guardar_binario() y empieza un registro vacio, por lo que recuperar el grafo solo
+    requiere cargar el ultimo punto de control y aplicar las operaciones posteriores. Con la ruta
+    base ruta se usan los archivos:
+    - ruta.log: cabecera con la generacion del punto de control vigente seguida de los registros.
+    - ruta.<generacion>.bin: punto de control en formato binario.
+    Los vertices se identifican en el registro por un numero consecutivo que empieza en el orden
+    del punto de control, de modo que las operaciones se aplican en O(1) sin buscar los vertices.
+    Cada registro termina con una suma de verificacion, al recuperar se ignora un registro final
+    incompleto. Los registros se acumulan en un bufer, solo las operaciones escritas al archivo
+    con grafo_d_diario_sincronizar() (o al llenarse el bufer) sobreviven a una falla del proceso.
+    Las aristas insertadas con grafo_d_insertar_arista_atomica() o grafo_d_cargar_texto() no se
+    registran, al terminar la carga se crea un punto de control. Vertice y Arista se escriben tal
+    como estan en memoria, con las mismas restricciones que el formato binario.
+*/
+
+/*  Numero de registros despues del cual el diario crea un punto de control automaticamente*/
+#ifndef GRAFO_D_DIARIO_PERIODO
+#define GRAFO_D_DIARIO_PERIODO 1000000
+#endif
+
+#define GD_DIARIO_VERSION 1
+
+//  !!!ESTRUCTURAS DE USO INTERNO!!!
+typedef struct _cabecera_diario {
+    char magia[8];
+    uint32_t version;
+    uint32_t tam_vertice;
+    uint32_t tam_arista;
+    uint32_t orden_bytes;
+    uint64_t generacion;
+} _Cabecera_Diario;
+
+typedef struct _diario {
+    char* ruta;
+    uint64_t generacion;
+    _Escritor log;
+    _Tabla_H* ids;
+    Nodo_V** nodos;
+    size_t num_ids;
+    size_t capacidad;
+    size_t registros;
+    bool error;
+} _Diario;
+
+static const char _gd_diario_magia[8]={'G','R','A','F','O','_','D','J'};
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe en buf el nombre del archivo de la ruta base con la terminacion indicada, o del
+    punto de control de la generacion indicada si terminacion es NULL
+*/
+static void _grafo_d_diario_nombre(char* buf, size_t tam, const char* ruta, const char* terminacion, uint64_t generacion) {
+    if(terminacion) snprintf(buf, tam, "%s%s", ruta, terminacion);
+    else snprintf(buf, tam, "%s.%llu.bin", ruta, (unsigned long long)generacion);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa el identificador del vertice nodo en el diario del grafo
+*/
+static size_t _grafo_d_diario_id(const Grafo_D* grafo, const Nodo_V* nodo) {
+    const _Diario* diario=grafo->diario;
+    size_t hash=_gd_hash_ptr(nodo);
+    for(_Nodo_H* hptr=_tabla_h_cubeta(diario->ids, hash); hptr!=NULL; hptr=hptr->sig)
+        if(hptr->hash==hash && diario->nodos[(uintptr_t)hptr->elem]==nodo) return (uintptr_t)hptr->elem;
+    return GD_NO_POSICION;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Asigna el siguiente identificador al vertice nodo. La tabla de identificadores guarda el
+    identificador como elemento y lo relaciona con el nodo mediante el arreglo nodos.
+*/
+static bool _grafo_d_diario_asignar(_Diario* diario, Nodo_V* nodo) {
+    if(diario->num_ids==diario->capacidad) {
+        size_t capacidad=diario->capacidad ? diario->capacidad*2 : 64;
+        Nodo_V** nodos=(Nodo_V**)GRAFO_D_REALLOC(diario->nodos, sizeof(Nodo_V*)*capacidad);
+        if(!nodos) return false;
+        diario->nodos=nodos;
+        diario->capacidad=capacidad;
+    }
+    if(!_tabla_h_insertar(diario->ids, _gd_hash_ptr(nodo), (void*)(uintptr_t)diario->num_ids)) return false;
+    diario->nodos[diario->num_ids++]=nodo;
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Vuelve a numerar los vertices del grafo por su posicion, como quedan en un punto de control
+*/
+static bool _grafo_d_diario_numerar(Grafo_D* grafo) {
+    _Diario* diario=grafo->diario;
+    if(diario->ids) _tabla_h_destruir(diario->ids);
+    diario->ids=_tabla_h_crear(grafo->orden);
+    diario->num_ids=0;
+    if(!diario->ids) return false;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr!=NULL; vptr=vptr->sig)
+        if(!_grafo_d_diario_asignar(diario, vptr)) return false;
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Agrega un registro al diario. Para _GD_DIARIO_INS_V ini es el vertice nuevo y dato sus datos,
+    para _GD_DIARIO_ELI_V pos es el identificador del vertice eliminado, para _GD_DIARIO_INS_A y
+    _GD_DIARIO_INS_PAR ini y fin son los extremos y dato los datos de la arista, y para
+    _GD_DIARIO_ELI_A ini es el vertice de la arista eliminada y pos su posicion en su lista.
+    Se llama despues de aplicar la operacion al grafo.
+*/
+static void _grafo_d_diario_registrar(Grafo_D* grafo, unsigned char tipo, const Nodo_V* ini,
+    const Nodo_V* fin, size_t pos, const void* dato) {
+    _Diario* diario=grafo->diario;
+    unsigned char reg[1+2*sizeof(uint64_t)+sizeof(Vertice)+sizeof(Arista)+sizeof(uint32_t)];
+    size_t n=1;
+    uint64_t campos[2];
+    reg[0]=tipo;
+    switch(tipo) {
+        case _GD_DIARIO_INS_V:
+            if(!_grafo_d_diario_asignar(diario, (Nodo_V*)ini)) diario->error=true;
+            memcpy(reg+n, dato, sizeof(Vertice));
+            n+=sizeof(Vertice);
+            break;
+        case _GD_DIARIO_ELI_V:
+            if(pos==GD_NO_POSICION) {diario->error=true; return;}
+            campos[0]=pos;
+            memcpy(reg+n, campos, sizeof(uint64_t));
+            n+=sizeof(uint64_t);
+            //El nodo ya fue liberado, su direccion solo se usa para encontrar la cubeta
+            _tabla_h_eliminar(diario->ids, (void*)(uintptr_t)pos);
+            diario->nodos[pos]=NULL;
+            break;
+        case _GD_DIARIO_INS_A:
+        case _GD_DIARIO_INS_PAR:
+            campos[0]=_grafo_d_diario_id(grafo, ini);
+            campos[1]=_grafo_d_diario_id(grafo, fin);
+            if(campos[0]==GD_NO_POSICION || campos[1]==GD_NO_POSICION) {diario->error=true; return;}
+            memcpy(reg+n, campos, 2*sizeof(uint64_t));
+            n+=2*sizeof(uint64_t);
+            memcpy(reg+n, dato, sizeof(Arista));
+            n+=sizeof(Arista);
+            break;
+        case _GD_DIARIO_ELI_A:
+            campos[0]=_grafo_d_diario_id(grafo, ini);
+            campos[1]=pos;
+            if(campos[0]==GD_NO_POSICION) {diario->error=true; return;}
+            memcpy(reg+n, campos, 2*sizeof(uint64_t));
+            n+=2*sizeof(uint64_t);
+            break;
+    }
+    uint32_t suma=(uint32_t)grafo_d_hash_bytes(reg, n);
+    memcpy(reg+n, &suma, sizeof(uint32_t));
+    _escritor_bytes(&(diario->log), (const char*)reg, n+sizeof(uint32_t));
+    if(diario->log.error) diario->error=true;
+    if(++(diario->registros)>=GRAFO_D_DIARIO_PERIODO && !_grafo_d_diario_checkpoint(grafo))
+        diario->error=true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Verifica la cabecera de un archivo de registro, regresa falso si no es compatible
+*/
+static bool _grafo_d_diario_validar(const _Cabecera_Diario* cab) {
+    return memcmp(cab->magia, _gd_diario_magia, sizeof(cab->magia))==0 && cab->version==GD_DIARIO_VERSION &&
+        cab->tam_vertice==sizeof(Vertice) && cab->tam_arista==sizeof(Arista) && cab->orden_bytes==_GD_BIN_ORDEN_BYTES;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Crea un punto de control de la generacion siguiente: guarda el grafo, empieza un registro
+    nuevo que hace referencia a el y elimina el punto de control anterior. Cada archivo se escribe
+    con un nombre temporal y se renombra al terminar, de modo que ruta.log siempre hace referencia
+    a un punto de control completo. Si falla el diario sigue usando el registro anterior.
+*/
+static bool _grafo_d_diario_checkpoint(Grafo_D* grafo) {
+    _Diario* diario=grafo->diario;
+    size_t tam=strlen(diario->ruta)+32;
+    char* nombre=(char*)GRAFO_D_MALLOC(tam);
+    char* tmp=(char*)GRAFO_D_MALLOC(tam);
+    _Escritor log;
+    bool ok=false;
+    if(!nombre || !tmp) goto salir;
+    uint64_t generacion=diario->generacion+1;
+
+    _grafo_d_diario_nombre(tmp, tam, diario->ruta, ".bin.tmp", 0);
+    _grafo_d_diario_nombre(nombre, tam, diario->ruta, NULL, generacion);
+    if(!grafo_d_guardar_binario(grafo, tmp, false) || rename(tmp, nombre)!=0) {
+        remove(tmp);
+        goto salir;
+    }
+    _grafo_d_diario_nombre(tmp, tam, diario->ruta, ".log.tmp", 0);
+    if(!_escritor_abrir(&log, tmp)) {
+        remove(nombre);
+        goto salir;
+    }
+    _Cabecera_Diario cab;
+    memset(&cab, 0, sizeof(_Cabecera_Diario));
+    memcpy(cab.magia, _gd_diario_magia, sizeof(cab.magia));
+    cab.version=GD_DIARIO_VERSION;
+    cab.tam_vertice=sizeof(Vertice);
+    cab.tam_arista=sizeof(Arista);
+    cab.orden_bytes=_GD_BIN_ORDEN_BYTES;
+    cab.generacion=generacion;
+    _escritor_bytes(&log, (const char*)&cab, sizeof(_Cabecera_Diario));
+    _escritor_vaciar(&log);
+    _grafo_d_diario_nombre(nombre, tam, diario->ruta, ".log", 0);
+    if(log.error || fflush(log.archivo)!=0 || rename(tmp, nombre)!=0) {
+        _escritor_cerrar(&log);
+        remove(tmp);
+        _grafo_d_diario_nombre(nombre, tam, diario->ruta, NULL, generacion);
+        remove(nombre);
+        goto salir;
+    }
+
+    //Los registros pendientes del registro anterior ya estan incluidos en el punto de control
+    if(diario->log.archivo) _escritor_cerrar(&(diario->log));
+    if(diario->generacion>0) {
+        _grafo_d_diario_nombre(nombre, tam, diario->ruta, NULL, diario->generacion);
+        remove(nombre);
+    }
+    diario->log=log;
+    diario->generacion=generacion;
+    diario->registros=0;
+    ok=_grafo_d_diario_numerar(grafo);
+    if(!ok) diario->error=true;
+
+salir:
+    GRAFO_D_FREE(nombre); GRAFO_D_FREE(tmp);
+    return ok;
+}
+
+/*  Empieza a registrar las operaciones que modifican el grafo en un diario con la ruta base ruta
+    (ver arriba). Se crea inmediatamente un punto de control con el estado actual del grafo, que
+    reemplaza a cualquier diario anterior con la misma ruta. El grafo no puede tener ya un diario.
+    Regresa falso si no se pudieron escribir los archivos o no hubo memoria.
+*/
+static bool grafo_d_diario_iniciar(Grafo_D* grafo, const char* ruta) {
+    assert(grafo->diario==NULL);
+    _Diario* diario=(_Diario*)GRAFO_D_CALLOC(1, sizeof(_Diario));
+    if(!diario) return false;
+    diario->ruta=(char*)GRAFO_D_MALLOC(strlen(ruta)+1);
+    if(!diario->ruta) {GRAFO_D_FREE(diario); return false;}
+    strcpy(diario->ruta, ruta);
+    //Se continua la numeracion de generaciones de un diario anterior para no pisar sus archivos
+    size_t tam=strlen(ruta)+32;
+    char* nombre=(char*)GRAFO_D_MALLOC(tam);
+    if(nombre) {
+        _grafo_d_diario_nombre(nombre, tam, ruta, ".log", 0);
+        FILE* archivo=fopen(nombre, "rb");
+        _Cabecera_Diario cab;
+        if(archivo) {
+            if(fread(&cab, sizeof(_Cabecera_Diario), 1, archivo)==1 && _grafo_d_diario_validar(&cab))
+                diario->generacion=cab.generacion;
+            fclose(archivo);
+        }
+        GRAFO_D_FREE(nombre);
+    }
+    grafo->diario=diario;
+    if(!_grafo_d_diario_checkpoint(grafo)) {
+        grafo->diario=NULL;
+        if(diario->ids) _tabla_h_destruir(diario->ids);
+        GRAFO_D_FREE(diario->nodos); GRAFO_D_FREE(diario->ruta); GRAFO_D_FREE(diario);
+        return false;
+    }
+    return true;
+}
+
+/*  Crea un punto de control del diario del grafo, de modo que una recuperacion posterior solo
+    tenga que aplicar las operaciones que sigan. Se llama automaticamente cada
+    GRAFO_D_DIARIO_PERIODO operaciones. Regresa falso si no se pudieron escribir los archivos.
+*/
+static bool grafo_d_diario_punto_control(Grafo_D* grafo) {
+    assert(grafo->diario!=NULL);
+    return _grafo_d_diario_checkpoint(grafo);
+}
+
+/*  Escribe al archivo los registros acumulados en el bufer del diario. Regresa falso si ocurrio
+    algun error del diario desde que se inicio, en cuyo caso el registro puede estar incompleto y
+    se recomienda crear un punto de control.
+*/
+static bool grafo_d_diario_sincronizar(Grafo_D* grafo) {
+    _Diario* diario=grafo->diario;
+    assert(diario!=NULL);
+    _escritor_vaciar(&(diario->log));
+    if(diario->log.error || fflush(diario->log.archivo)!=0) diario->error=true;
+    return !diario->error;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!*/
+static bool _grafo_d_diario_cerrar(Grafo_D* grafo) {
+    _Diario* diario=grafo->diario;
+    bool ok=_escritor_cerrar(&(diario->log)) && !diario->error;
+    _tabla_h_destruir(diario->ids);
+    GRAFO_D_FREE(diario->nodos); GRAFO_D_FREE(diario->ruta); GRAFO_D_FREE(diario);
+    grafo->diario=NULL;
+    return ok;
+}
+
+/*  Escribe los registros pendientes y deja de registrar las operaciones del grafo. Los archivos
+    del diario se conservan. grafo_d_destruir() termina el diario automaticamente. Regresa falso
+    si ocurrio algun error del diario desde que se inicio.
+*/
+static bool grafo_d_diario_terminar(Grafo_D* grafo) {
+    assert(grafo->diario!=NULL);
+    return _grafo_d_diario_cerrar(grafo);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Tamano de un registro del tipo indicado sin contar su suma de verificacion, 0 si el tipo no
+    es valido
+*/
+static size_t _gd_tam_registro(unsigned char tipo) {
+    switch(tipo) {
+        case _GD_DIARIO_INS_V: return 1+sizeof(Vertice);
+        case _GD_DIARIO_ELI_V: return 1+sizeof(uint64_t);
+        case _GD_DIARIO_INS_A:
+        case _GD_DIARIO_INS_PAR: return 1+2*sizeof(uint64_t)+sizeof(Arista);
+        case _GD_DIARIO_ELI_A: return 1+2*sizeof(uint64_t);
+    }
+    return 0;
+}
+
+/*  Reconstruye el grafo registrado en el diario con la ruta base ruta: carga el ultimo punto de
+    control y aplica las operaciones registradas despues de el. Los vertices se localizan por su
+    identificador en un arreglo, por lo que cada operacion se aplica sin recorrer el grafo, salvo
+    la eliminacion de vertices. Los registros se aplican hasta el final del archivo o hasta el
+    primer registro incompleto o danado. El grafo se regresa con un diario nuevo en la misma ruta
+    que empieza con un punto de control, y con las funciones por defecto (las funciones de
+    comparacion, peso y hash no se guardan en el diario). Regresa NULL si no existe el diario, no
+    es compatible, el punto de control esta danado o no hubo memoria.
+*/
+static Grafo_D* grafo_d_diario_recuperar(const char* ruta) {
+    size_t tam=strlen(ruta)+32, bytes=0;
+    bool mapeado=false;
+    char* nombre=(char*)GRAFO_D_MALLOC(tam);
+    const unsigned char* texto=NULL;
+    Grafo_D* grafo=NULL;
+    Nodo_V** nodos=NULL;
+    size_t num=0, capacidad=0;
+    if(!nombre) return NULL;
+    _grafo_d_diario_nombre(nombre, tam, ruta, ".log", 0);
+    texto=(const unsigned char*)_grafo_d_abrir_archivo(nombre, &bytes, &mapeado);
+    _Cabecera_Diario cab;
+    if(!texto || bytes<sizeof(_Cabecera_Diario)) goto error;
+    memcpy(&cab, texto, sizeof(_Cabecera_Diario));
+    if(!_grafo_d_diario_validar(&cab)) goto error;
+
+    if(cab.generacion>0) {
+        _grafo_d_diario_nombre(nombre, tam, ruta, NULL, cab.generacion);
+        Grafo_D_Mapa* mapa=grafo_d_mapear(nombre);
+        if(!mapa) goto error;
+        grafo=grafo_d_desde_mapa(mapa);
+        grafo_d_mapa_cerrar(mapa);
+    }
+    else grafo=grafo_d_crear();
+    if(!grafo) goto error;
+    capacidad=grafo->orden ? grafo->orden : 64;
+    nodos=(Nodo_V**)GRAFO_D_MALLOC(sizeof(Nodo_V*)*capacidad);
+    if(!nodos) goto error;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr!=NULL; vptr=vptr->sig) nodos[num++]=vptr;
+
+    const unsigned char* p=texto+sizeof(_Cabecera_Diario);
+    const unsigned char* fin=texto+bytes;
+    while(p<fin) {
+        size_t n=_gd_tam_registro(*p);
+        uint32_t suma;
+        uint64_t campos[2];
+        if(n==0 || (size_t)(fin-p)<n+sizeof(uint32_t)) break;
+        memcpy(&suma, p+n, sizeof(uint32_t));
+        if(suma!=(uint32_t)grafo_d_hash_bytes(p, n)) break;
+        if(*p!=_GD_DIARIO_INS_V) {
+            memcpy(campos, p+1, n>1+sizeof(uint64_t) ? 2*sizeof(uint64_t) : sizeof(uint64_t));
+            if(campos[0]>=num || nodos[campos[0]]==NULL) break;
+            if((*p==_GD_DIARIO_INS_A || *p==_GD_DIARIO_INS_PAR) && (campos[1]>=num || nodos[campos[1]]==NULL)) break;
+        }
+        switch(*p) {
+            case _GD_DIARIO_INS_V: {
+                Vertice vt;
+                memcpy(&vt, p+1, sizeof(Vertice));
+                if(num==capacidad) {
+                    Nodo_V** tmp=(Nodo_V**)GRAFO_D_REALLOC(nodos, sizeof(Nodo_V*)*capacidad*2);
+                    if(!tmp) goto error;
+                    nodos=tmp;
+                    capacidad*=2;
+                }
+                Vertice* nuevo=grafo_d_insertar_vertice(grafo, vt);
+                if(!nuevo) goto error;
+                nodos[num++]=_GD_NODO_V(nuevo);
+                break;
+            }
+            case _GD_DIARIO_ELI_V:
+                grafo_d_eliminar_vertice(grafo, &(nodos[campos[0]]->vt));
+                nodos[campos[0]]=NULL;
+                break;
+            case _GD_DIARIO_INS_A:
+            case _GD_DIARIO_INS_PAR: {
+                Nodo_A* a1=_grafo_d_reservar_arista(nodos[campos[0]]);
+                if(!a1) goto error;
+                Nodo_A* a2=NULL;
+                if(*p==_GD_DIARIO_INS_PAR) {
+                    a2=_grafo_d_reservar_arista(nodos[campos[1]]);
+                    if(!a2) {_grafo_d_liberar_arista(nodos[campos[0]], a1); goto error;}
+                }
+                memcpy(&(a1->ar), p+1+2*sizeof(uint64_t), sizeof(Arista));
+                a1->fin=_GD_CLAVE_V(nodos[campos[1]]);
+                _grafo_d_enlazar_arista(grafo, nodos[campos[0]], a1);
+                if(a2) {
+                    a2->ar=a1->ar;
+                    a2->fin=_GD_CLAVE_V(nodos[campos[0]]);
+                    _grafo_d_enlazar_arista(grafo, nodos[campos[1]], a2);
+                }
+                break;
+            }
+            case _GD_DIARIO_ELI_A: {
+                Nodo_V* vptr=nodos[campos[0]];
+                Nodo_A* aptr=vptr->lista_ady, *aprev=NULL;
+                for(size_t k=0; aptr!=NULL && k<campos[1]; ++k) {
+                    aprev=aptr;
+                    aptr=aptr->sig;
+                }
+                if(aptr!=NULL) _grafo_d_desenlazar_arista(grafo, vptr, aprev, aptr, (size_t)campos[1]);
+                break;
+            }
+        }
+        p+=n+sizeof(uint32_t);
+    }
+    _grafo_d_soltar_archivo((void*)texto, bytes, mapeado);
+    texto=NULL;
+    GRAFO_D_FREE(nodos); GRAFO_D_FREE(nombre);
+    nodos=NULL; nombre=NULL;
+    if(!grafo_d_diario_iniciar(grafo, ruta)) goto error;
+    return grafo;
+
+error:
+    if(texto) _grafo_d_soltar_archivo((void*)texto, bytes, mapeado);
+    if(grafo) grafo_d_destruir(grafo);
+    GRAFO_D_FREE(nodos); GRAFO_D_FREE(nombre);
+    return NULL;
+}
+
+/*---------------------------------Exportacion en Flujo----------------------------------*/
+
+/*  Las funciones de exportacion escriben el grafo a un archivo abierto (puede ser stdout) a
+    traves de un bufer proporcionado por el usuario, sin reservar memoria y con una sola
+    llamada a fwrite() cada vez que se llena el bufer. El texto de cada vertice y arista lo
+    producen las funciones del usuario:
+    - fmt_vt(vt, buf, cap) escribe en buf a lo mas cap caracteres que representan al vertice vt
+      y regresa el numero de caracteres escritos (sin '\0'). El texto debe identificar al vertice
+      de forma unica, ya que las aristas hacen referencia a sus extremos con el. Si es NULL se
+      escribe el valor del vertice, lo cual no es posible si se definio STRUCT_VERTICE.
+    - fmt_ar(ar, buf, cap) hace lo mismo para las aristas. Si es NULL se escribe el valor de la
+      arista, o no se escribe nada si se definio STRUCT_ARISTA.
+    Las funciones reciben al menos GD_TAM_CAMPO_ES caracteres de espacio, regresar una longitud
+    mayor a cap se considera un error.
+*/
+
+/*  Espacio minimo que se garantiza a las funciones de formato del usuario*/
+#ifndef GD_TAM_CAMPO_ES
+#define GD_TAM_CAMPO_ES 256
+#endif
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Prepara un escritor sobre un archivo ya abierto y un bufer del usuario
+*/
+static inline void _escritor_iniciar(_Escritor* e, FILE* archivo, char* buf, size_t capacidad) {
+    e->archivo=archivo;
+    e->buf=buf;
+    e->capacidad=capacidad;
+    e->usado=0;
+    e->error=false;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe el texto que produce la funcion fmt del usuario directamente en el bufer
+*/
+static void _escritor_formato(_Escritor* e, size_t (*fmt)(const void*, char*, size_t), const void* dato) {
+    if(e->capacidad-e->usado<GD_TAM_CAMPO_ES) _escritor_vaciar(e);
+    size_t libre=e->capacidad-e->usado;
+    size_t n=fmt(dato, e->buf+e->usado, libre);
+    if(n>libre) e->error=true;
+    else e->usado+=n;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe el texto de un vertice con la funcion del usuario o su valor si no hay funcion
+*/
+static void _escritor_vt(_Escritor* e, size_t (*fmt_vt)(const Vertice*, char*, size_t), const Vertice* vt) {
+    if(fmt_vt) {
+        _escritor_formato(e, (size_t (*)(const void*, char*, size_t))fmt_vt, vt);
+        return;
+    }
+#ifndef STRUCT_VERTICE
+    if((Vertice)0.5!=(Vertice)0) _escritor_real(e, (double)*vt);
+    else if((Vertice)-1<(Vertice)0) _escritor_entero(e, (int64_t)*vt);
+    else _escritor_natural(e, (uint64_t)*vt);
+#endif
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe el texto de una arista con la funcion del usuario o su valor si no hay funcion
+*/
+static void _escritor_ar(_Escritor* e, size_t (*fmt_ar)(const Arista*, char*, size_t), const Arista* ar) {
+    if(fmt_ar) {
+        _escritor_formato(e, (size_t (*)(const void*, char*, size_t))fmt_ar, ar);
+        return;
+    }
+#ifndef STRUCT_ARISTA
+    if((Arista)0.5!=(Arista)0) _escritor_real(e, (double)*ar);
+    else if((Arista)-1<(Arista)0) _escritor_entero(e, (int64_t)*ar);
+    else _escritor_natural(e, (uint64_t)*ar);
+#endif
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa si las aristas tienen texto: con STRUCT_ARISTA solo si hay funcion de formato
+*/
+static inline bool _gd_con_texto_ar(size_t (*fmt_ar)(const Arista*, char*, size_t)) {
+#ifdef STRUCT_ARISTA
+    return fmt_ar!=NULL;
+#else
+    (void)fmt_ar;
+    return true;
+#endif
+}
+
+/*  Escribe las aristas del grafo en archivo como una lista de aristas, una por linea con el
+    texto del vertice de inicio, el del vertice fin y el de la arista separados por tabuladores.
+    El formato es compatible con grafo_d_cargar_texto() con GD_TEXTO_LISTA si los vertices se
+    escriben como enteros. buf es un bufer de tam_buf bytes, con tam_buf>=GD_TAM_CAMPO_ES, que
+    no debe usarse durante la exportacion; entre mas grande menos llamadas a fwrite(). Regresa
+    falso si ocurrio algun error de escritura.
+*/
+static bool grafo_d_exportar_lista(const Grafo_D* grafo, FILE* archivo, char* buf, size_t tam_buf,
+    size_t (*fmt_vt)(const Vertice*, char*, size_t), size_t (*fmt_ar)(const Arista*, char*, size_t)) {
+#ifdef STRUCT_VERTICE
+    assert(fmt_vt!=NULL);
+#endif
+    assert(tam_buf>=GD_TAM_CAMPO_ES);
+    _Escritor e;
+    _escritor_iniciar(&e, archivo, buf, tam_buf);
+    bool con_ar=_gd_con_texto_ar(fmt_ar);
+    for(Nodo_V* vptr=grafo->lista_ady; vptr!=NULL && !e.error; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; aptr!=NULL; aptr=aptr->sig) {
+            _escritor_vt(&e, fmt_vt, &(vptr->vt));
+            _escritor_char(&e, '\t');
+            _escritor_vt(&e, fmt_vt, &(_GD_FIN(grafo, aptr)->vt));
+            if(con_ar) {
+                _escritor_char(&e, '\t');
+                _escritor_ar(&e, fmt_ar, &(aptr->ar));
+            }
+            _escritor_char(&e, '\n');
+        }
+    _escritor_vaciar(&e);
+    return !e.error && fflush(archivo)==0;
+}
+
+/*  Escribe el grafo en archivo en el lenguaje DOT de Graphviz como un grafo dirigido llamado
+    nombre. Cada vertice se escribe como un nodo cuyo identificador es su texto entre comillas,
+    por lo que fmt_vt no debe producir comillas dobles sin escapar; cada arista lleva su texto
+    como etiqueta. El bufer se usa igual que en grafo_d_exportar_lista(). Regresa falso si
+    ocurrio algun error de escritura.
+*/
+static bool grafo_d_exportar_dot(const Grafo_D* grafo, FILE* archivo, const char* nombre, char* buf, size_t tam_buf,
+    size_t (*fmt_vt)(const Vertice*, char*, size_t), size_t (*fmt_ar)(const Arista*, char*, size_t)) {
+#ifdef STRUCT_VERTICE
+    assert(fmt_vt!=NULL);
+#endif
+    assert(tam_buf>=GD_TAM_CAMPO_ES);
+    _Escritor e;
+    _escritor_iniciar(&e, archivo, buf, tam_buf);
+    bool con_ar=_gd_con_texto_ar(fmt_ar);
+    _escritor_cadena(&e, "digraph \"");
+    _escritor_cadena(&e, nombre);
+    _escritor_cadena(&e, "\" {\n");
+    //Primero los vertices para incluir los que no tienen aristas
+    for(Nodo_V* vptr=grafo->lista_ady; vptr!=NULL && !e.error; vptr=vptr->sig) {
+        _escritor_cadena(&e, "  \"");
+        _escritor_vt(&e, fmt_vt, &(vptr->vt));
+        _escritor_cadena(&e, "\";\n");
+    }
+    for(Nodo_V* vptr=grafo->lista_ady; vptr!=NULL && !e.error; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; aptr!=NULL; aptr=aptr->sig) {
+            _escritor_cadena(&e, "  \"");
+            _escritor_vt(&e, fmt_vt, &(vptr->vt));
+            _escritor_cadena(&e, "\" -> \"");
+            _escritor_vt(&e, fmt_vt, &(_GD_FIN(grafo, aptr)->vt));
+            _escritor_char(&e, '"');
+            if(con_ar) {
+                _escritor_cadena(&e, " [label=\"");
+                _escritor_ar(&e, fmt_ar, &(aptr->ar));
+                _escritor_cadena(&e, "\"]");
+            }
+            _escritor_cadena(&e, ";\n");
+        }
+    _escritor_cadena(&e, "}\n");
+    _escritor_vaciar(&e);
+    return !e.error && fflush(archivo)==0;
+}
+
+/*--------------------------------Compactacion del Grafo----------------------------------*/
+
+/*  Despues de muchas inserciones y eliminaciones los nodos del grafo quedan dispersos en la
+    memoria. grafo_d_compactar() los reubica en una sola region contigua: un arreglo con todos
+    los vertices en el orden de la lista de vertices seguido de los lotes de aristas que no caben
+    en los nodos locales de cada vertice. Como los nodos cambian de direccion, todos los
+    identificadores (Vertice* y Arista*) obtenidos antes se vuelven invalidos; la funcion regresa
+    una tabla de traduccion de los identificadores anteriores a los nuevos. Los nodos de la region
+    se liberan al volver a compactar o al destruir el grafo, los vertices y aristas eliminados
+    mientras tanto dejan su espacio sin usar dentro de ella.
+*/
+
+//  !!!ESTRUCTURA DE USO INTERNO!!!
+typedef struct _par_traduccion {
+    uintptr_t anterior;
+    void* nuevo;
+} _Par_Traduccion;
+
+/*  Tabla de traduccion de identificadores anteriores a identificadores nuevos. Se consulta con
+    grafo_d_traducir_vertice()/grafo_d_traducir_arista() y se libera con
+    grafo_d_traduccion_destruir().
+*/
+typedef struct grafo_d_traduccion {
+    size_t num_vertices;
+    size_t num_aristas;
+    _Par_Traduccion* vertices;
+    _Par_Traduccion* aristas;
+} Grafo_D_Traduccion;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Funcion de comparacion para ordenar un arreglo de _Par_Traduccion con qsort()
+*/
+static int _cmp_par_traduccion(const void* a, const void* b) {
+    uintptr_t pa=((const _Par_Traduccion*)a)->anterior, pb=((const _Par_Traduccion*)b)->anterior;
+    return (pa>pb)-(pa<pb);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Busca mediante busqueda binaria el identificador nuevo que corresponde a anterior
+*/
+static void* _grafo_d_traducir(const _Par_Traduccion* pares, size_t n, const void* anterior) {
+    size_t ini=0, fin=n;
+    uintptr_t clave=(uintptr_t)anterior;
+    while(ini<fin) {
+        size_t mitad=ini+(fin-ini)/2;
+        if(pares[mitad].anterior<clave) ini=mitad+1;
+        else fin=mitad;
+    }
+    if(ini<n && pares[ini].anterior==clave) return pares[ini].nuevo;
+    return NULL;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Crea una tabla de traduccion vacia para orden vertices y tamano aristas
+*/
+static Grafo_D_Traduccion* _grafo_d_crear_traduccion(size_t orden, size_t tamano) {
+    Grafo_D_Traduccion* tr=(Grafo_D_Traduccion*)GRAFO_D_MALLOC(sizeof(Grafo_D_Traduccion));
+    if(!tr) return NULL;
+    tr->num_vertices=tr->num_aristas=0;
+    tr->vertices=(_Par_Traduccion*)GRAFO_D_MALLOC(sizeof(_Par_Traduccion)*(orden ? orden : 1));
+    tr->aristas=(_Par_Traduccion*)GRAFO_D_MALLOC(sizeof(_Par_Traduccion)*(tamano ? tamano : 1));
+    if(!tr->vertices || !tr->aristas) {
+        GRAFO_D_FREE(tr->vertices); GRAFO_D_FREE(tr->aristas); GRAFO_D_FREE(tr);
+        return NULL;
+    }
+    return tr;
+}
+
+/*  Libera una tabla de traduccion*/
+static void grafo_d_traduccion_destruir(Grafo_D_Traduccion* tr) {
+    GRAFO_D_FREE(tr->vertices); GRAFO_D_FREE(tr->aristas); GRAFO_D_FREE(tr);
+    return;
+}
+
+/*  Regresa el identificador nuevo del vertice cuyo identificador anterior era vt, o NULL si vt
+    no era un vertice del grafo. vt solo se compara, nunca se accede a el.
+*/
+static inline Vertice* grafo_d_traducir_vertice(const Grafo_D_Traduccion* tr, const Vertice* vt) {
+    return (Vertice*)_grafo_d_traducir(tr->vertices, tr->num_vertices, vt);
+}
+
+/*  Regresa el identificador nuevo de la arista cuyo identificador anterior era ar, o NULL si ar
+    no era una arista del grafo. ar solo se compara, nunca se accede a el.
+*/
+static inline Arista* grafo_d_traducir_arista(const Grafo_D_Traduccion* tr, const Arista* ar) {
+    return (Arista*)_grafo_d_traducir(tr->aristas, tr->num_aristas, ar);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Crea en destino el indice hash de aristas con las aristas del indice origen traducidas con tr,
+    cuyo arreglo de aristas debe estar ordenado, conservando el orden de cada cubeta. Las aristas
+    de origen solo se comparan, nunca se accede a ellas. Si no hay memoria destino se queda sin
+    indice y regresa falso.
+*/
+static bool _grafo_d_trasladar_indice_ar(Grafo_D* destino, const _Tabla_H* origen,
+    size_t (*hash_ar)(Arista*), const Grafo_D_Traduccion* tr) {
+    _Tabla_H* tabla=_tabla_h_crear(origen->elementos);
+    bool ok=(tabla!=NULL);
+    for(size_t i=0; ok && i<origen->capacidad; ++i)
+        for(const _Nodo_H* hptr=origen->cubetas[i]; ok && hptr!=NULL; hptr=hptr->sig) {
+            uintptr_t anterior=(uintptr_t)hptr->elem+offsetof(Nodo_A, ar);
+            Arista* ar=grafo_d_traducir_arista(tr, (const Arista*)anterior);
+            ok=(ar!=NULL) && _tabla_h_insertar(tabla, hptr->hash, (char*)ar-offsetof(Nodo_A, ar));
+        }
+    if(!ok && tabla) {
+        _tabla_h_destruir(tabla);
+        tabla=NULL;
+    }
+    destino->indice_ar=tabla;
+    destino->hash_ar=tabla ? hash_ar : NULL;
+    return ok;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Reconstruye los indices hash del grafo despues de que sus nodos cambiaron de direccion segun
+    tr, cuyos arreglos deben estar ordenados. Si no hay memoria el grafo se queda sin el indice
+    que no se pudo reconstruir y regresa falso.
+*/
+static bool _grafo_d_reindexar(Grafo_D* grafo, const Grafo_D_Traduccion* tr) {
+    bool ok=true;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr!=NULL; vptr=vptr->sig)
+        if(vptr->lista_ady!=NULL) _grafo_d_ady_agregar(vptr, vptr->lista_ady);
+    if(grafo->indice_vt) ok=grafo_d_set_hash_vt(grafo, grafo->hash_vt) && ok;
+    if(grafo->indice_ar) {
+        //El indice anterior apunta a los nodos liberados, solo se traducen sus direcciones
+        _Tabla_H* anterior=grafo->indice_ar;
+        ok=_grafo_d_trasladar_indice_ar(grafo, anterior, grafo->hash_ar, tr) && ok;
+        _tabla_h_destruir(anterior);
+    }
+    return ok;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa los bytes que ocupan los lotes de aristas de todos los vertices en una region, un lote
+    por cada vertice cuyas aristas no caben en sus nodos locales
+*/
+static size_t _grafo_d_bytes_lotes(const Grafo_D* grafo) {
+    size_t bytes=0;
+    for(const Nodo_V* vptr=grafo->lista_ady; vptr!=NULL; vptr=vptr->sig)
+        if(vptr->grado_s>GRAFO_D_ADY_LOCAL)
+            bytes+=sizeof(_Lote_A)+sizeof(Nodo_A)*(vptr->grado_s-GRAFO_D_ADY_LOCAL);
+    return bytes;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Copia el vertice viejo y sus aristas al nodo nuevo de una region de destino, el llamador
+    asigna nuevo->sig. Las aristas que no caben en los nodos locales se colocan en un lote que
+    empieza en *lote_sig, que avanza hasta el final del lote. Las aristas conservan su orden y su
+    campo fin se copia sin cambios, sin GRAFO_D_IDS_32 el llamador debe traducirlo al nodo nuevo.
+    Si tr no es NULL se agregan a la tabla los pares del vertice y de sus aristas.
+*/
+static void _grafo_d_copiar_nodo_v(Grafo_D* destino, const Nodo_V* viejo, Nodo_V* nuevo,
+    char** lote_sig, Grafo_D_Traduccion* tr) {
+    nuevo->vt=viejo->vt;
+    nuevo->grado_s=viejo->grado_s;
+    nuevo->indice_ady=NULL;
+    nuevo->bloque=NULL;
+#ifdef GRAFO_D_IDS_32
+    nuevo->id=viejo->id;
+    destino->nodos_id[nuevo->id]=nuevo;
+#else
+    (void)destino;
+#endif
+    nuevo->libres=NULL;
+    nuevo->lotes=NULL;
+    _Lote_A* lote=NULL;
+    if(viejo->grado_s>GRAFO_D_ADY_LOCAL) {
+        lote=(_Lote_A*)*lote_sig;
+        lote->sig=NULL;
+        lote->capacidad=viejo->grado_s-GRAFO_D_ADY_LOCAL;
+        lote->en_region=true;
+        nuevo->lotes=lote;
+        *lote_sig+=sizeof(_Lote_A)+sizeof(Nodo_A)*lote->capacidad;
+    }
+#if GRAFO_D_ADY_LOCAL>0
+    for(size_t k=GRAFO_D_ADY_LOCAL; k>viejo->grado_s; --k) {
+        nuevo->ady_local[k-1].sig=nuevo->libres;
+        nuevo->libres=&(nuevo->ady_local[k-1]);
+    }
+#endif
+    Nodo_A** enlace=&(nuevo->lista_ady);
+    size_t k=0;
+    for(Nodo_A* aptr=viejo->lista_ady; aptr!=NULL; ++k, aptr=aptr->sig) {
+#if GRAFO_D_ADY_LOCAL>0
+        Nodo_A* copia=(k<GRAFO_D_ADY_LOCAL) ? &(nuevo->ady_local[k]) : &(lote->nodos[k-GRAFO_D_ADY_LOCAL]);
+#else
+        Nodo_A* copia=&(lote->nodos[k]);
+#endif
+        copia->ar=aptr->ar;
+        copia->fin=aptr->fin;
+        if(tr) {
+            tr->aristas[tr->num_aristas].anterior=(uintptr_t)&(aptr->ar);
+            tr->aristas[tr->num_aristas].nuevo=&(copia->ar);
+            ++(tr->num_aristas);
+        }
+        *enlace=copia;
+        enlace=&(copia->sig);
+    }
+    *enlace=NULL;
+    if(tr) {
+        tr->vertices[tr->num_vertices].anterior=(uintptr_t)&(viejo->vt);
+        tr->vertices[tr->num_vertices].nuevo=&(nuevo->vt);
+        ++(tr->num_vertices);
+    }
+    return;
+}
+
+/*  Reubica todos los vertices y aristas del grafo en una region contigua de memoria y regresa la
+    tabla de traduccion de los identificadores anteriores a los nuevos, que debe liberarse con
+    grafo_d_traduccion_destruir(). Si orden no es NULL debe contener a todos los vertices del grafo
+    exactamente una vez y la lista de vertices (y por lo tanto los ejes de las matrices) queda en
+    ese orden, de lo contrario se conserva el orden actual. Las aristas de cada vertice conservan
+    su orden. Si el grafo tiene un diario se crea un punto de control. Regresa NULL si orden no es
+    valido o no hubo memoria, en cuyo caso el grafo no se modifica. Si al terminar no hubo memoria
+    para reconstruir los indices hash el grafo se queda sin ellos, como en grafo_d_set_hash_vt().
+*/
+static Grafo_D_Traduccion* grafo_d_compactar(Grafo_D* grafo, const Vertice* const* orden) {
+    size_t n=grafo->orden, bytes_lotes=_grafo_d_bytes_lotes(grafo);
+    Grafo_D_Traduccion* tr=_grafo_d_crear_traduccion(n, grafo->tamano);
+    _Indice_V* indice=_grafo_d_crear_indice_v(grafo);
+    Nodo_V** viejos=(Nodo_V**)GRAFO_D_MALLOC(sizeof(Nodo_V*)*(n ? n : 1));
+    Nodo_V* nodos=(Nodo_V*)GRAFO_D_MALLOC(sizeof(Nodo_V)*(n ? n : 1));
+    //Los lotes se colocan uno tras otro, su tamano siempre es multiplo de su alineacion
+    char* lotes=(char*)GRAFO_D_MALLOC(bytes_lotes ? bytes_lotes : 1);
+    if(!tr || !indice || !viejos || !nodos || !lotes) goto error;
+
+    if(orden==NULL) {
+        Nodo_V* vptr=grafo->lista_ady;
+        for(size_t i=0; i<n; ++i, vptr=vptr->sig) viejos[i]=vptr;
+    }
+    else {
+        //Cada vertice de orden debe estar en el indice y aparecer una sola vez
+        for(size_t i=0; i<n; ++i) indice[i].pos=GD_NO_POSICION;
+        for(size_t i=0; i<n; ++i) {
+            uintptr_t clave=(uintptr_t)_GD_NODO_V(orden[i]);
+            size_t ini=0, fin=n;
+            while(ini<fin) {
+                size_t mitad=ini+(fin-ini)/2;
+                if(indice[mitad].nodo<clave) ini=mitad+1;
+                else fin=mitad;
+            }
+            if(ini==n || indice[ini].nodo!=clave || indice[ini].pos!=GD_NO_POSICION) goto error;
+            indice[ini].pos=i;
+            viejos[i]=(Nodo_V*)clave;
+        }
+    }
+
+    char* lote_sig=lotes;
+    for(size_t i=0; i<n; ++i) {
+        nodos[i].sig=(i+1<n) ? &(nodos[i+1]) : NULL;
+        _grafo_d_copiar_nodo_v(grafo, viejos[i], &(nodos[i]), &lote_sig, tr);
+    }
+#ifndef GRAFO_D_IDS_32
+    for(size_t i=0; i<n; ++i)
+        for(Nodo_A* aptr=nodos[i].lista_ady; aptr!=NULL; aptr=aptr->sig)
+            aptr->fin=&(nodos[_grafo_d_pos_indice_v(indice, n, aptr->fin)]);
+#endif
+
+    //Se liberan los nodos anteriores y la region de la compactacion anterior
+    for(size_t i=0; i<n; ++i) {
+        if(viejos[i]->indice_ady) _tabla_h_destruir(viejos[i]->indice_ady);
+        _grafo_d_liberar_aristas(viejos[i]);
+        _grafo_d_liberar_nodo_v(grafo, viejos[i]);
+    }
+    GRAFO_D_FREE(grafo->region_v);
+    GRAFO_D_FREE(grafo->region_a);
+    grafo->region_v=nodos;
+    grafo->region_orden=n;
+    grafo->region_a=lotes;
+    grafo->region_bytes_a=bytes_lotes;
+    grafo->lista_ady=n ? &(nodos[0]) : NULL;
+    grafo->lista_fin=n ? &(nodos[n-1]) : NULL;
+    GRAFO_D_FREE(indice);
+    GRAFO_D_FREE(viejos);
+
+    qsort(tr->vertices, tr->num_vertices, sizeof(_Par_Traduccion), _cmp_par_traduccion);
+    qsort(tr->aristas, tr->num_aristas, sizeof(_Par_Traduccion), _cmp_par_traduccion);
+    _grafo_d_reindexar(grafo, tr);
+    if(grafo->diario && !_grafo_d_diario_checkpoint(grafo)) grafo->diario->error=true;
+    return tr;
+
+error:
+    if(tr) grafo_d_traduccion_destruir(tr);
+    GRAFO_D_FREE(indice); GRAFO_D_FREE(viejos); GRAFO_D_FREE(nodos); GRAFO_D_FREE(lotes);
+    return NULL;
+}
+
+/*----------------------------------Clonacion del Grafo-------------------------------------*/
+
+/*  grafo_d_clonar() crea una copia independiente de un grafo, por ejemplo para evaluar
+    escenarios sobre una red sin modificar la original. La copia no inserta los vertices y
+    aristas uno por uno: se reservan de una sola vez en una region con el mismo formato que la de
+    grafo_d_compactar(), por lo que el tiempo es proporcional al numero de vertices mas el de
+    aristas y el clon queda compactado.
+*/
+
+#ifndef GRAFO_D_IDS_32
+/*  !!!FUNCION DE USO INTERNO!!!
+    Busca en una tabla con direccionamiento abierto, cuya capacidad es potencia de 2, la entrada
+    del nodo anterior, o la entrada vacia en la que debe insertarse
+*/
+static _Par_Traduccion* _gd_mapa_nodo(_Par_Traduccion* mapa, size_t capacidad, const Nodo_V* anterior) {
+    size_t i=_gd_hash_ptr(anterior)&(capacidad-1);
+    while(mapa[i].anterior!=0 && mapa[i].anterior!=(uintptr_t)anterior) i=(i+1)&(capacidad-1);
+    return &(mapa[i]);
+}
+#endif
+
+/*  Crea una copia del grafo con los mismos vertices, aristas, funciones de comparacion, de peso
+    y hash, e identificadores numericos si se definio GRAFO_D_IDS_32. Los datos de tipo Vertice y
+    Arista se copian por valor; si contienen apuntadores ambos grafos comparten lo apuntado. La
+    lista de vertices y las aristas de cada vertice quedan en el mismo orden. El diario y las
+    versiones del grafo no se copian. Si tr no es NULL en *tr se guarda la tabla de traduccion de
+    los identificadores del grafo a los del clon, que debe liberarse con
+    grafo_d_traduccion_destruir(); construirla requiere ordenarla, si no se necesita conviene
+    pasar NULL. Si el grafo tiene indice hash de aristas la tabla se construye de todos modos para
+    copiar el indice con el mismo orden. Regresa NULL si no hubo memoria, en cuyo caso *tr
+    tambien es NULL.
+*/
+static Grafo_D* grafo_d_clonar(const Grafo_D* grafo, Grafo_D_Traduccion** tr) {
+    size_t n=grafo->orden, bytes_lotes=_grafo_d_bytes_lotes(grafo);
+    Grafo_D_Traduccion* tabla=NULL;
+    if(tr) *tr=NULL;
+    Grafo_D* clon=grafo_d_crear();
+    if(!clon) return NULL;
+    Nodo_V* nodos=(Nodo_V*)GRAFO_D_MALLOC(sizeof(Nodo_V)*(n ? n : 1));
+    char* lotes=(char*)GRAFO_D_MALLOC(bytes_lotes ? bytes_lotes : 1);
+    if(!nodos || !lotes) {
+        GRAFO_D_FREE(nodos); GRAFO_D_FREE(lotes);
+        goto error;
+    }
+    //A partir de aqui grafo_d_destruir() libera la region aunque el clon aun no este completo
+    clon->region_v=nodos;
+    clon->region_orden=n;
+    clon->region_a=lotes;
+    clon->region_bytes_a=bytes_lotes;
+    if((tr || grafo->indice_ar) && !(tabla=_grafo_d_crear_traduccion(n, grafo->tamano))) goto error;
+#ifdef GRAFO_D_IDS_32
+    if(grafo->capacidad_ids) {
+        clon->nodos_id=(Nodo_V**)GRAFO_D_CALLOC(grafo->capacidad_ids, sizeof(Nodo_V*));
+        clon->ids_libres=(uint32_t*)GRAFO_D_MALLOC(sizeof(uint32_t)*grafo->capacidad_ids);
+        if(!clon->nodos_id || !clon->ids_libres) goto error;
+        memcpy(clon->ids_libres, grafo->ids_libres, sizeof(uint32_t)*grafo->num_libres);
+        clon->num_ids=grafo->num_ids;
+        clon->num_libres=grafo->num_libres;
+        clon->capacidad_ids=grafo->capacidad_ids;
+    }
+#else
+    //Tabla de los nodos del grafo a los del clon para traducir el fin de las aristas
+    size_t capacidad=16;
+    while(capacidad<2*n) capacidad<<=1;
+    _Par_Traduccion* mapa=(_Par_Traduccion*)GRAFO_D_CALLOC(capacidad, sizeof(_Par_Traduccion));
+    if(!mapa) goto error;
+#endif
+
+    char* lote_sig=lotes;
+    const Nodo_V* viejo=grafo->lista_ady;
+    for(size_t i=0; i<n; ++i, viejo=viejo->sig) {
+        nodos[i].sig=(i+1<n) ? &(nodos[i+1]) : NULL;
+        _grafo_d_copiar_nodo_v(clon, viejo, &(nodos[i]), &lote_sig, tabla);
+#ifndef GRAFO_D_IDS_32
+        _Par_Traduccion* par=_gd_mapa_nodo(mapa, capacidad, viejo);
+        par->anterior=(uintptr_t)viejo;
+        par->nuevo=&(nodos[i]);
+#endif
+    }
+#ifndef GRAFO_D_IDS_32
+    for(size_t i=0; i<n; ++i)
+        for(Nodo_A* aptr=nodos[i].lista_ady; aptr!=NULL; aptr=aptr->sig)
+            aptr->fin=(Nodo_V*)_gd_mapa_nodo(mapa, capacidad, aptr->fin)->nuevo;
+    GRAFO_D_FREE(mapa);
+#endif
+    clon->lista_ady=n ? &(nodos[0]) : NULL;
+    clon->lista_fin=n ? &(nodos[n-1]) : NULL;
+    clon->orden=n;
+    clon->tamano=grafo->tamano;
+    clon->cmp_vt=grafo->cmp_vt;
+    clon->cmp_ar=grafo->cmp_ar;
+    clon->calc_peso=grafo->calc_peso;
+
+    for(size_t i=0; i<n; ++i)
+        if(nodos[i].lista_ady!=NULL) _grafo_d_ady_agregar(&(nodos[i]), nodos[i].lista_ady);
+    if(grafo->indice_vt && !grafo_d_set_hash_vt(clon, grafo->hash_vt)) goto error;
+    if(tabla) {
+        qsort(tabla->vertices, tabla->num_vertices, sizeof(_Par_Traduccion), _cmp_par_traduccion);
+        qsort(tabla->aristas, tabla->num_aristas, sizeof(_Par_Traduccion), _cmp_par_traduccion);
+    }
+    if(grafo->indice_ar && !_grafo_d_trasladar_indice_ar(clon, grafo->indice_ar, grafo->hash_ar, tabla))
+        goto error;
+    if(tr) *tr=tabla;
+    else if(tabla) grafo_d_traduccion_destruir(tabla);
+    return clon;
+
+error:
+    if(tabla) grafo_d_traduccion_destruir(tabla);
+    grafo_d_destruir(clon);
+    return NULL;
+}
+
+/*-------------------------------Reordenamiento de Vertices---------------------------------*/
+
+/*  El orden de la lista de vertices determina las posiciones de los vertices en las matrices,
+    las versiones, el formato binario y el grafo comprimido, y con la compactacion tambien su
+    posicion en memoria. Un orden en el que los vecinos quedan cerca reduce los fallos de cache
+    al recorrer el grafo y el tamano del grafo comprimido. grafo_d_calcular_orden() calcula un
+    orden con alguno de los metodos siguientes, considerando las aristas sin direccion:
+    - GD_ORDEN_BFS: recorrido en amplitud de cada componente, en el orden de la lista.
+    - GD_ORDEN_RCM: Cuthill-McKee inverso, recorrido en amplitud desde el vertice de menor grado
+      visitando a los vecinos de menor a mayor grado y al final invirtiendo el orden. Suele dar
+      el menor ancho de banda.
+    - GD_ORDEN_GRADO: de mayor a menor grado, agrupa a los vertices mas visitados.
+    - GD_ORDEN_GORDER: heuristica voraz que coloca a continuacion el vertice que comparte mas
+      vecinos o aristas con los ultimos GD_GORDER_VENTANA vertices colocados.
+    grafo_d_reordenar() calcula el orden y lo aplica con grafo_d_compactar(). Las versiones, los
+    grafos comprimidos y los archivos binarios creados despues de reordenar usan el nuevo orden.
+*/
+
+#define GD_ORDEN_BFS 0
+#define GD_ORDEN_RCM 1
+#define GD_ORDEN_GRADO 2
+#define GD_ORDEN_GORDER 3
+
+#define GD_GORDER_VENTANA 5
+//Los vecinos de vertices con grado mayor no se consideran como vecinos compartidos
+#define _GD_GORDER_GRADO_MAX 256
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Crea la lista de adyacencia sin direccion del grafo en forma CSR por posiciones: los vecinos
+    del vertice i son destinos[indices[i]] a destinos[indices[i+1]-1]. Regresa falso si no hubo
+    memoria.
+*/
+static bool _grafo_d_csr_simetrico(const Grafo_D* grafo, size_t** indices, size_t** destinos) {
+    size_t n=grafo->orden;
+    _Indice_V* indice=_grafo_d_crear_indice_v(grafo);
+    size_t* ind=(size_t*)GRAFO_D_CALLOC(n+1, sizeof(size_t));
+    size_t* dst=(size_t*)GRAFO_D_MALLOC(sizeof(size_t)*(grafo->tamano ? 2*grafo->tamano : 1));
+    if(!indice || !ind || !dst) {
+        GRAFO_D_FREE(indice); GRAFO_D_FREE(ind); GRAFO_D_FREE(dst);
+        return false;
+    }
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; aptr!=NULL; aptr=aptr->sig) {
+            ++(ind[i+1]);
+            ++(ind[_grafo_d_pos_indice_v(indice, n, _GD_FIN(grafo, aptr))+1]);
+        }
+    for(size_t i=0; i<n; ++i) ind[i+1]+=ind[i];
+    //ind[i] avanza mientras se llena y al final queda en el inicio de i+1
+    vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; aptr!=NULL; aptr=aptr->sig) {
+            size_t j=_grafo_d_pos_indice_v(indice, n, _GD_FIN(grafo, aptr));
+            dst[ind[i]++]=j;
+            dst[ind[j]++]=i;
+        }
+    for(size_t i=n; i>0; --i) ind[i]=ind[i-1];
+    ind[0]=0;
+    GRAFO_D_FREE(indice);
+    *indices=ind;
+    *destinos=dst;
+    return true;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Regresa el ancho de banda de la lista CSR si el vertice i se coloca en la posicion pos[i], o
+    en la posicion i si pos es NULL
+*/
+static size_t _gd_ancho_banda(size_t n, const size_t* indices, const size_t* destinos, const size_t* pos) {
+    size_t ancho=0;
+    for(size_t i=0; i<n; ++i)
+        for(size_t a=indices[i]; a<indices[i+1]; ++a) {
+            size_t p=pos ? pos[i] : i, q=pos ? pos[destinos[a]] : destinos[a];
+            size_t d=p>q ? p-q : q-p;
+            if(d>ancho) ancho=d;
+        }
+    return ancho;
+}
+
+//  !!!ESTRUCTURA DE USO INTERNO!!!
+typedef struct _grado_p {
+    size_t grado;
+    size_t pos;
+} _Grado_P;
 
 /*  !!!FUNCION DE USO INTERNO!!!
-    Busca en la lista de Nodos_C el Nodo_C que hace referencia a el Nodo_V
-    pasado como segundo argumento.
+    Ordenan un arreglo de _Grado_P por grado ascendente o descendente, a igual grado por posicion
 */
-static _Nodo_C* _get_nodo_c_vertice(_Nodo_C* cptr, Nodo_V* vt) {
-    while(cptr!=NULL) {
-        if(cptr->vt_actual==vt) return cptr;
-        cptr=cptr->sig;
+static int _cmp_grado_asc(const void* a, const void* b) {
+    const _Grado_P* x=(const _Grado_P*)a, *y=(const _Grado_P*)b;
+    if(x->grado!=y->grado) return (x->grado>y->grado)-(x->grado<y->grado);
+    return (x->pos>y->pos)-(x->pos<y->pos);
+}
+
+static int _cmp_grado_desc(const void* a, const void* b) {
+    const _Grado_P* x=(const _Grado_P*)a, *y=(const _Grado_P*)b;
+    if(x->grado!=y->grado) return (x->grado<y->grado)-(x->grado>y->grado);
+    return (x->pos>y->pos)-(x->pos<y->pos);
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Escribe en salida las posiciones de los vertices de la lista CSR ordenadas por grado
+*/
+static bool _gd_ordenar_por_grado(size_t n, const size_t* indices, bool descendente, size_t* salida) {
+    _Grado_P* pares=(_Grado_P*)GRAFO_D_MALLOC(sizeof(_Grado_P)*(n ? n : 1));
+    if(!pares) return false;
+    for(size_t i=0; i<n; ++i) {
+        pares[i].grado=indices[i+1]-indices[i];
+        pares[i].pos=i;
     }
-    return NULL;
+    qsort(pares, n, sizeof(_Grado_P), descendente ? _cmp_grado_desc : _cmp_grado_asc);
+    for(size_t i=0; i<n; ++i) salida[i]=pares[i].pos;
+    GRAFO_D_FREE(pares);
+    return true;
 }
 
 /*  !!!FUNCION DE USO INTERNO!!!
-    Busca en la lista de Nodos_C el Nodo_C con el valor de dist_orig minimo 
-    (y finito) en toda la lista.
+    Reescribe destinos para que los vecinos de cada vertice queden de menor a mayor grado,
+    recorriendo los vertices en ese orden (por_grado) y agregandolos a la lista de sus vecinos
 */
-static _Nodo_C* _get_nodo_c_minimo(_Nodo_C* cptr) {
-    _Nodo_C* minimo = cptr;
-    while(cptr!=NULL) {
-        if(cptr->dist_orig < minimo->dist_orig)
-            minimo=cptr;
-        cptr=cptr->sig;
+static bool _gd_vecinos_por_grado(size_t n, const size_t* indices, size_t* destinos, const size_t* por_grado) {
+    size_t m=indices[n];
+    size_t* nuevos=(size_t*)GRAFO_D_MALLOC(sizeof(size_t)*(m ? m : 1));
+    size_t* sig=(size_t*)GRAFO_D_MALLOC(sizeof(size_t)*(n ? n : 1));
+    if(!nuevos || !sig) {
+        GRAFO_D_FREE(nuevos); GRAFO_D_FREE(sig);
+        return false;
     }
-    if(minimo->dist_orig!=PESO_NO_ARISTA)
-        return minimo;
-    return NULL;
+    memcpy(sig, indices, sizeof(size_t)*n);
+    for(size_t k=0; k<n; ++k) {
+        size_t u=por_grado[k];
+        for(size_t a=indices[u]; a<indices[u+1]; ++a) nuevos[sig[destinos[a]]++]=u;
+    }
+    memcpy(destinos, nuevos, sizeof(size_t)*m);
+    GRAFO_D_FREE(nuevos); GRAFO_D_FREE(sig);
+    return true;
 }
 
 /*  !!!FUNCION DE USO INTERNO!!!
-    Libera el espacio de memoria de la lista de Nodos_C apuntada por
-    el puntero cptr. cptr debe ser la cabeza de la lista para evitar
-    perdida de memoria
+    Recorrido en amplitud de todas las componentes, tomando las raices en el orden de raices
 */
-static void _liberar_lista_c(_Nodo_C* cptr) {
-    _Nodo_C* ctmp;
-    while(cptr!=NULL) {
-        ctmp=cptr;
-        cptr=cptr->sig;
-        free(ctmp);
+static void _gd_orden_bfs(size_t n, const size_t* indices, const size_t* destinos, const size_t* raices,
+    bool* visitado, size_t* orden) {
+    size_t fin=0;
+    for(size_t r=0; r<n; ++r) {
+        if(visitado[raices[r]]) continue;
+        size_t ini=fin;
+        orden[fin++]=raices[r];
+        visitado[raices[r]]=true;
+        while(ini<fin) {
+            size_t u=orden[ini++];
+            for(size_t a=indices[u]; a<indices[u+1]; ++a)
+                if(!visitado[destinos[a]]) {
+                    visitado[destinos[a]]=true;
+                    orden[fin++]=destinos[a];
+                }
+        }
     }
-    return;
 }
 
-typedef struct camino_d {
-    Vertice** vts;
-    Arista** ars;
-    size_t saltos;
-    peso_t longitud;
-} Camino_D;
+//  !!!ESTRUCTURA DE USO INTERNO!!!
+typedef struct _entrada_g {
+    size_t clave;
+    size_t v;
+} _Entrada_G;
 
-static inline bool es_camino_valido(Camino_D* camino) {
-    return camino->vts!=NULL;
+/*  !!!FUNCION DE USO INTERNO!!!
+    Cambia en delta la clave del vertice v de la heuristica Gorder y agrega una entrada con la
+    nueva clave al monticulo de maximos. Las entradas cuya clave ya no coincide se descartan al
+    extraerlas.
+*/
+static bool _gd_gorder_cambiar(size_t v, long delta, size_t* clave, const bool* colocado,
+    _Entrada_G** mont, size_t* tam, size_t* cap) {
+    if(colocado[v]) return true;
+    clave[v]=(size_t)((long)clave[v]+delta);
+    if(clave[v]==0) return true;
+    if(*tam==*cap) {
+        size_t nueva=*cap ? 2*(*cap) : 64;
+        _Entrada_G* tmp=(_Entrada_G*)GRAFO_D_REALLOC(*mont, sizeof(_Entrada_G)*nueva);
+        if(!tmp) return false;
+        *mont=tmp;
+        *cap=nueva;
+    }
+    _Entrada_G* m=*mont;
+    size_t i=(*tam)++;
+    while(i>0 && m[(i-1)/2].clave<clave[v]) {
+        m[i]=m[(i-1)/2];
+        i=(i-1)/2;
+    }
+    m[i].clave=clave[v];
+    m[i].v=v;
+    return true;
 }
 
-/*  Libera la memoria reservada para el camino que se pasa como argumento
-    de la funcion. El puntero que apuntaba al camino se vuelve invalido
-    despues de esta operacion.
+/*  !!!FUNCION DE USO INTERNO!!!
+    Suma delta a la clave de los vecinos de u y a la de los vecinos de sus vecinos
 */
-static void camino_d_destruir(Camino_D* camino) {
-    if(camino->vts) free(camino->vts);
-    if(camino->ars) free(camino->ars);
-    free(camino);
-    return;
+static bool _gd_gorder_ventana(size_t u, long delta, const size_t* indices, const size_t* destinos,
+    size_t* clave, const bool* colocado, _Entrada_G** mont, size_t* tam, size_t* cap) {
+    for(size_t a=indices[u]; a<indices[u+1]; ++a) {
+        size_t x=destinos[a];
+        if(!_gd_gorder_cambiar(x, delta, clave, colocado, mont, tam, cap)) return false;
+        if(indices[x+1]-indices[x]>_GD_GORDER_GRADO_MAX) continue;
+        for(size_t b=indices[x]; b<indices[x+1]; ++b)
+            if(destinos[b]!=u && !_gd_gorder_cambiar(destinos[b], delta, clave, colocado, mont, tam, cap))
+                return false;
+    }
+    return true;
 }
 
-/*  Encuentra el camino mas corto entre el vertice ini y fin utilizando el algoritmo
-    de Dijkstra. El camino se regresa como un struct tipo Camino_D dinamicamente almacenado
-    en memoria y por lo tanto debera de liberarse utilizando la funcion camino_d_destruir.
-    En caso de error la funcion regresa NULL. En caso de que no exista ningun camino entre
-    el los vertice ini y fin, la funcion regresa un camino invalido, no NULL, e igualmente
-    debera ser liberado usando camino_d_destruir. 
+/*  !!!FUNCION DE USO INTERNO!!!
+    Heuristica Gorder: coloca en cada paso el vertice con mayor clave, que cuenta las aristas y
+    los vecinos compartidos con los ultimos GD_GORDER_VENTANA vertices colocados. Si ningun
+    vertice tiene clave se toma el siguiente de mayor grado.
 */
-static Camino_D* grafo_d_dijkstra(const Grafo_D* grafo, const Vertice* ini, const Vertice* fin) {
-    if(!grafo->calc_peso) return NULL;
-
-    Nodo_V* vptr; Nodo_A* aptr; _Nodo_C* cptr;
-    _Nodo_C* visitados=NULL;
-    _Nodo_C* no_visitados=NULL;
-    vptr=grafo->lista_ady;
-    //Inicializamos listas de visitados y no visitados
-    while(vptr!=NULL) {
-        cptr=(_Nodo_C*)malloc(sizeof(_Nodo_C));
-        if(!cptr) {
-            _liberar_lista_c(visitados);
-            _liberar_lista_c(no_visitados);
-            return NULL;
-        }
-        if(ini!=&(vptr->vt)) {
-            cptr->sig=no_visitados;
-            cptr->vt_actual=vptr;
-            cptr->ar_puente=NULL;
-            cptr->nd_padre=NULL;
-            cptr->dist_orig=PESO_NO_ARISTA;
-            no_visitados=cptr;
+static bool _gd_orden_gorder(size_t n, const size_t* indices, const size_t* destinos, const size_t* por_grado,
+    bool* colocado, size_t* orden) {
+    size_t* clave=(size_t*)GRAFO_D_CALLOC(n ? n : 1, sizeof(size_t));
+    _Entrada_G* mont=NULL;
+    size_t tam=0, cap=0, sig_grado=0;
+    bool ok=clave!=NULL;
+    for(size_t i=0; ok && i<n; ++i) {
+        size_t u=GD_NO_POSICION;
+        while(tam>0) {
+            _Entrada_G tope=mont[0];
+            //Se extrae la raiz del monticulo de maximos
+            _Entrada_G ultimo=mont[--tam];
+            size_t k=0;
+            while(2*k+1<tam) {
+                size_t hijo=2*k+1;
+                if(hijo+1<tam && mont[hijo+1].clave>mont[hijo].clave) ++hijo;
+                if(!(mont[hijo].clave>ultimo.clave)) break;
+                mont[k]=mont[hijo];
+                k=hijo;
+            }
+            if(tam>0) mont[k]=ultimo;
+            if(!colocado[tope.v] && clave[tope.v]==tope.clave) {u=tope.v; break;}
         }
-        else {
-            cptr->sig=NULL;
-            cptr->vt_actual=vptr;
-            cptr->ar_puente=NULL;
-            cptr->nd_padre=NULL;
-            cptr->dist_orig=0;
-            visitados=cptr;
+        if(u==GD_NO_POSICION) {
+            while(colocado[por_grado[sig_grado]]) ++sig_grado;
+            u=por_grado[sig_grado];
         }
-        vptr=vptr->sig;
+        colocado[u]=true;
+        orden[i]=u;
+        ok=_gd_gorder_ventana(u, 1, indices, destinos, clave, colocado, &mont, &tam, &cap);
+        if(ok && i>=GD_GORDER_VENTANA)
+            ok=_gd_gorder_ventana(orden[i-GD_GORDER_VENTANA], -1, indices, destinos, clave, colocado, &mont, &tam, &cap);
     }
+    GRAFO_D_FREE(clave);
+    GRAFO_D_FREE(mont);
+    return ok;
+}
 
-    /*----------------Parte Iterativa----------------
-        Ejecutamos Dijkstra hasta encontrar el camino
-        mas corto hasta el vertice fin */
-    _Nodo_C* nodo_ref = visitados;
-    while(fin!=&(nodo_ref->vt_actual->vt)) {
-
-        //Para cada arista de salida del vertice
-        aptr = nodo_ref->vt_actual->lista_ady;
-        while(aptr!=NULL) {
-            _Nodo_C* nodo_fin = _get_nodo_c_vertice(no_visitados, aptr->fin);
-            if(nodo_fin!=NULL) {
-                peso_t dp=nodo_ref->dist_orig+grafo->calc_peso(&(aptr->ar));
-                if(dp < nodo_fin->dist_orig) {
-                    nodo_fin->dist_orig = dp;
-                    nodo_fin->nd_padre  = nodo_ref;
-                    nodo_fin->ar_puente = aptr;
+/*  Regresa un arreglo almacenado dinamicamente de grafo->orden elementos con el orden calculado
+    con el metodo indicado (GD_ORDEN_...): el elemento i es la posicion actual en la lista de
+    vertices del vertice que debe quedar en la posicion i. Debe liberarse con una llamada a
+    GRAFO_D_FREE(). Regresa NULL si el metodo no es valido o no hubo memoria.
+*/
+static size_t* grafo_d_calcular_orden(const Grafo_D* grafo, int metodo) {
+    size_t n=grafo->orden;
+    size_t* indices=NULL, *destinos=NULL;
+    size_t* orden=(size_t*)GRAFO_D_MALLOC(sizeof(size_t)*(n ? n : 1));
+    size_t* por_grado=(size_t*)GRAFO_D_MALLOC(sizeof(size_t)*(n ? n : 1));
+    bool* marcado=(bool*)GRAFO_D_CALLOC(n ? n : 1, sizeof(bool));
+    bool ok=orden && por_grado && marcado && metodo>=GD_ORDEN_BFS && metodo<=GD_ORDEN_GORDER
+        && _grafo_d_csr_simetrico(grafo, &indices, &destinos);
+    if(ok) {
+        switch(metodo) {
+            case GD_ORDEN_BFS:
+                for(size_t i=0; i<n; ++i) por_grado[i]=i;
+                _gd_orden_bfs(n, indices, destinos, por_grado, marcado, orden);
+                break;
+            case GD_ORDEN_RCM:
+                ok=_gd_ordenar_por_grado(n, indices, false, por_grado)
+                    && _gd_vecinos_por_grado(n, indices, destinos, por_grado);
+                if(!ok) break;
+                _gd_orden_bfs(n, indices, destinos, por_grado, marcado, orden);
+                for(size_t i=0; i<n/2; ++i) {
+                    size_t tmp=orden[i];
+                    orden[i]=orden[n-1-i];
+                    orden[n-1-i]=tmp;
                 }
-            }
-            aptr=aptr->sig;
+                break;
+            case GD_ORDEN_GRADO:
+                ok=_gd_ordenar_por_grado(n, indices, true, orden);
+                break;
+            case GD_ORDEN_GORDER:
+                ok=_gd_ordenar_por_grado(n, indices, true, por_grado)
+                    && _gd_orden_gorder(n, indices, destinos, por_grado, marcado, orden);
+                break;
         }
+    }
+    GRAFO_D_FREE(indices); GRAFO_D_FREE(destinos); GRAFO_D_FREE(por_grado); GRAFO_D_FREE(marcado);
+    if(!ok) {
+        GRAFO_D_FREE(orden);
+        return NULL;
+    }
+    return orden;
+}
 
-        //Acualizar nodo_ref
-        nodo_ref = _get_nodo_c_minimo(no_visitados);
+/*  Regresa el ancho de banda del grafo, la mayor distancia entre las posiciones en la lista de
+    vertices de los extremos de una arista, o GD_NO_POSICION si no hubo memoria
+*/
+static size_t grafo_d_ancho_banda(const Grafo_D* grafo) {
+    size_t* indices, *destinos;
+    if(!_grafo_d_csr_simetrico(grafo, &indices, &destinos)) return GD_NO_POSICION;
+    size_t ancho=_gd_ancho_banda(grafo->orden, indices, destinos, NULL);
+    GRAFO_D_FREE(indices); GRAFO_D_FREE(destinos);
+    return ancho;
+}
 
-        //Si no existen vertices alcanzables regresamos un camino invalido
-        if(nodo_ref==NULL) {
-            _liberar_lista_c(visitados);
-            _liberar_lista_c(no_visitados);
-            Camino_D* camino=(Camino_D*)malloc(sizeof(Camino_D));
-            if(!camino) return NULL;
-            camino->vts=NULL; camino->ars=NULL;
-            camino->saltos=0; camino->longitud=0;
-            return camino;
-        };
+/*  Reordena la lista de vertices con el metodo indicado (GD_ORDEN_...) y compacta el grafo en el
+    nuevo orden con grafo_d_compactar(), cuya tabla de traduccion regresa. Si ancho_antes o
+    ancho_despues no son NULL se escribe en ellos el ancho de banda del grafo antes y despues de
+    reordenarlo. Regresa NULL si el metodo no es valido o no hubo memoria, en cuyo caso el grafo
+    no se modifica.
+*/
+static Grafo_D_Traduccion* grafo_d_reordenar(Grafo_D* grafo, int metodo, size_t* ancho_antes, size_t* ancho_despues) {
+    size_t n=grafo->orden;
+    size_t* orden=grafo_d_calcular_orden(grafo, metodo);
+    const Vertice** vertices=(const Vertice**)GRAFO_D_MALLOC(sizeof(Vertice*)*(n ? n : 1));
+    size_t* pos=(size_t*)GRAFO_D_MALLOC(sizeof(size_t)*(n ? n : 1));
+    size_t* indices=NULL, *destinos=NULL;
+    Grafo_D_Traduccion* tr=NULL;
+    if(!orden || !vertices || !pos) goto salir;
+    if(ancho_antes || ancho_despues) {
+        if(!_grafo_d_csr_simetrico(grafo, &indices, &destinos)) goto salir;
+        for(size_t i=0; i<n; ++i) pos[orden[i]]=i;
+        if(ancho_antes) *ancho_antes=_gd_ancho_banda(n, indices, destinos, NULL);
+        if(ancho_despues) *ancho_despues=_gd_ancho_banda(n, indices, destinos, pos);
+    }
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig) pos[i]=(size_t)(uintptr_t)&(vptr->vt);
+    for(size_t i=0; i<n; ++i) vertices[i]=(const Vertice*)(uintptr_t)pos[orden[i]];
+    tr=grafo_d_compactar(grafo, vertices);
 
-        //Pasar nuevo nodo_ref de no_visitados a visitados
-        if(nodo_ref==no_visitados) {
-            no_visitados=no_visitados->sig;
-            nodo_ref->sig=visitados;
-            visitados=nodo_ref;
+salir:
+    GRAFO_D_FREE(orden); GRAFO_D_FREE(vertices); GRAFO_D_FREE(pos); GRAFO_D_FREE(indices); GRAFO_D_FREE(destinos);
+    return tr;
+}
+
+/*---------------------------------Medicion de Memoria------------------------------------*/
+
+/*  Las funciones de esta seccion calculan cuanta memoria ocupa cada estructura sin modificarla.
+    Para un grafo solo se recorren los vertices, sus lotes y sus nodos libres, nunca las aristas,
+    de modo que pueden llamarse con frecuencia, por ejemplo desde un servicio de monitoreo. Las
+    cantidades son bytes solicitados al asignador de memoria; el espacio que este agrega a cada
+    bloque depende de la implementacion, se puede estimar multiplicando el campo reservas por su
+    sobrecarga por bloque (16 bytes en glibc de 64 bits).
+*/
+
+/*  Desglose de la memoria de una estructura. total es la suma de los cinco primeros campos.*/
+typedef struct grafo_d_memoria {
+    size_t vertices;            //Nodos de vertice, sin contar los datos de tipo Vertice
+    size_t aristas;             //Nodos de arista en uso y encabezados de lotes, sin los datos de tipo Arista
+    size_t datos;               //Datos de tipo Vertice y Arista guardados
+    size_t indices;             //Tablas hash, tablas de identificadores, diario y arreglos auxiliares
+    size_t holgura;             //Espacio reservado sin usar: nodos libres y huecos de la compactacion
+    size_t total;
+    size_t reservas;            //Numero de bloques reservados por separado
+    size_t compartido;          //Parte de total compartida con otras versiones o con el grafo
+} Grafo_D_Memoria;
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Suma al desglose la memoria de una tabla hash
+*/
+static void _gd_memoria_tabla(const _Tabla_H* tabla, Grafo_D_Memoria* mem) {
+    if(tabla==NULL) return;
+    mem->indices+=sizeof(_Tabla_H)+2*sizeof(_Nodo_H*)*tabla->capacidad+sizeof(_Nodo_H)*tabla->elementos;
+    mem->reservas+=3+tabla->elementos;
+}
+
+/*  !!!FUNCION DE USO INTERNO!!!
+    Calcula el total del desglose
+*/
+static inline void _gd_memoria_total(Grafo_D_Memoria* mem) {
+    mem->total=mem->vertices+mem->aristas+mem->datos+mem->indices+mem->holgura;
+}
+
+/*  Regresa el desglose de la memoria que ocupa el grafo, incluyendo sus indices hash, sus
+    identificadores numericos y su diario. La version reciente que el grafo retiene no se incluye,
+    se mide con grafo_d_version_memoria().
+*/
+static Grafo_D_Memoria grafo_d_memoria(const Grafo_D* grafo) {
+    Grafo_D_Memoria mem={0, 0, 0, 0, 0, 0, 0, 0};
+    size_t en_region=0, lotes_region=0;
+    mem.indices+=sizeof(Grafo_D);
+    mem.reservas+=1;
+    mem.datos+=sizeof(Vertice)*grafo->orden+sizeof(Arista)*grafo->tamano;
+    mem.aristas+=(sizeof(Nodo_A)-sizeof(Arista))*grafo->tamano;
+    for(const Nodo_V* vptr=grafo->lista_ady; vptr!=NULL; vptr=vptr->sig) {
+        //Los nodos locales forman parte del nodo del vertice y se cuentan como aristas o libres
+        mem.vertices+=sizeof(Nodo_V)-sizeof(Vertice)-sizeof(Nodo_A)*GRAFO_D_ADY_LOCAL;
+        uintptr_t dir=(uintptr_t)vptr;
+        if(dir>=(uintptr_t)grafo->region_v && dir<(uintptr_t)(grafo->region_v+grafo->region_orden)) ++en_region;
+        else ++(mem.reservas);
+        size_t capacidad=GRAFO_D_ADY_LOCAL, libres=0;
+        for(const _Lote_A* lote=vptr->lotes; lote!=NULL; lote=lote->sig) {
+            capacidad+=lote->capacidad;
+            mem.aristas+=sizeof(_Lote_A);
+            if(lote->en_region) lotes_region+=sizeof(_Lote_A)+sizeof(Nodo_A)*lote->capacidad;
+            else ++(mem.reservas);
         }
-        else {
-            cptr=no_visitados;
-            while(cptr->sig!=nodo_ref)
-                cptr=cptr->sig;
-            cptr->sig=nodo_ref->sig;
-            nodo_ref->sig=visitados;
-            visitados=nodo_ref;
+        for(const Nodo_A* aptr=vptr->libres; aptr!=NULL; aptr=aptr->sig) ++libres;
+        mem.holgura+=sizeof(Nodo_A)*libres;
+        //Las aristas que no estan en los nodos propios se reservaron una por una
+        mem.reservas+=vptr->grado_s-(capacidad-libres);
+        _gd_memoria_tabla(vptr->indice_ady, &mem);
+    }
+    //Espacio de la region que dejaron los vertices eliminados despues de compactar
+    mem.holgura+=sizeof(Nodo_V)*(grafo->region_orden-en_region)+(grafo->region_bytes_a-lotes_region);
+    if(grafo->region_v) mem.reservas+=2;
+    _gd_memoria_tabla(grafo->indice_vt, &mem);
+    _gd_memoria_tabla(grafo->indice_ar, &mem);
+#ifdef GRAFO_D_IDS_32
+    if(grafo->capacidad_ids) {
+        mem.indices+=(sizeof(Nodo_V*)+sizeof(uint32_t))*grafo->capacidad_ids;
+        mem.reservas+=2;
+    }
+#endif
+    if(grafo->diario) {
+        const _Diario* diario=grafo->diario;
+        mem.indices+=sizeof(_Diario)+strlen(diario->ruta)+1+sizeof(Nodo_V*)*diario->capacidad;
+        mem.reservas+=2+(diario->capacidad>0);
+        if(diario->log.archivo) {
+            mem.indices+=diario->log.capacidad;
+            ++(mem.reservas);
         }
+        _gd_memoria_tabla(diario->ids, &mem);
     }
+    _gd_memoria_total(&mem);
+    return mem;
+}
 
-    _liberar_lista_c(no_visitados);
-
-    Camino_D* camino = (Camino_D*)malloc(sizeof(Camino_D));
-    if(!camino) {_liberar_lista_c(visitados); return NULL;}
-    camino->longitud=nodo_ref->dist_orig;
-    camino->saltos=0;
-    cptr=nodo_ref;
-    while(cptr->nd_padre!=NULL) {
-        ++(camino->saltos);
-        cptr=cptr->nd_padre;
+/*  Regresa el desglose de la memoria que ocupa una version. Los bloques de vertices que la
+    version comparte con otras versiones o con el grafo se cuentan completos y ademas en el campo
+    compartido, de modo que total-compartido es lo que se libera al liberar solo esta version.
+*/
+static Grafo_D_Memoria grafo_d_version_memoria(const Grafo_D_Version* ver) {
+    Grafo_D_Memoria mem={0, 0, 0, 0, 0, 0, 0, 0};
+    mem.indices+=sizeof(Grafo_D_Version)+(sizeof(_Bloque_V*)+sizeof(_Indice_V))*ver->orden;
+    mem.reservas+=3+ver->orden;
+    mem.datos+=sizeof(Vertice)*ver->orden+sizeof(Arista)*ver->tamano;
+    mem.aristas+=(sizeof(_Arista_Ver)-sizeof(Arista))*ver->tamano;
+    mem.vertices+=(sizeof(_Bloque_V)-sizeof(Vertice))*ver->orden;
+    for(size_t i=0; i<ver->orden; ++i) {
+        const _Bloque_V* bloque=ver->bloques[i];
+        if(bloque->referencias>1) mem.compartido+=sizeof(_Bloque_V)+sizeof(_Arista_Ver)*bloque->grado_s;
     }
+    _gd_memoria_total(&mem);
+    return mem;
+}
 
-    camino->vts=(Vertice**)malloc(sizeof(Vertice*)*(camino->saltos+1));
-    if(!camino->vts) {
-        _liberar_lista_c(visitados);
-        free(camino);
-        return NULL;
-    }
-    camino->vts[0]=(Vertice*)ini;
-    
-    //Si el camino no tiene aristas regresamos un camino trivial
-    if(camino->saltos==0) return camino;
+/*  Regresa el desglose de la memoria que ocupa un grafo comprimido. La lista de vecinos
+    codificada se cuenta como aristas y los pesos y puntos de acceso como indices.
+*/
+static Grafo_D_Memoria grafo_d_comprimido_memoria(const Grafo_D_Comprimido* comp) {
+    Grafo_D_Memoria mem={0, 0, 0, 0, 0, 0, 0, 0};
+    size_t bloques=(comp->orden+GD_COMP_BLOQUE-1)/GD_COMP_BLOQUE;
+    mem.datos+=sizeof(Vertice)*comp->orden+sizeof(Arista)*comp->tamano;
+    mem.aristas+=comp->bytes;
+    mem.indices+=sizeof(Grafo_D_Comprimido)+sizeof(_Bloque_C)*bloques;
+    if(comp->pesos) mem.indices+=sizeof(peso_t)*comp->tamano;
+    mem.reservas+=5+(comp->pesos!=NULL);
+    _gd_memoria_total(&mem);
+    return mem;
+}
 
-    camino->ars=(Arista**)malloc(sizeof(Arista*)*camino->saltos);
-    if(!camino->ars) {
-        _liberar_lista_c(visitados);
-        free(camino->vts); free(camino);
-        return NULL;
-    }
-    cptr=nodo_ref;
-    for(size_t i=camino->saltos; i>0; --i) {
-        camino->vts[i]=&(cptr->vt_actual->vt);
-        camino->ars[i-1]=&(cptr->ar_puente->ar);
-        cptr=cptr->nd_padre;
-    }
-    
-    _liberar_lista_c(visitados);
-    return camino;
+/*  Regresan los bytes que ocupa una matriz o un camino*/
+static inline size_t matriz_ady_memoria(const Matriz_Ady* matriz) {
+    return sizeof(Matriz_Ady)+sizeof(Arista*)*matriz->orden*matriz->orden;
+}
+
+static inline size_t matriz_peso_memoria(const Matriz_Peso* matriz) {
+    return sizeof(Matriz_Peso)+sizeof(peso_t)*matriz->orden*matriz->orden;
+}
+
+static inline size_t matriz_peso_sim_memoria(const Matriz_Peso_Sim* matriz) {
+    return sizeof(Matriz_Peso_Sim)+sizeof(peso_t)*(matriz->orden*(matriz->orden+1)/2);
+}
+
+static inline size_t matriz_bits_memoria(const Matriz_Bits* matriz) {
+    return sizeof(Matriz_Bits)+sizeof(uint64_t)*matriz->palabras*matriz->orden;
+}
+
+static inline size_t camino_d_memoria(const Camino_D* camino) {
+    if(camino->vts==NULL) return sizeof(Camino_D);
+    return sizeof(Camino_D)+sizeof(Vertice*)*(camino->saltos+1)+sizeof(Arista*)*camino->saltos;
+}
+
+/*------------------------------Identificadores Numericos---------------------------------*/
+
+/*  Si se definio GRAFO_D_IDS_32 cada vertice tiene un identificador numerico en [0,
+    grafo_d_limite_ids()) que no cambia mientras el vertice exista. Los identificadores son
+    densos: al eliminar un vertice su identificador se reutiliza en la siguiente insercion, por
+    lo que sirven como indice de arreglos del usuario. grafo_d_clonar() conserva los
+    identificadores, pero no se guardan en los archivos: grafo_d_desde_mapa() y
+    grafo_d_diario_recuperar() numeran de nuevo los vertices en el orden en que los insertan, por
+    lo que los identificadores solo son validos dentro del proceso que los asigno.
+*/
+#ifdef GRAFO_D_IDS_32
+
+/*  Regresa el identificador numerico del vertice vt*/
+static inline uint32_t grafo_d_id(const Vertice* vt) {return _GD_NODO_V(vt)->id;}
+
+/*  Regresa el identificador numerico del vertice en el que termina la arista ar*/
+static inline uint32_t grafo_d_destino_id(const Arista* ar) {
+    return ((const Nodo_A*)((const char*)ar-offsetof(Nodo_A, ar)))->fin;
+}
+
+/*  Regresa una cota superior estricta de los identificadores de los vertices del grafo, que
+    nunca es mayor al numero maximo de vertices que ha tenido el grafo
+*/
+static inline size_t grafo_d_limite_ids(const Grafo_D* grafo) {return grafo->num_ids;}
+
+/*  Regresa el vertice con el identificador id o NULL si no existe*/
+static inline Vertice* grafo_d_vertice_por_id(const Grafo_D* grafo, uint32_t id) {
+    if(id>=grafo->num_ids || grafo->nodos_id[id]==NULL) return NULL;
+    return &(grafo->nodos_id[id]->vt);
+}
+
+/*  Regresa un arreglo almacenado dinamicamente con los identificadores de los saltos+1
+    vertices de un camino obtenido con grafo_d_dijkstra(), o NULL si el camino es invalido o no
+    hubo memoria. Debe liberarse con una llamada a GRAFO_D_FREE()
+*/
+static uint32_t* grafo_d_camino_ids(const Camino_D* camino) {
+    if(!es_camino_valido((Camino_D*)camino)) return NULL;
+    uint32_t* ids=(uint32_t*)GRAFO_D_MALLOC(sizeof(uint32_t)*(camino->saltos+1));
+    if(!ids) return NULL;
+    for(size_t i=0; i<=camino->saltos; ++i) ids[i]=_GD_NODO_V(camino->vts[i])->id;
+    return ids;
+}
+
+/*  Regresa un arreglo almacenado dinamicamente de grafo->orden elementos con el identificador
+    del vertice que corresponde a cada posicion de los ejes de las matrices creadas con
+    grafo_d_crear_mat_...(), es decir en el orden de la lista de vertices. Debe liberarse con una
+    llamada a GRAFO_D_FREE()
+*/
+static uint32_t* grafo_d_ids_ejes(const Grafo_D* grafo) {
+    uint32_t* ids=(uint32_t*)GRAFO_D_MALLOC(sizeof(uint32_t)*(grafo->orden ? grafo->orden : 1));
+    if(!ids) return NULL;
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; vptr!=NULL; ++i, vptr=vptr->sig) ids[i]=vptr->id;
+    return ids;
 }
 
+#endif
+
 /*-------------------------------Operaciones Miscelaneas---------------------------------*/
 
 /*  Imprime una representacion cruda del grafo en su forma de lista de adyacencia
@@ -933,4 +6386,239 @@ static void grafo_d_print_debug(const Grafo_D* grafo) {
     return;
 }
 
-#endif
\ No newline at end of file
+/*---------------------------------Modo Concurrente-----------------------------------*/
+#ifdef GRAFO_D_CONCURRENTE
+
+/*  GARANTIAS DEL MODO CONCURRENTE
+    - Cada operacion publica sobre un grafo (insertar, eliminar, buscar, crear matrices, dijkstra,
+      asignar comportamientos, etc.) es atomica respecto a las demas: las consultas adquieren el
+      candado en modo lectura y pueden ejecutarse en paralelo entre ellas, las modificaciones lo
+      adquieren en modo escritura y se ejecutan en exclusiva.
+    - Una consulta nunca observa una modificacion a medias.
+    - Los identificadores (Vertice*, Arista*) regresados por una consulta siguen siendo validos
+      solo mientras ningun otro hilo elimine el vertice/arista correspondiente. Para usar los
+      resultados de forma consistente con el estado del grafo se debe mantener el candado de
+      lectura con grafo_d_bloquear_lectura() durante todo su uso.
+    - Los iteradores (grafo_d_iter_...) no adquieren el candado, se debe llamar a
+      grafo_d_bloquear_lectura() antes de crearlos y a grafo_d_desbloquear() al terminar.
+    - Las funciones del usuario (cmp_vt, cmp_ar, calc_peso, hash_vt, hash_ar) pueden ejecutarse
+      en varios hilos a la vez y no deben llamar a operaciones del mismo grafo.
+    - grafo_d_crear() y grafo_d_destruir() no estan protegidas, ningun otro hilo debe usar el grafo
+      durante su destruccion.
+*/
+
+/*  Adquiere el candado del grafo en modo lectura. Mientras se mantenga ningun hilo podra
+    modificar el grafo. Debe liberarse con grafo_d_desbloquear() y no debe llamarse a operaciones
+    que modifiquen el grafo desde el mismo hilo mientras se mantiene.
+*/
+static inline void grafo_d_bloquear_lectura(const Grafo_D* grafo) {
+#ifdef _GD_TORNIQUETE
+    pthread_mutex_lock((pthread_mutex_t*)&(grafo->torniquete));
+    pthread_mutex_unlock((pthread_mutex_t*)&(grafo->torniquete));
+#endif
+    pthread_rwlock_rdlock((pthread_rwlock_t*)&(grafo->bloqueo));
+}
+
+/*  Adquiere el candado del grafo en modo escritura. Ninguna operacion publica del grafo puede
+    llamarse desde el mismo hilo mientras se mantiene. Debe liberarse con grafo_d_desbloquear()
+*/
+static inline void grafo_d_bloquear_escritura(Grafo_D* grafo) {
+#ifdef _GD_TORNIQUETE
+    pthread_mutex_lock(&(grafo->torniquete));
+    pthread_rwlock_wrlock(&(grafo->bloqueo));
+    pthread_mutex_unlock(&(grafo->torniquete));
+#else
+    pthread_rwlock_wrlock(&(grafo->bloqueo));
+#endif
+}
+
+/*  Libera el candado adquirido con grafo_d_bloquear_lectura() o grafo_d_bloquear_escritura()*/
+static inline void grafo_d_desbloquear(const Grafo_D* grafo) {
+    pthread_rwlock_unlock((pthread_rwlock_t*)&(grafo->bloqueo));
+}
+
+/*  !!!MACROS DE USO INTERNO!!!
+    Definen la version publica de una operacion adquiriendo el candado con la funcion bloquear
+    alrededor de la llamada a la version sin candado _nombre_sb.
+*/
+#define _GD_ENVOLVER(bloquear, tipo, nombre, params, args) \
+    static tipo _GD_PUBLICO(nombre) params { \
+        bloquear(grafo); \
+        tipo _res=_##nombre##_sb args; \
+        grafo_d_desbloquear(grafo); \
+        return _res; \
+    }
+
+#define _GD_ENVOLVER_VOID(bloquear, nombre, params, args) \
+    static void _GD_PUBLICO(nombre) params { \
+        bloquear(grafo); \
+        _##nombre##_sb args; \
+        grafo_d_desbloquear(grafo); \
+    }
+
+#undef grafo_d_isempty
+_GD_ENVOLVER(grafo_d_bloquear_lectura, bool, grafo_d_isempty, (const Grafo_D* grafo), (grafo))
+#undef grafo_d_buscar_vertice
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Vertice*, grafo_d_buscar_vertice, (const Grafo_D* grafo, Vertice ref), (grafo, ref))
+#undef grafo_d_buscar_vertices
+_GD_ENVOLVER(grafo_d_bloquear_lectura, const Vect_V*, grafo_d_buscar_vertices, (const Grafo_D* grafo, Vertice ref), (grafo, ref))
+#undef grafo_d_buscar_arista
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Arista*, grafo_d_buscar_arista, (const Grafo_D* grafo, Arista ref), (grafo, ref))
+#undef grafo_d_buscar_aristas
+_GD_ENVOLVER(grafo_d_bloquear_lectura, const Vect_A*, grafo_d_buscar_aristas, (const Grafo_D* grafo, Arista ref), (grafo, ref))
+#undef grafo_d_buscar_arista_entre_vert
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Arista*, grafo_d_buscar_arista_entre_vert, (const Grafo_D* grafo, const Vertice* ini, const Vertice* fin), (grafo, ini, fin))
+#undef grafo_d_buscar_aristas_entre_vert
+_GD_ENVOLVER(grafo_d_bloquear_lectura, const Vect_A*, grafo_d_buscar_aristas_entre_vert, (const Grafo_D* grafo, const Vertice* ini, const Vertice* fin), (grafo, ini, fin))
+#undef grafo_d_buscar_arista_estricto
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Arista*, grafo_d_buscar_arista_estricto, (const Grafo_D* grafo, Arista ref, const Vertice* ini, const Vertice* fin), (grafo, ref, ini, fin))
+#undef grafo_d_buscar_aristas_estricto
+_GD_ENVOLVER(grafo_d_bloquear_lectura, const Vect_A*, grafo_d_buscar_aristas_estricto, (const Grafo_D* grafo, Arista ref, const Vertice* ini, const Vertice* fin), (grafo, ref, ini, fin))
+#undef grafo_d_buscar_vertices_par
+_GD_ENVOLVER(grafo_d_bloquear_lectura, const Vect_V*, grafo_d_buscar_vertices_par, (const Grafo_D* grafo, Vertice ref, unsigned hilos), (grafo, ref, hilos))
+#undef grafo_d_buscar_aristas_par
+_GD_ENVOLVER(grafo_d_bloquear_lectura, const Vect_A*, grafo_d_buscar_aristas_par, (const Grafo_D* grafo, Arista ref, unsigned hilos), (grafo, ref, hilos))
+#undef grafo_d_crear_mat_ady
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Matriz_Ady*, grafo_d_crear_mat_ady, (const Grafo_D* grafo), (grafo))
+#undef grafo_d_crear_mat_peso
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Matriz_Peso*, grafo_d_crear_mat_peso, (const Grafo_D* grafo), (grafo))
+#undef grafo_d_es_simetrico
+_GD_ENVOLVER(grafo_d_bloquear_lectura, bool, grafo_d_es_simetrico, (const Grafo_D* grafo), (grafo))
+#undef grafo_d_crear_mat_peso_sim
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Matriz_Peso_Sim*, grafo_d_crear_mat_peso_sim, (const Grafo_D* grafo), (grafo))
+#undef grafo_d_crear_mat_bits
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Matriz_Bits*, grafo_d_crear_mat_bits, (const Grafo_D* grafo), (grafo))
+#undef grafo_d_dijkstra
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Camino_D*, grafo_d_dijkstra, (const Grafo_D* grafo, const Vertice* ini, const Vertice* fin), (grafo, ini, fin))
+#undef grafo_d_print_debug
+_GD_ENVOLVER_VOID(grafo_d_bloquear_lectura, grafo_d_print_debug, (const Grafo_D* grafo), (grafo))
+#undef grafo_d_guardar_binario
+_GD_ENVOLVER(grafo_d_bloquear_lectura, bool, grafo_d_guardar_binario, (const Grafo_D* grafo, const char* ruta, bool con_pesos), (grafo, ruta, con_pesos))
+#undef grafo_d_comprimir
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Grafo_D_Comprimido*, grafo_d_comprimir, (const Grafo_D* grafo, bool con_pesos), (grafo, con_pesos))
+#undef grafo_d_exportar_lista
+_GD_ENVOLVER(grafo_d_bloquear_lectura, bool, grafo_d_exportar_lista, (const Grafo_D* grafo, FILE* archivo, char* buf,
+    size_t tam_buf, size_t (*fmt_vt)(const Vertice*, char*, size_t), size_t (*fmt_ar)(const Arista*, char*, size_t)),
+    (grafo, archivo, buf, tam_buf, fmt_vt, fmt_ar))
+#undef grafo_d_exportar_dot
+_GD_ENVOLVER(grafo_d_bloquear_lectura, bool, grafo_d_exportar_dot, (const Grafo_D* grafo, FILE* archivo, const char* nombre,
+    char* buf, size_t tam_buf, size_t (*fmt_vt)(const Vertice*, char*, size_t), size_t (*fmt_ar)(const Arista*, char*, size_t)),
+    (grafo, archivo, nombre, buf, tam_buf, fmt_vt, fmt_ar))
+
+#undef grafo_d_set_cmp_vt
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_set_cmp_vt, (Grafo_D* grafo, bool (*cmp_vt)(Vertice*, Vertice*)), (grafo, cmp_vt))
+#undef grafo_d_unset_cmp_vt
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_unset_cmp_vt, (Grafo_D* grafo), (grafo))
+#undef grafo_d_set_cmp_ar
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_set_cmp_ar, (Grafo_D* grafo, bool (*cmp_ar)(Arista*, Arista*)), (grafo, cmp_ar))
+#undef grafo_d_unset_cmp_ar
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_unset_cmp_ar, (Grafo_D* grafo), (grafo))
+#undef grafo_d_set_calc_peso
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_set_calc_peso, (Grafo_D* grafo, peso_t (*calc_peso)(Arista*)), (grafo, calc_peso))
+#undef grafo_d_unset_calc_peso
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_unset_calc_peso, (Grafo_D* grafo), (grafo))
+#undef grafo_d_set_hash_vt
+_GD_ENVOLVER(grafo_d_bloquear_escritura, bool, grafo_d_set_hash_vt, (Grafo_D* grafo, size_t (*hash_vt)(Vertice*)), (grafo, hash_vt))
+#undef grafo_d_unset_hash_vt
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_unset_hash_vt, (Grafo_D* grafo), (grafo))
+#undef grafo_d_set_hash_ar
+_GD_ENVOLVER(grafo_d_bloquear_escritura, bool, grafo_d_set_hash_ar, (Grafo_D* grafo, size_t (*hash_ar)(Arista*)), (grafo, hash_ar))
+#undef grafo_d_unset_hash_ar
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_unset_hash_ar, (Grafo_D* grafo), (grafo))
+#undef grafo_d_insertar_vertice
+_GD_ENVOLVER(grafo_d_bloquear_escritura, Vertice*, grafo_d_insertar_vertice, (Grafo_D* grafo, Vertice vt), (grafo, vt))
+#undef grafo_d_eliminar_vertice
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_eliminar_vertice, (Grafo_D* grafo, Vertice* vt), (grafo, vt))
+#undef grafo_d_insertar_arista
+_GD_ENVOLVER(grafo_d_bloquear_escritura, Arista*, grafo_d_insertar_arista, (Grafo_D* grafo, Arista ar, const Vertice* ini, const Vertice* fin), (grafo, ar, ini, fin))
+#undef grafo_d_insertar_arista_par
+_GD_ENVOLVER(grafo_d_bloquear_escritura, Vect_A*, grafo_d_insertar_arista_par, (Grafo_D* grafo, Arista ar, const Vertice* ini, const Vertice* fin), (grafo, ar, ini, fin))
+#undef grafo_d_insertar_arpar
+_GD_ENVOLVER(grafo_d_bloquear_escritura, bool, grafo_d_insertar_arpar, (Grafo_D* grafo, Arista ar, const Vertice* ini, const Vertice* fin), (grafo, ar, ini, fin))
+#undef grafo_d_elminar_arista
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_elminar_arista, (Grafo_D* grafo, Arista* ar), (grafo, ar))
+#undef grafo_d_marcar_modificado
+_GD_ENVOLVER_VOID(grafo_d_bloquear_escritura, grafo_d_marcar_modificado, (Grafo_D* grafo, const Vertice* vt), (grafo, vt))
+#undef grafo_d_snapshot
+_GD_ENVOLVER(grafo_d_bloquear_escritura, const Grafo_D_Version*, grafo_d_snapshot, (Grafo_D* grafo), (grafo))
+#undef grafo_d_cargar_texto
+_GD_ENVOLVER(grafo_d_bloquear_escritura, bool, grafo_d_cargar_texto, (Grafo_D* grafo, const char* ruta, int formato,
+    bool (*leer_vt)(size_t, Vertice*), bool (*leer_ar)(const char**, const size_t*, size_t, Arista*), unsigned hilos),
+    (grafo, ruta, formato, leer_vt, leer_ar, hilos))
+#undef grafo_d_diario_iniciar
+_GD_ENVOLVER(grafo_d_bloquear_escritura, bool, grafo_d_diario_iniciar, (Grafo_D* grafo, const char* ruta), (grafo, ruta))
+#undef grafo_d_diario_punto_control
+_GD_ENVOLVER(grafo_d_bloquear_escritura, bool, grafo_d_diario_punto_control, (Grafo_D* grafo), (grafo))
+#undef grafo_d_diario_sincronizar
+_GD_ENVOLVER(grafo_d_bloquear_escritura, bool, grafo_d_diario_sincronizar, (Grafo_D* grafo), (grafo))
+#undef grafo_d_diario_terminar
+_GD_ENVOLVER(grafo_d_bloquear_escritura, bool, grafo_d_diario_terminar, (Grafo_D* grafo), (grafo))
+#undef grafo_d_compactar
+_GD_ENVOLVER(grafo_d_bloquear_escritura, Grafo_D_Traduccion*, grafo_d_compactar, (Grafo_D* grafo, const Vertice* const* orden), (grafo, orden))
+#undef grafo_d_clonar
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Grafo_D*, grafo_d_clonar, (const Grafo_D* grafo, Grafo_D_Traduccion** tr), (grafo, tr))
+#undef grafo_d_calcular_orden
+_GD_ENVOLVER(grafo_d_bloquear_lectura, size_t*, grafo_d_calcular_orden, (const Grafo_D* grafo, int metodo), (grafo, metodo))
+#undef grafo_d_ancho_banda
+_GD_ENVOLVER(grafo_d_bloquear_lectura, size_t, grafo_d_ancho_banda, (const Grafo_D* grafo), (grafo))
+#undef grafo_d_reordenar
+_GD_ENVOLVER(grafo_d_bloquear_escritura, Grafo_D_Traduccion*, grafo_d_reordenar, (Grafo_D* grafo, int metodo, size_t* ancho_antes, size_t* ancho_despues),
+    (grafo, metodo, ancho_antes, ancho_despues))
+#undef grafo_d_memoria
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Grafo_D_Memoria, grafo_d_memoria, (const Grafo_D* grafo), (grafo))
+#ifdef GRAFO_D_IDS_32
+#undef grafo_d_limite_ids
+_GD_ENVOLVER(grafo_d_bloquear_lectura, size_t, grafo_d_limite_ids, (const Grafo_D* grafo), (grafo))
+#undef grafo_d_vertice_por_id
+_GD_ENVOLVER(grafo_d_bloquear_lectura, Vertice*, grafo_d_vertice_por_id, (const Grafo_D* grafo, uint32_t id), (grafo, id))
+#undef grafo_d_ids_ejes
+_GD_ENVOLVER(grafo_d_bloquear_lectura, uint32_t*, grafo_d_ids_ejes, (const Grafo_D* grafo), (grafo))
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#undef grafo_d_fin_carga_atomica
+_GD_ENVOLVER(grafo_d_bloquear_escritura, bool, grafo_d_fin_carga_atomica, (Grafo_D* grafo), (grafo))
+#endif
+
+#endif
+
+/*  Con GRAFO_D_PREFIJO se eliminan las macros de tipos y modos de esta inclusion y las macros
+    internas que dependen de ellas
+*/
+#ifdef GRAFO_D_PREFIJO
+#undef STRUCT_VERTICE
+#undef DATO_VERTICE
+#undef STRUCT_ARISTA
+#undef DATO_ARISTA
+#undef DATO_PESO
+#undef PESO_NO_ARISTA
+#undef Vertice
+#undef Arista
+#undef peso_t
+#undef GRAFO_D_UMBRAL_HASH_ADY
+#undef GRAFO_D_ADY_LOCAL
+#undef GRAFO_D_IDS_32
+#undef GRAFO_D_HILOS
+#undef GRAFO_D_CONCURRENTE
+#undef GRAFO_D_MMAP
+#undef GRAFO_D_MALLOC
+#undef GRAFO_D_REALLOC
+#undef GRAFO_D_FREE
+#undef GRAFO_D_CALLOC
+#undef GRAFO_D_CALC_PESO
+#undef PESO_CAMPO
+#undef GRAFO_D_CMP_VT
+#undef GRAFO_D_CMP_AR
+#undef cmp_vt_default
+#undef cmp_ar_default
+#undef calc_peso_default
+#undef _GD_TORNIQUETE
+#undef _GD_CMP_VT
+#undef _GD_CMP_AR
+#undef _GD_CLAVE_V
+#undef _GD_FIN
+#undef _GD_CARGA_PAR
+#undef _GD_SB
+#undef GRAFO_D_PREFIJO
+#endif
+
+#endif
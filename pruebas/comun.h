@@ -0,0 +1,95 @@
+/*  Funciones comunes de las pruebas de grafo_d.h. Cada prueba es un programa que incluye este
+    archivo, recibe como primer argumento un directorio temporal para sus archivos y termina con
+    una asercion fallida si encuentra un error. Las pruebas se compilan y ejecutan en cada modo de
+    compilacion de la libreria con correr.sh.
+*/
+#ifndef PRUEBAS_COMUN_H
+#define PRUEBAS_COMUN_H
+
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../grafo_d.h"
+
+#define PRUEBA_MAX_VTS 4096
+
+/*  Escribe en buf la ruta del archivo nombre dentro del directorio dir*/
+static const char* prueba_ruta(char* buf, size_t tam, const char* dir, const char* nombre) {
+    snprintf(buf, tam, "%s/%s", dir, nombre);
+    return buf;
+}
+
+/*  Generador pseudoaleatorio propio para que las pruebas no dependan de rand()*/
+static unsigned prueba_azar(unsigned* estado) {
+    *estado=*estado*1103515245u+12345u;
+    return (*estado>>8)&0xFFFFFF;
+}
+
+/*  Crea un grafo con los vertices 0, 1, ..., num_vts-1, que se guardan en vts, y num_ars aristas
+    al azar con los valores 0, 1, ..., num_ars-1 a partir de la semilla
+*/
+static Grafo_D* prueba_grafo_azar(unsigned semilla, int num_vts, int num_ars, Vertice** vts) {
+    assert(num_vts>0 && num_vts<=PRUEBA_MAX_VTS);
+    Grafo_D* grafo=grafo_d_crear();
+    assert(grafo);
+    for(int i=0; i<num_vts; ++i) assert((vts[i]=grafo_d_insertar_vertice(grafo, i)));
+    for(int i=0; i<num_ars; ++i) {
+        Vertice* ini=vts[prueba_azar(&semilla)%num_vts];
+        assert(grafo_d_insertar_arista(grafo, i, ini, vts[prueba_azar(&semilla)%num_vts]));
+    }
+    return grafo;
+}
+
+/*  Aplica al grafo num_ops operaciones al azar (inserciones y eliminaciones de vertices y
+    aristas) a partir de la semilla. Los vertices se insertan con los valores 0, 1, 2, ... y las
+    aristas con el numero de la operacion, por lo que dos grafos con la misma semilla terminan
+    iguales.
+*/
+static void prueba_operaciones(Grafo_D* grafo, unsigned semilla, int num_ops) {
+    Vertice* vts[PRUEBA_MAX_VTS];
+    int n=0, siguiente=0;
+    for(int i=0; i<num_ops; ++i) {
+        unsigned r=prueba_azar(&semilla)%10;
+        if((r<3 || n<2) && n<PRUEBA_MAX_VTS) {
+            vts[n++]=grafo_d_insertar_vertice(grafo, siguiente++);
+        } else if(r<7) {
+            Vertice* ini=vts[prueba_azar(&semilla)%n];
+            grafo_d_insertar_arista(grafo, i, ini, vts[prueba_azar(&semilla)%n]);
+        } else if(r<8) {
+            Vertice* ini=vts[prueba_azar(&semilla)%n];
+            GRAFO_D_FREE(grafo_d_insertar_arista_par(grafo, i, ini, vts[prueba_azar(&semilla)%n]));
+        } else if(r<9) {
+            Vertice* ini=vts[prueba_azar(&semilla)%n];
+            Nodo_V* vptr=grafo->lista_ady;
+            while(&(vptr->vt)!=ini) vptr=vptr->sig;
+            if(vptr->lista_ady) {
+                Nodo_A* aptr=vptr->lista_ady;
+                for(size_t k=prueba_azar(&semilla)%vptr->grado_s; k>0; --k) aptr=aptr->sig;
+                grafo_d_elminar_arista(grafo, &(aptr->ar));
+            }
+        } else {
+            int k=prueba_azar(&semilla)%n;
+            grafo_d_eliminar_vertice(grafo, vts[k]);
+            vts[k]=vts[--n];
+        }
+    }
+}
+
+/*  Verifica que los dos grafos tengan los mismos vertices y aristas en el mismo orden*/
+static void prueba_iguales(const Grafo_D* a, const Grafo_D* b) {
+    assert(a->orden==b->orden && a->tamano==b->tamano);
+    const Nodo_V* x=a->lista_ady;
+    const Nodo_V* y=b->lista_ady;
+    for(; x && y; x=x->sig, y=y->sig) {
+        assert(x->vt==y->vt && x->grado_s==y->grado_s);
+        const Nodo_A* p=x->lista_ady;
+        const Nodo_A* q=y->lista_ady;
+        for(; p && q; p=p->sig, q=q->sig)
+            assert(p->ar==q->ar && _GD_FIN(a, p)->vt==_GD_FIN(b, q)->vt);
+        assert(p==NULL && q==NULL);
+    }
+    assert(x==NULL && y==NULL);
+}
+
+#endif
@@ -0,0 +1,41 @@
+#!/bin/sh
+# Compila y ejecuta cada prueba de este directorio en cada uno de los modos de compilacion de la
+# libreria. Uso: pruebas/correr.sh [compilador]. El compilador por defecto es $CC o cc.
+# Regresa 0 si todas las pruebas compilaron sin advertencias y terminaron correctamente.
+
+CC=${1:-${CC:-cc}}
+DIR=$(cd "$(dirname "$0")" && pwd)
+TMP=$(mktemp -d) || exit 1
+trap 'rm -rf "$TMP"' EXIT
+
+BANDERAS="-Wall -Wextra -Wno-sign-compare -Wno-unused-function -g"
+MODOS="-std=gnu11
+-std=gnu11 -DGRAFO_D_IDS_32
+-std=gnu11 -DGRAFO_D_ADY_LOCAL=0
+-std=gnu11 -DGRAFO_D_UMBRAL_HASH_ADY=2
+-std=gnu11 -DGRAFO_D_MMAP
+-std=gnu11 -DGRAFO_D_HILOS
+-std=gnu11 -DGRAFO_D_CONCURRENTE
+-std=gnu11 -DGRAFO_D_IDS_32 -DGRAFO_D_ADY_LOCAL=0 -DGRAFO_D_MMAP -DGRAFO_D_CONCURRENTE
+-std=c99"
+
+fallas=0
+for prueba in "$DIR"/*.c; do
+    nombre=$(basename "$prueba" .c)
+    echo "$MODOS" | while read -r modo; do
+        salida="$TMP/$nombre"
+        if ! $CC $BANDERAS $modo -o "$salida" "$prueba" -lm -pthread 2>"$TMP/errores"; then
+            echo "FALLA (compilacion) $nombre [$modo]"; cat "$TMP/errores"; exit 1
+        fi
+        if [ -s "$TMP/errores" ]; then
+            echo "FALLA (advertencias) $nombre [$modo]"; cat "$TMP/errores"; exit 1
+        fi
+        mkdir -p "$TMP/datos" && rm -rf "$TMP/datos"/*
+        if ! "$salida" "$TMP/datos"; then
+            echo "FALLA (ejecucion) $nombre [$modo]"; exit 1
+        fi
+    done && echo "ok $nombre" || fallas=$((fallas+1))
+done
+
+[ "$fallas" -eq 0 ] || { echo "$fallas pruebas fallaron"; exit 1; }
+echo "todas las pruebas pasaron"
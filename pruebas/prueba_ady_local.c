@@ -0,0 +1,80 @@
+/*  Almacenamiento de las aristas: nodos locales del vertice, lotes y reutilizacion de los nodos
+    libres, junto con aristas insertadas con grafo_d_insertar_arista_atomica()
+*/
+#include "comun.h"
+
+/*  Verifica que cada nodo propio del vertice este en su lista o en sus libres y regresa el
+    numero de lotes
+*/
+static size_t verificar_nodo(const Nodo_V* vptr) {
+    size_t capacidad=GRAFO_D_ADY_LOCAL, lotes=0;
+    for(const _Lote_A* lote=vptr->lotes; lote; lote=lote->sig, ++lotes) capacidad+=lote->capacidad;
+    size_t n=0, propias=0, libres=0;
+    for(const Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig, ++n)
+        propias+=_grafo_d_arista_propia(vptr, aptr);
+    for(const Nodo_A* aptr=vptr->libres; aptr; aptr=aptr->sig, ++libres)
+        assert(_grafo_d_arista_propia(vptr, aptr));
+    assert(n==vptr->grado_s && propias+libres==capacidad);
+    return lotes;
+}
+
+static void verificar_grafo(const Grafo_D* grafo) {
+    size_t tamano=0;
+    for(const Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) {
+        verificar_nodo(vptr);
+        tamano+=vptr->grado_s;
+    }
+    assert(tamano==grafo->tamano);
+}
+
+int main(void) {
+    Grafo_D* grafo=grafo_d_crear();
+    Vertice* v=grafo_d_insertar_vertice(grafo, 0);
+    Vertice* w=grafo_d_insertar_vertice(grafo, 1);
+    Nodo_V* nodo=grafo->lista_ady;
+
+    //Las primeras aristas quedan dentro del nodo del vertice
+    for(int i=0; i<GRAFO_D_ADY_LOCAL; ++i) {
+        Arista* ar=grafo_d_insertar_arista(grafo, i, v, w);
+        assert(ar && (char*)ar>=(char*)nodo && (char*)ar<(char*)(nodo+1));
+    }
+    assert(nodo->lotes==NULL && verificar_nodo(nodo)==0);
+
+    //Las siguientes se reservan en lotes cuya capacidad crece con el grado
+    for(int i=0; i<1000; ++i) assert(grafo_d_insertar_arista(grafo, i, v, w));
+    size_t lotes=verificar_nodo(nodo);
+    assert(lotes>0 && lotes<=12);
+
+    //Vaciar y volver a llenar reutiliza los mismos nodos
+    while(nodo->lista_ady) grafo_d_elminar_arista(grafo, &(nodo->lista_ady->ar));
+    assert(verificar_nodo(nodo)==lotes);
+    for(int i=0; i<1000+GRAFO_D_ADY_LOCAL; ++i) assert(grafo_d_insertar_arista(grafo, i, v, v));
+    assert(verificar_nodo(nodo)==lotes);
+
+    //Pares de aristas y aristas atomicas reservadas por separado
+    for(int i=0; i<50; ++i) {
+        GRAFO_D_FREE(grafo_d_insertar_arista_par(grafo, i, v, w));
+        assert(grafo_d_insertar_arpar(grafo, i, w, v));
+    }
+    for(int i=0; i<100; ++i) assert(grafo_d_insertar_arista_atomica(grafo, -i, v, w));
+    assert(grafo_d_fin_carga_atomica(grafo));
+    verificar_grafo(grafo);
+    //Eliminar aristas de ambos tipos mezcladas
+    for(int i=0; nodo->lista_ady; ++i) {
+        Nodo_A* aptr=nodo->lista_ady;
+        for(int k=i%7; k>0 && aptr->sig; --k) aptr=aptr->sig;
+        grafo_d_elminar_arista(grafo, &(aptr->ar));
+        if(i%97==0) verificar_grafo(grafo);
+    }
+    verificar_grafo(grafo);
+    grafo_d_destruir(grafo);
+
+    //Operaciones al azar, incluyendo eliminar vertices con aristas en lotes
+    grafo=grafo_d_crear();
+    prueba_operaciones(grafo, 41, 6000);
+    verificar_grafo(grafo);
+    prueba_operaciones(grafo, 42, 6000);
+    verificar_grafo(grafo);
+    grafo_d_destruir(grafo);
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*  Asignador propio: toda la memoria de la libreria pasa por GRAFO_D_MALLOC/GRAFO_D_REALLOC/
+    GRAFO_D_FREE, se libera completa al destruir las estructuras y una reserva fallida deja al
+    grafo sin cambios
+*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*  Cada bloque lleva un encabezado con una marca para detectar memoria que no salio del
+    asignador. Las reservas fallan al llegar al limite.
+*/
+#define MARCA ((size_t)0x6772616664u)
+#define ENCABEZADO 16
+
+static size_t vivos, reservas, limite=SIZE_MAX;
+
+static void* prueba_malloc(size_t tam) {
+    if(__atomic_load_n(&reservas, __ATOMIC_RELAXED)>=limite) return NULL;
+    char* ptr=(char*)malloc(tam+ENCABEZADO);
+    if(!ptr) return NULL;
+    __atomic_add_fetch(&reservas, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&vivos, 1, __ATOMIC_RELAXED);
+    *(size_t*)ptr=MARCA;
+    return ptr+ENCABEZADO;
+}
+
+static void prueba_free(void* ptr) {
+    if(!ptr) return;
+    char* base=(char*)ptr-ENCABEZADO;
+    if(*(size_t*)base!=MARCA) abort();
+    *(size_t*)base=0;
+    __atomic_sub_fetch(&vivos, 1, __ATOMIC_RELAXED);
+    free(base);
+}
+
+static void* prueba_realloc(void* ptr, size_t tam) {
+    if(!ptr) return prueba_malloc(tam);
+    char* base=(char*)ptr-ENCABEZADO;
+    if(*(size_t*)base!=MARCA) abort();
+    if(__atomic_load_n(&reservas, __ATOMIC_RELAXED)>=limite) return NULL;
+    char* nuevo=(char*)realloc(base, tam+ENCABEZADO);
+    if(!nuevo) return NULL;
+    __atomic_add_fetch(&reservas, 1, __ATOMIC_RELAXED);
+    return nuevo+ENCABEZADO;
+}
+
+#define GRAFO_D_MALLOC(tam) prueba_malloc(tam)
+#define GRAFO_D_REALLOC(ptr, tam) prueba_realloc(ptr, tam)
+#define GRAFO_D_FREE(ptr) prueba_free(ptr)
+#include "comun.h"
+
+static peso_t peso(Arista* ar) {return (*ar<0 ? -*ar : *ar)%7+1;}
+static size_t hash_vt(Vertice* vt) {return (size_t)*vt;}
+static size_t hash_ar(Arista* ar) {return (size_t)*ar;}
+
+int main(void) {
+    //GRAFO_D_CALLOC se implementa con GRAFO_D_MALLOC
+    int* ceros=(int*)GRAFO_D_CALLOC(100, sizeof(int));
+    assert(ceros && vivos==1);
+    for(int i=0; i<100; ++i) assert(ceros[i]==0);
+    GRAFO_D_FREE(ceros);
+    assert(GRAFO_D_CALLOC(SIZE_MAX/2, 4)==NULL && vivos==0 && reservas==1);
+
+    //Todas las estructuras reservan y liberan con el asignador
+    Grafo_D* grafo=grafo_d_crear();
+    prueba_operaciones(grafo, 47, 5000);
+    grafo_d_set_calc_peso(grafo, peso);
+    assert(grafo_d_set_hash_vt(grafo, hash_vt) && grafo_d_set_hash_ar(grafo, hash_ar));
+    GRAFO_D_FREE((void*)grafo_d_buscar_aristas(grafo, 10));
+    GRAFO_D_FREE((void*)grafo_d_buscar_aristas_entre_vert(grafo, &(grafo->lista_ady->vt), &(grafo->lista_fin->vt)));
+    const Grafo_D_Version* ver=grafo_d_snapshot(grafo);
+    assert(ver);
+    Camino_D* camino=grafo_d_version_dijkstra(ver, 0, grafo->orden-1);
+    assert(camino);
+    camino_d_destruir(camino);
+    Grafo_D_Comprimido* comp=grafo_d_comprimir(grafo, true);
+    assert(comp);
+    camino=grafo_d_comprimido_dijkstra(comp, 0, grafo->orden-1, NULL);
+    assert(camino);
+    camino_d_destruir(camino);
+    grafo_d_comprimido_destruir(comp);
+    Matriz_Peso* pesos=grafo_d_crear_mat_peso(grafo);
+    Matriz_Bits* bits=grafo_d_crear_mat_bits(grafo);
+    assert(pesos && bits);
+    GRAFO_D_FREE(pesos);
+    GRAFO_D_FREE(bits);
+    Grafo_D_Traduccion* tr=grafo_d_reordenar(grafo, GD_ORDEN_RCM, NULL, NULL);
+    assert(tr);
+    grafo_d_traduccion_destruir(tr);
+    camino=grafo_d_dijkstra(grafo, &(grafo->lista_ady->vt), &(grafo->lista_fin->vt));
+    assert(camino);
+    camino_d_destruir(camino);
+    grafo_d_version_liberar(ver);
+    grafo_d_destruir(grafo);
+    assert(vivos==0 && reservas>1000);
+
+    //Una compactacion sin memoria suficiente no modifica el grafo
+    grafo=grafo_d_crear();
+    Grafo_D* ref=grafo_d_crear();
+    prueba_operaciones(grafo, 48, 3000);
+    prueba_operaciones(ref, 48, 3000);
+    size_t antes=vivos;
+    for(size_t k=0; ; ++k) {
+        limite=reservas+k;
+        tr=grafo_d_compactar(grafo, NULL);
+        limite=SIZE_MAX;
+        prueba_iguales(grafo, ref);
+        if(tr) {
+            grafo_d_traduccion_destruir(tr);
+            break;
+        }
+        assert(vivos==antes);
+    }
+
+    //Insertar un vertice o una arista que necesita un lote nuevo falla sin cambios
+    size_t orden=grafo->orden, tamano=grafo->tamano;
+    limite=reservas;
+    assert(grafo_d_insertar_vertice(grafo, -1)==NULL && grafo->orden==orden);
+    Vertice* vt=&(grafo->lista_ady->vt);
+    Nodo_V* nodo=grafo->lista_ady;
+    while(nodo->libres) {
+        assert(grafo_d_insertar_arista(grafo, -1, vt, vt));
+        ++tamano;
+    }
+    assert(grafo_d_insertar_arista(grafo, -2, vt, vt)==NULL && grafo->tamano==tamano);
+    limite=SIZE_MAX;
+    assert(grafo_d_insertar_arista(grafo, -2, vt, vt));
+    grafo_d_destruir(ref);
+    grafo_d_destruir(grafo);
+    assert(vivos==0);
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*  Insercion concurrente de aristas: varios hilos insertan con grafo_d_insertar_arista_atomica()
+    sobre vertices compartidos; el tamano se verifica al terminar los hilos y despues de
+    grafo_d_fin_carga_atomica() las listas de adyacencia, las tablas de vecinos y el indice de
+    aristas. Se define
+    _POSIX_C_SOURCE para que la prueba compile tambien con -std=c99.
+*/
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include "comun.h"
+
+#define N 300
+#define HILOS 8
+#define POR_HILO 5000
+#define CONCENTRADORES 4
+
+static Grafo_D* grafo;
+static Vertice* vts[N];
+
+static size_t hash_ar(Arista* ar) {return (size_t)*ar;}
+
+/*  Genera los extremos de la siguiente arista de un hilo, igual en los hilos y en la verificacion*/
+static void arista_de(unsigned* semilla, int* ini, int* fin) {
+    //La mitad de las aristas sale de unos pocos vertices para que los hilos compitan por ellos
+    unsigned r=prueba_azar(semilla);
+    *ini=r%2 ? (int)(prueba_azar(semilla)%CONCENTRADORES) : (int)(prueba_azar(semilla)%N);
+    *fin=(int)(prueba_azar(semilla)%N);
+}
+
+static void* cargar(void* arg) {
+    int h=(int)(size_t)arg;
+    unsigned semilla=100+h;
+    for(int k=0; k<POR_HILO; ++k) {
+        int ini, fin;
+        arista_de(&semilla, &ini, &fin);
+        Arista* ar=grafo_d_insertar_arista_atomica(grafo, h*POR_HILO+k, vts[ini], vts[fin]);
+        assert(ar && *ar==h*POR_HILO+k);
+    }
+    return NULL;
+}
+
+int main(void) {
+    grafo=grafo_d_crear();
+    for(int i=0; i<N; ++i) vts[i]=grafo_d_insertar_vertice(grafo, i);
+    assert(grafo_d_set_hash_ar(grafo, hash_ar));
+    pthread_t hilos[HILOS];
+    for(size_t h=0; h<HILOS; ++h) assert(pthread_create(&hilos[h], NULL, cargar, (void*)h)==0);
+    for(int h=0; h<HILOS; ++h) pthread_join(hilos[h], NULL);
+    //El tamano se actualiza con cada insercion
+    assert(grafo->tamano==HILOS*POR_HILO);
+    assert(grafo_d_fin_carga_atomica(grafo));
+    assert(grafo->tamano==HILOS*POR_HILO);
+
+    //Se reconstruye el inicio y el fin esperados de cada arista
+    static int ini_de[HILOS*POR_HILO], fin_de[HILOS*POR_HILO];
+    size_t grados[N]={0};
+    for(int h=0; h<HILOS; ++h) {
+        unsigned semilla=100+h;
+        for(int k=0; k<POR_HILO; ++k) {
+            arista_de(&semilla, &ini_de[h*POR_HILO+k], &fin_de[h*POR_HILO+k]);
+            ++grados[ini_de[h*POR_HILO+k]];
+        }
+    }
+    static bool vista[HILOS*POR_HILO];
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) {
+        int i=vptr->vt;
+        size_t n=0;
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig, ++n) {
+            Arista a=aptr->ar;
+            assert(a>=0 && a<HILOS*POR_HILO && !vista[a]);
+            vista[a]=true;
+            assert(ini_de[a]==i && _GD_FIN(grafo, aptr)->vt==fin_de[a]);
+        }
+        assert(n==grados[i] && vptr->grado_s==grados[i]);
+        assert((vptr->indice_ady!=NULL)==(vptr->grado_s>GRAFO_D_UMBRAL_HASH_ADY));
+    }
+
+    //Las tablas de vecinos y el indice de aristas coinciden con las listas
+    for(int c=0; c<CONCENTRADORES; ++c)
+        for(int j=0; j<N; ++j) {
+            const Vect_A* entre=grafo_d_buscar_aristas_entre_vert(grafo, vts[c], vts[j]);
+            assert(entre);
+            for(size_t k=0; k<entre->tamano; ++k)
+                assert(ini_de[*entre->aristas[k]]==c && fin_de[*entre->aristas[k]]==j);
+            size_t esperadas=0;
+            for(int a=0; a<HILOS*POR_HILO; ++a) esperadas+=(ini_de[a]==c && fin_de[a]==j);
+            assert(entre->tamano==esperadas);
+            GRAFO_D_FREE((void*)entre);
+        }
+    for(int a=0; a<HILOS*POR_HILO; a+=13) {
+        const Vect_A* r=grafo_d_buscar_aristas(grafo, a);
+        assert(r && r->tamano==1 && *r->aristas[0]==a);
+        GRAFO_D_FREE((void*)r);
+    }
+
+    //Despues de la carga el grafo admite las operaciones normales
+    grafo_d_elminar_arista(grafo, grafo_d_buscar_arista(grafo, 0));
+    assert(grafo->tamano==HILOS*POR_HILO-1 && grafo_d_buscar_arista(grafo, 0)==NULL);
+    grafo_d_destruir(grafo);
+    return 0;
+}
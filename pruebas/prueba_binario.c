@@ -0,0 +1,100 @@
+/*  Formato binario: grafo_d_guardar_binario(), grafo_d_mapear(), consultas sobre el mapa y
+    reconstruccion con grafo_d_desde_mapa()
+*/
+#include "comun.h"
+
+/*  Sobrescribe bytes bytes del archivo ruta en la posicion pos*/
+static void sobrescribir(const char* ruta, size_t pos, const void* datos, size_t bytes) {
+    FILE* archivo=fopen(ruta, "r+b");
+    assert(archivo && fseek(archivo, (long)pos, SEEK_SET)==0);
+    assert(fwrite(datos, 1, bytes, archivo)==bytes);
+    fclose(archivo);
+}
+
+int main(int argc, char** argv) {
+    assert(argc>1);
+    char ruta[512];
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "grafo.bin");
+
+    Grafo_D* grafo=grafo_d_crear();
+    prueba_operaciones(grafo, 11, 4000);
+    for(int con_pesos=0; con_pesos<2; ++con_pesos) {
+        assert(grafo_d_guardar_binario(grafo, ruta, con_pesos));
+        Grafo_D_Mapa* mapa=grafo_d_mapear(ruta);
+        assert(mapa && mapa->orden==grafo->orden && mapa->tamano==grafo->tamano);
+        assert((mapa->pesos!=NULL)==(bool)con_pesos);
+
+        //Los vertices se numeran en el orden de la lista
+        size_t i=0;
+        for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig, ++i) {
+            assert(mapa->vertices[i]==vptr->vt);
+            assert(grafo_d_mapa_grado(mapa, i)==vptr->grado_s);
+        }
+
+        //Las distancias sobre el mapa coinciden con las del grafo
+        Nodo_V* ini=grafo->lista_ady;
+        i=1;
+        for(Nodo_V* fin=ini->sig; fin && i<64; fin=fin->sig, ++i) {
+            Camino_D* c1=grafo_d_dijkstra(grafo, &(ini->vt), &(fin->vt));
+            Camino_D* c2=grafo_d_mapa_dijkstra(mapa, 0, i, con_pesos ? NULL : grafo->calc_peso);
+            assert(c1 && c2);
+            assert(es_camino_valido(c1)==es_camino_valido(c2));
+            if(es_camino_valido(c1)) assert(c1->longitud==c2->longitud);
+            camino_d_destruir(c1);
+            camino_d_destruir(c2);
+        }
+        //Posiciones fuera de rango
+        assert(grafo_d_mapa_dijkstra(mapa, mapa->orden, 0, grafo->calc_peso)==NULL);
+        assert(grafo_d_mapa_dijkstra(mapa, 0, mapa->orden, grafo->calc_peso)==NULL);
+
+        Grafo_D* copia=grafo_d_desde_mapa(mapa);
+        assert(copia);
+        prueba_iguales(grafo, copia);
+        grafo_d_destruir(copia);
+        grafo_d_mapa_cerrar(mapa);
+    }
+
+    //Un grafo vacio tambien se puede guardar
+    Grafo_D* vacio=grafo_d_crear();
+    assert(grafo_d_guardar_binario(vacio, ruta, true));
+    Grafo_D_Mapa* mapa=grafo_d_mapear(ruta);
+    assert(mapa && mapa->orden==0 && mapa->tamano==0);
+    assert(grafo_d_mapa_dijkstra(mapa, 0, 0, NULL)==NULL);
+    Grafo_D* copia=grafo_d_desde_mapa(mapa);
+    assert(copia && grafo_d_isempty(copia));
+    grafo_d_destruir(copia);
+    grafo_d_mapa_cerrar(mapa);
+    grafo_d_destruir(vacio);
+
+    //Secciones danadas con una cabecera valida: un destino fuera de rango o indices que decrecen
+    assert(grafo_d_guardar_binario(grafo, ruta, true));
+    mapa=grafo_d_mapear(ruta);
+    assert(mapa && grafo_d_mapa_validar(mapa) && mapa->orden>2);
+    size_t pos_destinos=(size_t)((const char*)mapa->destinos-(const char*)mapa->base);
+    size_t pos_indices=(size_t)((const char*)mapa->indices-(const char*)mapa->base);
+    uint32_t destino=(uint32_t)mapa->orden;
+    uint64_t indice=UINT64_MAX;
+    grafo_d_mapa_cerrar(mapa);
+    sobrescribir(ruta, pos_destinos+sizeof(uint32_t)*(grafo->tamano-1), &destino, sizeof(destino));
+    mapa=grafo_d_mapear(ruta);
+    assert(mapa && !grafo_d_mapa_validar(mapa) && grafo_d_desde_mapa(mapa)==NULL);
+    grafo_d_mapa_cerrar(mapa);
+    assert(grafo_d_guardar_binario(grafo, ruta, true));
+    sobrescribir(ruta, pos_indices+sizeof(uint64_t), &indice, sizeof(indice));
+    mapa=grafo_d_mapear(ruta);
+    assert(mapa && !grafo_d_mapa_validar(mapa) && grafo_d_desde_mapa(mapa)==NULL);
+    grafo_d_mapa_cerrar(mapa);
+
+    //Archivos danados o inexistentes
+    assert(grafo_d_guardar_binario(grafo, ruta, true));
+    FILE* archivo=fopen(ruta, "r+b");
+    assert(archivo);
+    fputc('X', archivo);
+    fclose(archivo);
+    assert(grafo_d_mapear(ruta)==NULL);
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "no_existe.bin");
+    assert(grafo_d_mapear(ruta)==NULL);
+
+    grafo_d_destruir(grafo);
+    return 0;
+}
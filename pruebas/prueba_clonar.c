@@ -0,0 +1,76 @@
+/*  Copias con grafo_d_clonar(): estructura, tabla de traduccion, indices hash y su orden, e
+    independencia entre el original y la copia
+*/
+#include "comun.h"
+
+static size_t hash_vt(Vertice* vt) {return (size_t)*vt;}
+static size_t hash_ar(Arista* ar) {return (size_t)*ar%64;}
+
+int main(int argc, char** argv) {
+    (void)argc; (void)argv;
+    Grafo_D* grafo=grafo_d_crear();
+    assert(grafo_d_set_hash_vt(grafo, hash_vt) && grafo_d_set_hash_ar(grafo, hash_ar));
+    prueba_operaciones(grafo, 3, 5000);
+    //Aristas con contenidos repetidos para probar el orden del indice
+    unsigned semilla=3;
+    for(int i=0; i<500; ++i) {
+        Nodo_V* ini=grafo->lista_ady;
+        Nodo_V* fin=grafo->lista_ady;
+        for(unsigned k=prueba_azar(&semilla)%grafo->orden; k>0; --k) ini=ini->sig;
+        for(unsigned k=prueba_azar(&semilla)%grafo->orden; k>0; --k) fin=fin->sig;
+        grafo_d_insertar_arista(grafo, -(i%5), &(ini->vt), &(fin->vt));
+    }
+
+    Grafo_D_Traduccion* tr;
+    Grafo_D* copia=grafo_d_clonar(grafo, &tr);
+    assert(copia && tr);
+    prueba_iguales(grafo, copia);
+    assert(copia->indice_vt && copia->indice_ar && copia->hash_vt==hash_vt && copia->hash_ar==hash_ar);
+    assert(tr->num_vertices==grafo->orden && tr->num_aristas==grafo->tamano);
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) {
+        Vertice* nuevo=grafo_d_traducir_vertice(tr, &(vptr->vt));
+        assert(nuevo && nuevo!=&(vptr->vt) && *nuevo==vptr->vt);
+        assert(grafo_d_buscar_vertice(copia, vptr->vt)==nuevo);
+#ifdef GRAFO_D_IDS_32
+        assert(grafo_d_id(nuevo)==grafo_d_id(&(vptr->vt)));
+#endif
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig) {
+            Arista* ar=grafo_d_traducir_arista(tr, &(aptr->ar));
+            assert(ar && ar!=&(aptr->ar) && *ar==aptr->ar);
+        }
+    }
+
+    //Las busquedas en la copia regresan las aristas correspondientes en el mismo orden
+    for(Arista ref=-4; ref<=0; ++ref) {
+        const Vect_A* r1=grafo_d_buscar_aristas(grafo, ref);
+        const Vect_A* r2=grafo_d_buscar_aristas(copia, ref);
+        assert(r1 && r2 && r1->tamano==r2->tamano && r1->tamano>0);
+        for(size_t i=0; i<r1->tamano; ++i)
+            assert(grafo_d_traducir_arista(tr, r1->aristas[i])==r2->aristas[i]);
+        GRAFO_D_FREE((void*)r1);
+        GRAFO_D_FREE((void*)r2);
+    }
+    grafo_d_traduccion_destruir(tr);
+
+    //Modificar la copia no cambia el original
+    Grafo_D* respaldo=grafo_d_clonar(grafo, NULL);
+    assert(respaldo);
+    prueba_operaciones(copia, 4, 2000);
+    prueba_iguales(grafo, respaldo);
+    Grafo_D* otra=grafo_d_clonar(copia, NULL);
+    assert(otra);
+    prueba_iguales(copia, otra);
+    grafo_d_destruir(otra);
+    grafo_d_destruir(respaldo);
+    grafo_d_destruir(copia);
+    grafo_d_destruir(grafo);
+
+    //Grafo vacio
+    grafo=grafo_d_crear();
+    copia=grafo_d_clonar(grafo, &tr);
+    assert(copia && tr && tr->num_vertices==0 && grafo_d_isempty(copia));
+    grafo_d_traduccion_destruir(tr);
+    grafo_d_destruir(copia);
+    grafo_d_destruir(grafo);
+    return 0;
+}
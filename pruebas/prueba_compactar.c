@@ -0,0 +1,127 @@
+/*  Compactacion: tablas de traduccion de vertices y aristas, orden de la lista de vertices,
+    ordenes invalidos, indices hash y operaciones sobre los nodos de la region
+*/
+#include "comun.h"
+
+#define OPS 8000
+
+static Vertice* vts_ant[PRUEBA_MAX_VTS];
+static const Vertice* orden[PRUEBA_MAX_VTS];
+static Vertice valores[PRUEBA_MAX_VTS];
+static Arista* ars_ant[4*OPS];
+
+static size_t hash_vt(Vertice* vt) {return (size_t)*vt;}
+
+/*  Guarda los identificadores actuales de los vertices y aristas en el orden de las listas*/
+static void guardar(const Grafo_D* grafo) {
+    size_t i=0, k=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig, ++i) {
+        vts_ant[i]=&(vptr->vt);
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig) ars_ant[k++]=&(aptr->ar);
+    }
+    assert(i==grafo->orden && k==grafo->tamano);
+}
+
+/*  Verifica que la traduccion lleve cada identificador guardado al que ocupa la misma posicion
+    en las listas del grafo compactado y que los nodos esten en la region
+*/
+static void verificar(const Grafo_D* grafo, const Grafo_D_Traduccion* tr) {
+    size_t i=0, k=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig, ++i) {
+        assert(vptr==&(grafo->region_v[i]));
+        assert(grafo_d_traducir_vertice(tr, vts_ant[i])==&(vptr->vt));
+        if(vptr->grado_s>GRAFO_D_ADY_LOCAL)
+            assert(vptr->lotes && vptr->lotes->en_region && vptr->lotes->sig==NULL
+                && vptr->lotes->capacidad==vptr->grado_s-GRAFO_D_ADY_LOCAL);
+        else assert(vptr->lotes==NULL);
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig)
+            assert(grafo_d_traducir_arista(tr, ars_ant[k++])==&(aptr->ar));
+    }
+    assert(i==grafo->orden && k==grafo->tamano);
+}
+
+int main(void) {
+    //Dos grafos iguales, uno se compacta y el otro sirve de referencia
+    Grafo_D* grafo=grafo_d_crear();
+    Grafo_D* ref=grafo_d_crear();
+    prueba_operaciones(grafo, 44, OPS);
+    prueba_operaciones(ref, 44, OPS);
+    assert(grafo->orden>100 && grafo_d_set_hash_vt(grafo, hash_vt));
+    guardar(grafo);
+
+    Grafo_D_Traduccion* tr=grafo_d_compactar(grafo, NULL);
+    assert(tr);
+    prueba_iguales(grafo, ref);
+    verificar(grafo, tr);
+    //Un identificador que no era del grafo no se traduce
+    Vertice vt_ajeno=0;
+    Arista ar_ajena=0;
+    assert(grafo_d_traducir_vertice(tr, &vt_ajeno)==NULL && grafo_d_traducir_arista(tr, &ar_ajena)==NULL);
+    grafo_d_traduccion_destruir(tr);
+    //El indice de vertices se reconstruye con las nuevas direcciones
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig)
+        assert(grafo_d_buscar_vertice(grafo, vptr->vt)==&(vptr->vt));
+
+    //Ordenes invalidos: un vertice repetido o de otro grafo
+    size_t n=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) orden[grafo->orden-1-n++]=&(vptr->vt);
+    const Vertice* tmp=orden[1];
+    orden[1]=orden[0];
+    assert(grafo_d_compactar(grafo, orden)==NULL);
+    orden[1]=&(ref->lista_ady->vt);
+    assert(grafo_d_compactar(grafo, orden)==NULL);
+    orden[1]=tmp;
+    prueba_iguales(grafo, ref);
+
+    //Orden inverso de los vertices, volviendo a compactar los nodos de la region anterior
+    for(size_t i=0; i<n; ++i) valores[i]=*orden[i];
+    tr=grafo_d_compactar(grafo, orden);
+    assert(tr);
+    Nodo_V* vptr=grafo->lista_ady;
+    for(size_t i=0; i<n; ++i, vptr=vptr->sig) {
+        assert(vptr==&(grafo->region_v[i]) && vptr->vt==valores[i]);
+        assert(grafo_d_traducir_vertice(tr, orden[i])==&(vptr->vt));
+    }
+    assert(vptr==NULL && grafo->lista_fin==&(grafo->region_v[n-1]));
+    grafo_d_traduccion_destruir(tr);
+
+    //Se compacta de vuelta al orden de la referencia para seguir comparando
+    n=0;
+    for(Nodo_V* r=ref->lista_ady; r; r=r->sig) orden[n++]=grafo_d_buscar_vertice(grafo, r->vt);
+    tr=grafo_d_compactar(grafo, orden);
+    assert(tr);
+    grafo_d_traduccion_destruir(tr);
+    prueba_iguales(grafo, ref);
+
+    //Eliminar e insertar sobre los nodos de la region
+    for(int i=0; i<(int)n; i+=3) {
+        Vertice* vt=grafo_d_buscar_vertice(grafo, i);
+        if(!vt) continue;
+        grafo_d_eliminar_vertice(grafo, vt);
+        grafo_d_eliminar_vertice(ref, grafo_d_buscar_vertice(ref, i));
+    }
+    for(Nodo_V* v=grafo->lista_ady, *r=ref->lista_ady; v; v=v->sig, r=r->sig)
+        if(v->lista_ady) {
+            grafo_d_elminar_arista(grafo, &(v->lista_ady->ar));
+            grafo_d_elminar_arista(ref, &(r->lista_ady->ar));
+        }
+    prueba_operaciones(grafo, 45, OPS/2);
+    prueba_operaciones(ref, 45, OPS/2);
+    prueba_iguales(grafo, ref);
+    guardar(grafo);
+    tr=grafo_d_compactar(grafo, NULL);
+    assert(tr);
+    verificar(grafo, tr);
+    grafo_d_traduccion_destruir(tr);
+    prueba_iguales(grafo, ref);
+    grafo_d_destruir(ref);
+    grafo_d_destruir(grafo);
+
+    //Grafo vacio
+    grafo=grafo_d_crear();
+    tr=grafo_d_compactar(grafo, NULL);
+    assert(tr && tr->num_vertices==0 && tr->num_aristas==0 && grafo->lista_ady==NULL);
+    grafo_d_traduccion_destruir(tr);
+    grafo_d_destruir(grafo);
+    return 0;
+}
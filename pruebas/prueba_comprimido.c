@@ -0,0 +1,118 @@
+/*  Grafo comprimido: vecinos decodificados comparados con las listas del grafo y
+    grafo_d_comprimido_dijkstra() comparada con grafo_d_dijkstra()
+*/
+#include "comun.h"
+
+#define N 1000
+
+static peso_t peso(Arista* ar) {return *ar%9+1;}
+
+static Vertice* vts[N];
+static Nodo_V* nodos[N];
+
+/*  Verifica los vecinos de cada vertice: en orden de destino y, entre destinos iguales, en el
+    orden de la lista. Los valores de los vertices son distintos y menores a 2*N.
+*/
+static void verificar_vecinos(const Grafo_D_Comprimido* comp, const Grafo_D* grafo, size_t n) {
+    static size_t pos[2*N], destinos[6*N];
+    static Arista aristas[6*N];
+    assert(grafo_d_comprimido_orden(comp)==n && grafo_d_comprimido_tamano(comp)==grafo->tamano);
+    for(size_t i=0; i<n; ++i) pos[nodos[i]->vt]=i;
+    size_t a=0;
+    for(size_t i=0; i<n; ++i) {
+        assert(*grafo_d_comprimido_vertice(comp, i)==nodos[i]->vt);
+        assert(grafo_d_comprimido_grado(comp, i)==nodos[i]->grado_s);
+        //Ordenamiento por insercion, estable
+        size_t k=0;
+        for(Nodo_A* aptr=nodos[i]->lista_ady; aptr; aptr=aptr->sig, ++k) {
+            size_t d=pos[_GD_FIN(grafo, aptr)->vt], j=k;
+            for(; j>0 && destinos[j-1]>d; --j) {
+                destinos[j]=destinos[j-1];
+                aristas[j]=aristas[j-1];
+            }
+            destinos[j]=d;
+            aristas[j]=aptr->ar;
+        }
+        Iter_C it=grafo_d_comprimido_vecinos(comp, i);
+        for(size_t j=0; j<k; ++j, ++a) {
+            assert(iter_c_siguiente(&it) && it.arista==a && it.destino==destinos[j]);
+            assert(*grafo_d_comprimido_arista(comp, it.arista)==aristas[j]);
+        }
+        assert(!iter_c_siguiente(&it));
+    }
+    assert(a==grafo->tamano);
+}
+
+int main(void) {
+    //Vecinos cercanos y algunos lejanos para diferencias de uno y varios bytes
+    Grafo_D* grafo=grafo_d_crear();
+    for(int i=0; i<N; ++i) vts[i]=grafo_d_insertar_vertice(grafo, i);
+    unsigned semilla=42;
+    for(int i=0; i<6*N; ++i) {
+        int u=prueba_azar(&semilla)%N;
+        int v=i%5 ? (u+N-20+(int)(prueba_azar(&semilla)%40))%N : (int)(prueba_azar(&semilla)%N);
+        assert(grafo_d_insertar_arista(grafo, i, vts[u], vts[v]));
+    }
+    //Un vertice de grado alto con aristas paralelas
+    for(int i=0; i<200; ++i) assert(grafo_d_insertar_arista(grafo, 6*N+i, vts[7], vts[7+i%3]));
+    grafo_d_set_calc_peso(grafo, peso);
+    size_t n=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) nodos[n++]=vptr;
+
+    Grafo_D_Comprimido* con_pesos=grafo_d_comprimir(grafo, true);
+    Grafo_D_Comprimido* sin_pesos=grafo_d_comprimir(grafo, false);
+    assert(con_pesos && sin_pesos && sin_pesos->pesos==NULL);
+    assert(con_pesos->bytes<2*grafo->tamano+grafo->orden);
+    verificar_vecinos(con_pesos, grafo, n);
+
+    for(int i=0; i<N; i+=199)
+        for(int j=0; j<N; j+=23) {
+            Camino_D* esperado=grafo_d_dijkstra(grafo, vts[i], vts[j]);
+            Camino_D* c1=grafo_d_comprimido_dijkstra(con_pesos, i, j, NULL);
+            Camino_D* c2=grafo_d_comprimido_dijkstra(sin_pesos, i, j, peso);
+            assert(esperado && c1 && c2);
+            assert(es_camino_valido(esperado)==es_camino_valido(c1));
+            assert(es_camino_valido(c1)==es_camino_valido(c2));
+            if(es_camino_valido(esperado)) {
+                assert(c1->longitud==esperado->longitud && c2->longitud==esperado->longitud);
+                assert(*c1->vts[0]==i && *c1->vts[c1->saltos]==j);
+                peso_t total=0;
+                for(size_t s=0; s<c1->saltos; ++s) total+=peso(c1->ars[s]);
+                assert(total==c1->longitud);
+            }
+            camino_d_destruir(esperado);
+            camino_d_destruir(c1);
+            camino_d_destruir(c2);
+        }
+    //Sin pesos guardados ni funcion no hay camino
+    assert(grafo_d_comprimido_dijkstra(sin_pesos, 0, 1, NULL)==NULL);
+    //Posiciones fuera de rango
+    assert(grafo_d_comprimido_dijkstra(con_pesos, N, 0, NULL)==NULL);
+    assert(grafo_d_comprimido_dijkstra(sin_pesos, 0, N, peso)==NULL);
+
+    //La copia comprimida no depende del grafo original
+    Camino_D* antes=grafo_d_comprimido_dijkstra(con_pesos, 1, 2, NULL);
+    grafo_d_destruir(grafo);
+    Camino_D* despues=grafo_d_comprimido_dijkstra(con_pesos, 1, 2, NULL);
+    assert(antes && despues && antes->longitud==despues->longitud && antes->saltos==despues->saltos);
+    camino_d_destruir(antes);
+    camino_d_destruir(despues);
+    grafo_d_comprimido_destruir(con_pesos);
+    grafo_d_comprimido_destruir(sin_pesos);
+
+    //Grafo vacio y grafo despues de operaciones al azar
+    grafo=grafo_d_crear();
+    Grafo_D_Comprimido* comp=grafo_d_comprimir(grafo, true);
+    assert(comp && grafo_d_comprimido_orden(comp)==0 && grafo_d_comprimido_tamano(comp)==0);
+    assert(grafo_d_comprimido_dijkstra(comp, 0, 0, NULL)==NULL);
+    grafo_d_comprimido_destruir(comp);
+    prueba_operaciones(grafo, 43, 2*N);
+    n=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) nodos[n++]=vptr;
+    comp=grafo_d_comprimir(grafo, false);
+    assert(comp);
+    verificar_vecinos(comp, grafo, n);
+    grafo_d_comprimido_destruir(comp);
+    grafo_d_destruir(grafo);
+    return 0;
+}
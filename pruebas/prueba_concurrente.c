@@ -0,0 +1,75 @@
+/*  Modo GRAFO_D_CONCURRENTE: varios hilos consultan el grafo mientras otro lo modifica. Se define
+    _POSIX_C_SOURCE para que la prueba compile tambien con -std=c99.
+*/
+#define _POSIX_C_SOURCE 200809L
+#ifndef GRAFO_D_CONCURRENTE
+#define GRAFO_D_CONCURRENTE
+#endif
+#include "comun.h"
+
+#define NUM_VTS 200
+#define NUM_LECTORES 4
+#define NUM_INSERCIONES 3000
+
+static Grafo_D* grafo;
+static Vertice* vts[NUM_VTS];
+static pthread_mutex_t candado=PTHREAD_MUTEX_INITIALIZER;
+static bool terminado=false;
+
+static bool leer_terminado(void) {
+    pthread_mutex_lock(&candado);
+    bool valor=terminado;
+    pthread_mutex_unlock(&candado);
+    return valor;
+}
+
+static void* lector(void* arg) {
+    unsigned semilla=(unsigned)(size_t)arg;
+    while(!leer_terminado()) {
+        Vertice* ini=vts[prueba_azar(&semilla)%NUM_VTS];
+        Vertice* fin=vts[prueba_azar(&semilla)%NUM_VTS];
+        Camino_D* camino=grafo_d_dijkstra(grafo, ini, fin);
+        assert(camino && es_camino_valido(camino));
+        camino_d_destruir(camino);
+        const Vect_A* aristas=grafo_d_buscar_aristas_entre_vert(grafo, ini, fin);
+        assert(aristas);
+        GRAFO_D_FREE((void*)aristas);
+    }
+    return NULL;
+}
+
+static void* escritor(void* arg) {
+    unsigned semilla=(unsigned)(size_t)arg;
+    for(int i=0; i<NUM_INSERCIONES; ++i) {
+        Vertice* ini=vts[prueba_azar(&semilla)%NUM_VTS];
+        Arista* ar=grafo_d_insertar_arista(grafo, i, ini, vts[prueba_azar(&semilla)%NUM_VTS]);
+        assert(ar);
+        if(i%2) grafo_d_elminar_arista(grafo, ar);
+    }
+    pthread_mutex_lock(&candado);
+    terminado=true;
+    pthread_mutex_unlock(&candado);
+    return NULL;
+}
+
+int main(int argc, char** argv) {
+    (void)argc; (void)argv;
+    grafo=grafo_d_crear();
+    for(int i=0; i<NUM_VTS; ++i) vts[i]=grafo_d_insertar_vertice(grafo, i);
+    //Un ciclo en ambos sentidos para que todos los caminos existan
+    for(int i=0; i<NUM_VTS; ++i) assert(grafo_d_insertar_arpar(grafo, 1, vts[i], vts[(i+1)%NUM_VTS]));
+
+    pthread_t hilos[NUM_LECTORES+1];
+    for(size_t i=0; i<NUM_LECTORES; ++i) assert(pthread_create(&hilos[i], NULL, lector, (void*)(i+1))==0);
+    assert(pthread_create(&hilos[NUM_LECTORES], NULL, escritor, (void*)(size_t)99)==0);
+    for(int i=0; i<=NUM_LECTORES; ++i) pthread_join(hilos[i], NULL);
+
+    grafo_d_bloquear_lectura(grafo);
+    Iter_A it=grafo_d_iter_aristas(grafo);
+    size_t total=0;
+    while(iter_a_siguiente(&it)) ++total;
+    grafo_d_desbloquear(grafo);
+    assert(total==grafo->tamano && total==2*NUM_VTS+NUM_INSERCIONES/2);
+    grafo_d_destruir(grafo);
+    return 0;
+}
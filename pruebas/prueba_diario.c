@@ -0,0 +1,52 @@
+/*  Diario de operaciones: grafo_d_diario_iniciar(), puntos de control, grafo_d_diario_terminar()
+    y grafo_d_diario_recuperar(), incluyendo un registro final incompleto
+*/
+#include "comun.h"
+
+int main(int argc, char** argv) {
+    assert(argc>1);
+    char ruta[512], log[512];
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "diario");
+    prueba_ruta(log, sizeof(log), argv[1], "diario.log");
+
+    //El grafo de referencia recibe las mismas operaciones sin diario
+    Grafo_D* referencia=grafo_d_crear();
+    Grafo_D* grafo=grafo_d_crear();
+    prueba_operaciones(referencia, 7, 1000);
+    prueba_operaciones(grafo, 7, 1000);
+    assert(grafo_d_diario_iniciar(grafo, ruta));
+    prueba_operaciones(referencia, 8, 2000);
+    prueba_operaciones(grafo, 8, 2000);
+    assert(grafo_d_diario_sincronizar(grafo));
+    assert(grafo_d_diario_punto_control(grafo));
+    prueba_operaciones(referencia, 9, 2000);
+    prueba_operaciones(grafo, 9, 2000);
+    assert(grafo_d_diario_terminar(grafo));
+    grafo_d_destruir(grafo);
+
+    Grafo_D* recuperado=grafo_d_diario_recuperar(ruta);
+    assert(recuperado);
+    prueba_iguales(referencia, recuperado);
+
+    //El grafo recuperado sigue registrando sus operaciones en la misma ruta
+    prueba_operaciones(referencia, 10, 500);
+    prueba_operaciones(recuperado, 10, 500);
+    assert(grafo_d_diario_terminar(recuperado));
+    grafo_d_destruir(recuperado);
+
+    //Un registro incompleto al final del archivo se descarta
+    FILE* archivo=fopen(log, "ab");
+    assert(archivo);
+    fputc(3, archivo);
+    fputc(0, archivo);
+    fclose(archivo);
+    recuperado=grafo_d_diario_recuperar(ruta);
+    assert(recuperado);
+    prueba_iguales(referencia, recuperado);
+    grafo_d_destruir(recuperado);
+
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "no_existe");
+    assert(grafo_d_diario_recuperar(ruta)==NULL);
+    grafo_d_destruir(referencia);
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*  grafo_d_dijkstra() comparada con las distancias de Floyd-Warshall sobre la matriz de pesos,
+    incluyendo caminos sin aristas y vertices inalcanzables
+*/
+#include "comun.h"
+
+#define N 60
+
+static peso_t peso(Arista* ar) {return *ar%11+1;}
+
+static peso_t dist[N][N];
+
+int main(void) {
+    Vertice* vts[N+1];
+    Grafo_D* grafo=prueba_grafo_azar(39, N, 200, vts);
+    grafo_d_set_calc_peso(grafo, peso);
+    //Un vertice sin aristas de entrada ni de salida
+    vts[N]=grafo_d_insertar_vertice(grafo, N);
+
+    for(int i=0; i<N; ++i)
+        for(int j=0; j<N; ++j) dist[i][j]=(i==j) ? 0 : PESO_NO_ARISTA;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig) {
+            peso_t* d=&dist[vptr->vt][_GD_FIN(grafo, aptr)->vt];
+            if(peso(&(aptr->ar))<*d) *d=peso(&(aptr->ar));
+        }
+    for(int k=0; k<N; ++k)
+        for(int i=0; i<N; ++i)
+            for(int j=0; j<N; ++j)
+                if(dist[i][k]!=PESO_NO_ARISTA && dist[k][j]!=PESO_NO_ARISTA
+                    && dist[i][k]+dist[k][j]<dist[i][j]) dist[i][j]=dist[i][k]+dist[k][j];
+
+    for(int i=0; i<N; ++i)
+        for(int j=0; j<N; ++j) {
+            Camino_D* camino=grafo_d_dijkstra(grafo, vts[i], vts[j]);
+            assert(camino);
+            if(dist[i][j]==PESO_NO_ARISTA) assert(!es_camino_valido(camino));
+            else {
+                assert(es_camino_valido(camino) && camino->longitud==dist[i][j]);
+                assert(camino->vts[0]==vts[i] && camino->vts[camino->saltos]==vts[j]);
+            }
+            //El camino de un vertice a si mismo no tiene aristas
+            if(i==j) assert(camino->saltos==0 && camino->ars==NULL);
+            camino_d_destruir(camino);
+        }
+    for(int i=0; i<N; i+=10) {
+        Camino_D* camino=grafo_d_dijkstra(grafo, vts[i], vts[N]);
+        assert(camino && !es_camino_valido(camino));
+        camino_d_destruir(camino);
+    }
+    Camino_D* camino=grafo_d_dijkstra(grafo, vts[N], vts[N]);
+    assert(camino && es_camino_valido(camino) && camino->saltos==0 && camino->longitud==0);
+    camino_d_destruir(camino);
+    grafo_d_destruir(grafo);
+    return 0;
+}
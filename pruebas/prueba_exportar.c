@@ -0,0 +1,117 @@
+/*  Exportacion: texto exacto de grafo_d_exportar_lista() y grafo_d_exportar_dot() para un grafo
+    pequeno, exportacion de un grafo grande con el bufer minimo y lectura de vuelta con
+    grafo_d_cargar_texto()
+*/
+#include <string.h>
+#include "comun.h"
+
+#define M 3000
+
+typedef struct {int ini, fin, ar;} Terna;
+
+static char bufer[GD_TAM_CAMPO_ES];
+static char leido[1<<16];
+static Terna originales[M], copiadas[M];
+
+static int cmp_terna(const void* a, const void* b) {
+    const Terna* x=(const Terna*)a;
+    const Terna* y=(const Terna*)b;
+    if(x->ini!=y->ini) return x->ini<y->ini ? -1 : 1;
+    if(x->fin!=y->fin) return x->fin<y->fin ? -1 : 1;
+    return (x->ar>y->ar)-(x->ar<y->ar);
+}
+
+/*  Guarda en t las M aristas del grafo ordenadas*/
+static void aristas(const Grafo_D* grafo, Terna* t) {
+    assert(grafo->tamano==M);
+    size_t n=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig, ++n) {
+            t[n].ini=vptr->vt;
+            t[n].fin=_GD_FIN(grafo, aptr)->vt;
+            t[n].ar=aptr->ar;
+        }
+    qsort(t, M, sizeof(Terna), cmp_terna);
+}
+
+/*  Lee el archivo completo en leido*/
+static const char* leer(const char* ruta) {
+    FILE* archivo=fopen(ruta, "rb");
+    assert(archivo);
+    size_t n=fread(leido, 1, sizeof(leido)-1, archivo);
+    fclose(archivo);
+    leido[n]='\0';
+    return leido;
+}
+
+static size_t fmt_vt(const Vertice* vt, char* buf, size_t cap) {
+    return (size_t)snprintf(buf, cap, "v%d", (int)*vt);
+}
+
+static size_t fmt_ar(const Arista* ar, char* buf, size_t cap) {
+    return (size_t)snprintf(buf, cap, "%d km", (int)*ar);
+}
+
+/*  Regresa una longitud mayor al espacio disponible*/
+static size_t fmt_largo(const Arista* ar, char* buf, size_t cap) {
+    (void)ar; (void)buf;
+    return cap+1;
+}
+
+int main(int argc, char** argv) {
+    assert(argc>1);
+    char ruta[512];
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "exportado.txt");
+
+    //Las aristas se insertan al principio de la lista de su vertice
+    Grafo_D* grafo=grafo_d_crear();
+    Vertice* a=grafo_d_insertar_vertice(grafo, 1);
+    Vertice* b=grafo_d_insertar_vertice(grafo, -2);
+    Vertice* c=grafo_d_insertar_vertice(grafo, 30);
+    grafo_d_insertar_vertice(grafo, 4);
+    assert(grafo_d_insertar_arista(grafo, 10, a, b));
+    assert(grafo_d_insertar_arista(grafo, -5, a, c));
+    assert(grafo_d_insertar_arista(grafo, 0, c, a));
+
+    FILE* archivo=fopen(ruta, "wb");
+    assert(archivo && grafo_d_exportar_lista(grafo, archivo, bufer, sizeof(bufer), NULL, NULL));
+    fclose(archivo);
+    assert(strcmp(leer(ruta), "1\t30\t-5\n1\t-2\t10\n30\t1\t0\n")==0);
+
+    archivo=fopen(ruta, "wb");
+    assert(archivo && grafo_d_exportar_lista(grafo, archivo, bufer, sizeof(bufer), fmt_vt, fmt_ar));
+    fclose(archivo);
+    assert(strcmp(leer(ruta), "v1\tv30\t-5 km\nv1\tv-2\t10 km\nv30\tv1\t0 km\n")==0);
+
+    archivo=fopen(ruta, "wb");
+    assert(archivo && grafo_d_exportar_dot(grafo, archivo, "prueba", bufer, sizeof(bufer), fmt_vt, NULL));
+    fclose(archivo);
+    assert(strcmp(leer(ruta),
+        "digraph \"prueba\" {\n"
+        "  \"v1\";\n  \"v-2\";\n  \"v30\";\n  \"v4\";\n"
+        "  \"v1\" -> \"v30\" [label=\"-5\"];\n"
+        "  \"v1\" -> \"v-2\" [label=\"10\"];\n"
+        "  \"v30\" -> \"v1\" [label=\"0\"];\n"
+        "}\n")==0);
+
+    //Un texto mas largo que el espacio disponible es un error
+    archivo=fopen(ruta, "wb");
+    assert(archivo && !grafo_d_exportar_lista(grafo, archivo, bufer, sizeof(bufer), NULL, fmt_largo));
+    fclose(archivo);
+    grafo_d_destruir(grafo);
+
+    //Un grafo grande exportado con el bufer minimo se lee de vuelta igual
+    Vertice* vts[500];
+    grafo=prueba_grafo_azar(40, 500, M, vts);
+    archivo=fopen(ruta, "wb");
+    assert(archivo && grafo_d_exportar_lista(grafo, archivo, bufer, sizeof(bufer), NULL, NULL));
+    fclose(archivo);
+    Grafo_D* copia=grafo_d_crear();
+    assert(grafo_d_cargar_texto(copia, ruta, GD_TEXTO_LISTA, NULL, NULL, 1));
+    aristas(grafo, originales);
+    aristas(copia, copiadas);
+    assert(memcmp(originales, copiadas, sizeof(originales))==0);
+    grafo_d_destruir(copia);
+    grafo_d_destruir(grafo);
+    return 0;
+}
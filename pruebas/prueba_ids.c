@@ -0,0 +1,83 @@
+/*  Identificadores numericos de GRAFO_D_IDS_32: asignacion densa, reutilizacion, consultas y
+    renumeracion al guardar y recuperar el grafo
+*/
+#ifndef GRAFO_D_IDS_32
+#define GRAFO_D_IDS_32
+#endif
+#include "comun.h"
+
+/*  Verifica que los identificadores del grafo sean exactamente [0, orden)*/
+static void verificar_densos(const Grafo_D* grafo) {
+    bool usado[PRUEBA_MAX_VTS]={false};
+    assert(grafo_d_limite_ids(grafo)==grafo->orden && grafo->orden<=PRUEBA_MAX_VTS);
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) {
+        uint32_t id=grafo_d_id(&(vptr->vt));
+        assert(id<grafo->orden && !usado[id]);
+        assert(grafo_d_vertice_por_id(grafo, id)==&(vptr->vt));
+        usado[id]=true;
+    }
+}
+
+int main(int argc, char** argv) {
+    assert(argc>1);
+    char ruta[512];
+    Grafo_D* grafo=grafo_d_crear();
+    Vertice* vts[100];
+    for(int i=0; i<100; ++i) {
+        vts[i]=grafo_d_insertar_vertice(grafo, i);
+        assert(grafo_d_id(vts[i])==(uint32_t)i && grafo_d_vertice_por_id(grafo, i)==vts[i]);
+    }
+    for(int i=0; i<100; ++i) {
+        Arista* ar=grafo_d_insertar_arista(grafo, i, vts[i], vts[(i*7+1)%100]);
+        assert(grafo_d_destino_id(ar)==(uint32_t)((i*7+1)%100));
+    }
+    assert(grafo_d_limite_ids(grafo)==100 && grafo_d_vertice_por_id(grafo, 100)==NULL);
+
+    Camino_D* camino=grafo_d_dijkstra(grafo, vts[0], vts[8]);
+    assert(camino && es_camino_valido(camino));
+    uint32_t* ids=grafo_d_camino_ids(camino);
+    assert(ids && ids[0]==0 && ids[camino->saltos]==8);
+    for(size_t i=0; i<=camino->saltos; ++i) assert(grafo_d_vertice_por_id(grafo, ids[i])==camino->vts[i]);
+    GRAFO_D_FREE(ids);
+    camino_d_destruir(camino);
+
+    //Los identificadores de los vertices eliminados se reutilizan
+    grafo_d_eliminar_vertice(grafo, vts[10]);
+    grafo_d_eliminar_vertice(grafo, vts[20]);
+    assert(grafo_d_vertice_por_id(grafo, 10)==NULL && grafo_d_vertice_por_id(grafo, 20)==NULL);
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig)
+            assert(aptr->fin!=10 && aptr->fin!=20);
+    Vertice* v1=grafo_d_insertar_vertice(grafo, 1000);
+    Vertice* v2=grafo_d_insertar_vertice(grafo, 1001);
+    Vertice* v3=grafo_d_insertar_vertice(grafo, 1002);
+    assert(grafo_d_id(v1)==20 && grafo_d_id(v2)==10 && grafo_d_id(v3)==100);
+    assert(grafo_d_limite_ids(grafo)==101);
+
+    //El formato binario y el diario no guardan los identificadores: se numeran de nuevo sin huecos
+    grafo_d_eliminar_vertice(grafo, vts[50]);
+    assert(grafo_d_limite_ids(grafo)>grafo->orden);
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "ids.bin");
+    assert(grafo_d_guardar_binario(grafo, ruta, false));
+    Grafo_D_Mapa* mapa=grafo_d_mapear(ruta);
+    assert(mapa);
+    Grafo_D* copia=grafo_d_desde_mapa(mapa);
+    assert(copia);
+    prueba_iguales(grafo, copia);
+    verificar_densos(copia);
+    grafo_d_destruir(copia);
+    grafo_d_mapa_cerrar(mapa);
+
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "ids");
+    assert(grafo_d_diario_iniciar(grafo, ruta));
+    grafo_d_insertar_arista(grafo, 0, v3, grafo_d_insertar_vertice(grafo, 1003));
+    assert(grafo_d_diario_terminar(grafo));
+    copia=grafo_d_diario_recuperar(ruta);
+    assert(copia);
+    prueba_iguales(grafo, copia);
+    verificar_densos(copia);
+    grafo_d_destruir(copia);
+
+    grafo_d_destruir(grafo);
+    return 0;
+}
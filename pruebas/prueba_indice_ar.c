@@ -0,0 +1,113 @@
+/*  Indice hash de aristas: grafo_d_buscar_arista(s) con indice comparadas con un recorrido de
+    las listas de adyacencia, a traves de inserciones y eliminaciones de aristas y vertices, y
+    orden de los resultados: el del grafo al crear el indice y despues el de insercion
+*/
+#include "comun.h"
+
+#define MAX_ENCONTRADAS 4096
+
+static size_t hash_ar(Arista* ar) {return (size_t)*ar%16;}
+
+static Arista* insertadas[20][MAX_ENCONTRADAS];
+static size_t num_insertadas[20];
+
+/*  Verifica que la busqueda del valor ref regrese exactamente las n aristas, en ese orden*/
+static void verificar_orden(const Grafo_D* grafo, Arista ref, Arista* const* esperadas, size_t n) {
+    const Vect_A* encontradas=grafo_d_buscar_aristas(grafo, ref);
+    assert(encontradas && encontradas->tamano==n);
+    for(size_t i=0; i<n; ++i) assert(encontradas->aristas[i]==esperadas[i]);
+    GRAFO_D_FREE((void*)encontradas);
+}
+
+/*  Verifica que las busquedas del valor ref regresen exactamente las aristas que lo contienen*/
+static void verificar(const Grafo_D* grafo, Arista ref) {
+    static Arista* esperadas[MAX_ENCONTRADAS];
+    size_t n=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig)
+            if(aptr->ar==ref) {
+                assert(n<MAX_ENCONTRADAS);
+                esperadas[n++]=&(aptr->ar);
+            }
+    const Vect_A* encontradas=grafo_d_buscar_aristas(grafo, ref);
+    assert(encontradas && encontradas->tamano==n);
+    for(size_t i=0; i<n; ++i) {
+        size_t k=0;
+        while(k<n && esperadas[k]!=encontradas->aristas[i]) ++k;
+        assert(k<n);
+        esperadas[k]=NULL;
+    }
+    GRAFO_D_FREE((void*)encontradas);
+    Arista* primera=grafo_d_buscar_arista(grafo, ref);
+    assert(n ? primera && *primera==ref : primera==NULL);
+}
+
+int main(void) {
+    Grafo_D* grafo=grafo_d_crear();
+    prueba_operaciones(grafo, 21, 3000);
+    assert(grafo_d_set_hash_ar(grafo, hash_ar) && grafo->indice_ar);
+    //Un indice nuevo sigue el orden del grafo
+    static Arista* en_lista[MAX_ENCONTRADAS];
+    for(Arista ref=1; ref<3000; ref+=37) {
+        size_t m=0;
+        for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig)
+            for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig)
+                if(aptr->ar==ref) en_lista[m++]=&(aptr->ar);
+        verificar_orden(grafo, ref, en_lista, m);
+    }
+
+    //Aristas con valores repetidos insertadas con el indice activo
+    Vertice* vts[PRUEBA_MAX_VTS];
+    size_t n=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) vts[n++]=&(vptr->vt);
+    unsigned semilla=22;
+    for(int i=0; i<2000; ++i) {
+        Vertice* ini=vts[prueba_azar(&semilla)%n];
+        Arista* ar=grafo_d_insertar_arista(grafo, -(i%20), ini, vts[prueba_azar(&semilla)%n]);
+        assert(ar);
+        insertadas[i%20][num_insertadas[i%20]++]=ar;
+    }
+    //Las aristas insertadas despues se encuentran en orden de insercion
+    for(int k=0; k<20; ++k) verificar_orden(grafo, -k, insertadas[k], num_insertadas[k]);
+    for(Arista ref=-25; ref<=0; ++ref) verificar(grafo, ref);
+    for(Arista ref=1; ref<3000; ref+=37) verificar(grafo, ref);
+
+    //Eliminar aristas repetidas y vertices mantiene el indice
+    for(int i=0; i<600; ++i) {
+        const Vect_A* r=grafo_d_buscar_aristas(grafo, -(Arista)(prueba_azar(&semilla)%20));
+        assert(r);
+        if(r->tamano) grafo_d_elminar_arista(grafo, r->aristas[prueba_azar(&semilla)%r->tamano]);
+        GRAFO_D_FREE((void*)r);
+    }
+    for(int i=0; i<50; ++i) {
+        size_t k=prueba_azar(&semilla)%n;
+        grafo_d_eliminar_vertice(grafo, vts[k]);
+        vts[k]=vts[--n];
+    }
+    prueba_operaciones(grafo, 23, 2000);
+    for(Arista ref=-25; ref<=0; ++ref) verificar(grafo, ref);
+    for(Arista ref=1; ref<3000; ref+=37) verificar(grafo, ref);
+
+    //Compactar conserva el orden del indice
+    for(int k=0; k<20; ++k) {
+        const Vect_A* r=grafo_d_buscar_aristas(grafo, -k);
+        assert(r);
+        num_insertadas[k]=r->tamano;
+        for(size_t i=0; i<r->tamano; ++i) insertadas[k][i]=r->aristas[i];
+        GRAFO_D_FREE((void*)r);
+    }
+    Grafo_D_Traduccion* tr=grafo_d_compactar(grafo, NULL);
+    assert(tr);
+    for(int k=0; k<20; ++k) {
+        for(size_t i=0; i<num_insertadas[k]; ++i) insertadas[k][i]=grafo_d_traducir_arista(tr, insertadas[k][i]);
+        verificar_orden(grafo, -k, insertadas[k], num_insertadas[k]);
+    }
+    grafo_d_traduccion_destruir(tr);
+
+    //Sin indice las busquedas dan el mismo resultado
+    grafo_d_unset_hash_ar(grafo);
+    assert(grafo->indice_ar==NULL);
+    for(Arista ref=-20; ref<=0; ++ref) verificar(grafo, ref);
+    grafo_d_destruir(grafo);
+    return 0;
+}
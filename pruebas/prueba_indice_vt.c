@@ -0,0 +1,52 @@
+/*  Indice hash de vertices: grafo_d_buscar_vertice(s) con indice comparadas con un recorrido de
+    la lista de vertices, a traves de inserciones y eliminaciones
+*/
+#include "comun.h"
+
+static size_t hash_vt(Vertice* vt) {return (size_t)*vt%17;}
+
+/*  Verifica las busquedas del valor ref contra un recorrido de la lista*/
+static void verificar(const Grafo_D* grafo, Vertice ref) {
+    const Vect_V* encontrados=grafo_d_buscar_vertices(grafo, ref);
+    assert(encontrados);
+    size_t k=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig)
+        if(vptr->vt==ref) {
+            assert(k<encontrados->tamano && encontrados->vertices[k]==&(vptr->vt));
+            ++k;
+        }
+    assert(k==encontrados->tamano);
+    assert(grafo_d_buscar_vertice(grafo, ref)==(k ? encontrados->vertices[0] : NULL));
+    GRAFO_D_FREE((void*)encontrados);
+}
+
+int main(void) {
+    Grafo_D* grafo=grafo_d_crear();
+    Vertice* vts[2000];
+    //Valores repetidos para que varios vertices coincidan con cada busqueda
+    for(int i=0; i<1000; ++i) vts[i]=grafo_d_insertar_vertice(grafo, i%300);
+    assert(grafo_d_set_hash_vt(grafo, hash_vt) && grafo->indice_vt);
+    for(int i=1000; i<2000; ++i) vts[i]=grafo_d_insertar_vertice(grafo, i%300);
+    for(int ref=-5; ref<305; ++ref) verificar(grafo, ref);
+
+    unsigned semilla=8;
+    for(int i=0; i<700; ++i) {
+        size_t k=prueba_azar(&semilla)%2000;
+        if(vts[k]) {
+            grafo_d_eliminar_vertice(grafo, vts[k]);
+            vts[k]=NULL;
+        }
+    }
+    for(int ref=0; ref<300; ++ref) verificar(grafo, ref);
+
+    //Sin indice las busquedas dan el mismo resultado
+    grafo_d_unset_hash_vt(grafo);
+    assert(grafo->indice_vt==NULL);
+    for(int ref=0; ref<300; ref+=7) verificar(grafo, ref);
+    grafo_d_destruir(grafo);
+
+    const char a[]="ciudad", b[]="ciudae";
+    assert(grafo_d_hash_bytes(a, sizeof(a))==grafo_d_hash_bytes(a, sizeof(a)));
+    assert(grafo_d_hash_bytes(a, sizeof(a))!=grafo_d_hash_bytes(b, sizeof(b)));
+    return 0;
+}
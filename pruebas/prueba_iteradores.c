@@ -0,0 +1,113 @@
+/*  Iteradores: cada Iter_V e Iter_A comparado con el resultado de la funcion grafo_d_buscar_*
+    correspondiente, con y sin indices hash, avanzando de uno en uno y por lotes
+*/
+#include "comun.h"
+
+#define N 150
+#define MAX_RES 20000
+
+static size_t hash_vt(Vertice* vt) {return (size_t)*vt%7;}
+static size_t hash_ar(Arista* ar) {return (size_t)*ar%7;}
+
+static Vertice* res_v[MAX_RES];
+static Arista* res_a[MAX_RES];
+
+/*  Verifica que el iterador produzca los vertices del vector, de uno en uno y por lotes*/
+static void comparar_v(Iter_V it, const Vect_V* esperado) {
+    Iter_V lotes=it;
+    size_t n=0;
+    Vertice* vt;
+    while((vt=iter_v_siguiente(&it))) {
+        assert(n<esperado->tamano && vt==esperado->vertices[n]);
+        ++n;
+    }
+    assert(n==esperado->tamano && iter_v_siguiente(&it)==NULL);
+    n=0;
+    for(size_t k; (k=iter_v_llenar(&lotes, res_v+n, 7))>0; n+=k) assert(n+k<=esperado->tamano);
+    assert(n==esperado->tamano);
+    for(size_t i=0; i<n; ++i) assert(res_v[i]==esperado->vertices[i]);
+    GRAFO_D_FREE((void*)esperado);
+}
+
+/*  Verifica que el iterador produzca las aristas del vector, de uno en uno y por lotes*/
+static void comparar_a(Iter_A it, const Vect_A* esperado) {
+    Iter_A lotes=it;
+    size_t n=0;
+    Arista* ar;
+    while((ar=iter_a_siguiente(&it))) {
+        assert(n<esperado->tamano && ar==esperado->aristas[n]);
+        ++n;
+    }
+    assert(n==esperado->tamano && iter_a_siguiente(&it)==NULL);
+    n=0;
+    for(size_t k; (k=iter_a_llenar(&lotes, res_a+n, 5))>0; n+=k) assert(n+k<=esperado->tamano);
+    assert(n==esperado->tamano);
+    for(size_t i=0; i<n; ++i) assert(res_a[i]==esperado->aristas[i]);
+    GRAFO_D_FREE((void*)esperado);
+}
+
+/*  Crea un vector con las aristas de salida del nodo en el orden de su lista*/
+static const Vect_A* aristas_de(const Nodo_V* vptr) {
+    Vect_A* vector=(Vect_A*)malloc(sizeof(Vect_A)+sizeof(Arista*)*vptr->grado_s);
+    assert(vector);
+    vector->tamano=0;
+    for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig) vector->aristas[vector->tamano++]=&(aptr->ar);
+    return vector;
+}
+
+static void verificar(const Grafo_D* grafo, Vertice** vts) {
+    //Recorridos completos contra las listas
+    Vect_V* todos=(Vect_V*)malloc(sizeof(Vect_V)+sizeof(Vertice*)*grafo->orden);
+    Vect_A* todas=(Vect_A*)malloc(sizeof(Vect_A)+sizeof(Arista*)*grafo->tamano);
+    assert(todos && todas);
+    todos->tamano=todas->tamano=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) {
+        todos->vertices[todos->tamano++]=&(vptr->vt);
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig) todas->aristas[todas->tamano++]=&(aptr->ar);
+    }
+    comparar_v(grafo_d_iter_vertices(grafo), todos);
+    comparar_a(grafo_d_iter_aristas(grafo), todas);
+
+    for(Vertice ref=-1; ref<8; ++ref) comparar_v(grafo_d_iter_vertices_filtro(grafo, ref), grafo_d_buscar_vertices(grafo, ref));
+    for(Arista ref=-1; ref<8; ++ref) comparar_a(grafo_d_iter_aristas_filtro(grafo, ref), grafo_d_buscar_aristas(grafo, ref));
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) {
+        comparar_a(grafo_d_iter_aristas_de(grafo, &(vptr->vt)), aristas_de(vptr));
+        //El destino de cada arista producida es el de su nodo
+        Iter_A it=grafo_d_iter_aristas_de(grafo, &(vptr->vt));
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig) {
+            assert(iter_a_siguiente(&it)==&(aptr->ar));
+            assert(iter_a_destino(&it)==&(_GD_FIN(grafo, aptr)->vt));
+        }
+    }
+    for(int i=0; i<N; i+=(i<3 ? 1 : 11))
+        for(int j=0; j<N; ++j) {
+            comparar_a(grafo_d_iter_aristas_entre_vert(grafo, vts[i], vts[j]),
+                grafo_d_buscar_aristas_entre_vert(grafo, vts[i], vts[j]));
+            comparar_a(grafo_d_iter_aristas_estricto(grafo, j%7, vts[i], vts[j]),
+                grafo_d_buscar_aristas_estricto(grafo, j%7, vts[i], vts[j]));
+        }
+}
+
+int main(void) {
+    Vertice* vts[N];
+    Grafo_D* grafo=grafo_d_crear();
+    for(int i=0; i<N; ++i) assert((vts[i]=grafo_d_insertar_vertice(grafo, i%10)));
+    unsigned semilla=40;
+    for(int i=0; i<4000; ++i) {
+        //Los tres primeros vertices rebasan el umbral de la tabla de vecinos
+        Vertice* ini=vts[prueba_azar(&semilla)%(i%2 ? 3 : N)];
+        assert(grafo_d_insertar_arista(grafo, i%10, ini, vts[prueba_azar(&semilla)%N]));
+    }
+    verificar(grafo, vts);
+    assert(grafo_d_set_hash_vt(grafo, hash_vt) && grafo_d_set_hash_ar(grafo, hash_ar));
+    verificar(grafo, vts);
+
+    //Grafo vacio
+    grafo_d_destruir(grafo);
+    grafo=grafo_d_crear();
+    Iter_V it_v=grafo_d_iter_vertices(grafo);
+    Iter_A it_a=grafo_d_iter_aristas(grafo);
+    assert(iter_v_siguiente(&it_v)==NULL && iter_a_siguiente(&it_a)==NULL);
+    grafo_d_destruir(grafo);
+    return 0;
+}
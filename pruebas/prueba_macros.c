@@ -0,0 +1,108 @@
+/*  Macros de pesos y comparaciones en tiempo de compilacion con vertices y aristas struct:
+    PESO_CAMPO en grafo_d_dijkstra() y la matriz de pesos, GRAFO_D_CMP_VT/GRAFO_D_CMP_AR en las
+    busquedas, y prioridad de las funciones registradas. No usa comun.h porque sus funciones
+    asumen vertices y aristas int.
+*/
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {int id; double x;} Punto;
+typedef struct {int id; int largo;} Tramo;
+
+#define STRUCT_VERTICE Punto
+#define STRUCT_ARISTA Tramo
+#define PESO_CAMPO largo
+#define GRAFO_D_CMP_VT(v1, v2) ((v1)->id==(v2)->id)
+#define GRAFO_D_CMP_AR(a1, a2) ((a1)->id==(a2)->id)
+#include "../grafo_d.h"
+
+#define N 40
+#define M 200
+
+static Vertice* vts[N];
+static peso_t dist[N][N];
+
+static unsigned azar(unsigned* estado) {
+    *estado=*estado*1103515245u+12345u;
+    return (*estado>>8)&0xFFFFFF;
+}
+
+static peso_t peso_uno(Arista* ar) {(void)ar; return 1;}
+static bool cmp_x(Vertice* v1, Vertice* v2) {return v1->x==v2->x;}
+
+int main(void) {
+    Grafo_D* grafo=grafo_d_crear();
+    for(int i=0; i<N; ++i) {
+        Punto p={i, 100.0-i};
+        vts[i]=grafo_d_insertar_vertice(grafo, p);
+        assert(vts[i]);
+    }
+    for(int i=0; i<N; ++i)
+        for(int j=0; j<N; ++j) dist[i][j]=(i==j) ? 0 : PESO_NO_ARISTA;
+    unsigned semilla=48;
+    for(int a=0; a<M; ++a) {
+        int u=azar(&semilla)%N, v=azar(&semilla)%N;
+        Tramo t={a, (int)(azar(&semilla)%20)+1};
+        assert(grafo_d_insertar_arista(grafo, t, vts[u], vts[v]));
+        if(t.largo<dist[u][v]) dist[u][v]=t.largo;
+    }
+    for(int k=0; k<N; ++k)
+        for(int i=0; i<N; ++i)
+            for(int j=0; j<N; ++j)
+                if(dist[i][k]!=PESO_NO_ARISTA && dist[k][j]!=PESO_NO_ARISTA
+                    && dist[i][k]+dist[k][j]<dist[i][j]) dist[i][j]=dist[i][k]+dist[k][j];
+
+    //Las busquedas comparan solo el campo id
+    for(int i=0; i<N; ++i) {
+        Punto ref={i, -1.0};
+        assert(grafo_d_buscar_vertice(grafo, ref)==vts[i]);
+    }
+    Tramo ref={17, -1};
+    const Vect_A* encontradas=grafo_d_buscar_aristas(grafo, ref);
+    assert(encontradas && encontradas->tamano==1 && encontradas->aristas[0]->id==17);
+    GRAFO_D_FREE((void*)encontradas);
+
+    //El peso es el campo largo
+    Matriz_Peso* pesos=grafo_d_crear_mat_peso(grafo);
+    assert(pesos);
+    size_t i=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig, ++i)
+        for(size_t j=0; j<N; ++j) {
+            //Con aristas paralelas la celda tiene el largo de alguna de ellas
+            peso_t celda=GD_MATRIZ_INDEX(pesos, i, j);
+            bool encontrada=false;
+            for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig)
+                if(_GD_FIN(grafo, aptr)->vt.id==(int)j) {
+                    assert(celda!=PESO_NO_ARISTA);
+                    encontrada=encontrada || celda==aptr->ar.largo;
+                }
+            assert(encontrada || celda==PESO_NO_ARISTA);
+        }
+    GRAFO_D_FREE(pesos);
+    for(int u=0; u<N; u+=3)
+        for(int v=0; v<N; ++v) {
+            Camino_D* camino=grafo_d_dijkstra(grafo, vts[u], vts[v]);
+            assert(camino);
+            if(dist[u][v]==PESO_NO_ARISTA) assert(!es_camino_valido(camino));
+            else assert(es_camino_valido(camino) && camino->longitud==dist[u][v]);
+            camino_d_destruir(camino);
+        }
+
+    //Las funciones registradas tienen prioridad sobre las macros
+    grafo_d_set_calc_peso(grafo, peso_uno);
+    for(int v=0; v<N; ++v) {
+        Camino_D* camino=grafo_d_dijkstra(grafo, vts[0], vts[v]);
+        assert(camino);
+        if(es_camino_valido(camino)) assert(camino->longitud==(peso_t)camino->saltos);
+        camino_d_destruir(camino);
+    }
+    grafo_d_set_cmp_vt(grafo, cmp_x);
+    Punto por_x={-1, 100.0-5};
+    assert(grafo_d_buscar_vertice(grafo, por_x)==vts[5]);
+    grafo_d_unset_cmp_vt(grafo);
+    assert(grafo_d_buscar_vertice(grafo, por_x)==NULL);
+    grafo_d_destruir(grafo);
+    return 0;
+}
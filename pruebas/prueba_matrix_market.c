@@ -0,0 +1,74 @@
+/*  Formato Matrix Market: escritura y lectura de matrices de pesos, de adyacencia y de bits, y
+    lectura de archivos simetricos y en formato de arreglo
+*/
+#include <string.h>
+#include "comun.h"
+
+static peso_t peso(Arista* ar) {return (peso_t)(*ar%7+1);}
+
+static void escribir(const char* ruta, const char* texto) {
+    FILE* archivo=fopen(ruta, "w");
+    assert(archivo);
+    fputs(texto, archivo);
+    fclose(archivo);
+}
+
+int main(int argc, char** argv) {
+    assert(argc>1);
+    char ruta[512], ruta_bits[512];
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "matriz.mtx");
+    prueba_ruta(ruta_bits, sizeof(ruta_bits), argv[1], "bits.mtx");
+
+    Grafo_D* grafo=grafo_d_crear();
+    prueba_operaciones(grafo, 5, 600);
+    grafo_d_set_calc_peso(grafo, peso);
+    size_t n=grafo->orden;
+
+    //Matriz de pesos en formato coordenado y de arreglo
+    Matriz_Peso* pesos=grafo_d_crear_mat_peso(grafo);
+    assert(pesos);
+    for(int coordenado=0; coordenado<2; ++coordenado) {
+        assert(matriz_peso_guardar_mm(pesos, ruta, coordenado));
+        Matriz_Peso* leida=matriz_peso_cargar_mm(ruta);
+        assert(leida && leida->orden==n);
+        assert(memcmp(leida->datos, pesos->datos, sizeof(peso_t)*n*n)==0);
+        GRAFO_D_FREE(leida);
+    }
+
+    //La matriz de adyacencia y la de bits producen el mismo archivo
+    Matriz_Ady* ady=grafo_d_crear_mat_ady(grafo);
+    Matriz_Bits* bits=grafo_d_crear_mat_bits(grafo);
+    assert(ady && bits);
+    assert(matriz_ady_guardar_mm(ady, ruta));
+    assert(matriz_bits_guardar_mm(bits, ruta_bits));
+    Matriz_Bits* leida=matriz_bits_cargar_mm(ruta);
+    assert(leida && leida->orden==n);
+    assert(memcmp(leida->datos, bits->datos, sizeof(uint64_t)*n*bits->palabras)==0);
+    GRAFO_D_FREE(leida);
+    leida=matriz_bits_cargar_mm(ruta_bits);
+    assert(leida && memcmp(leida->datos, bits->datos, sizeof(uint64_t)*n*bits->palabras)==0);
+    GRAFO_D_FREE(leida);
+
+    //Archivos simetricos y de arreglo escritos por otras herramientas
+    escribir(ruta, "%%MatrixMarket matrix coordinate real symmetric\n% comentario\n3 3 2\n1 2 2.5\n3 3 -1\n");
+    Matriz_Peso* otra=matriz_peso_cargar_mm(ruta);
+    assert(otra && otra->orden==3);
+    assert(GD_MATRIZ_INDEX(otra, 1, 0)==(peso_t)2.5 && GD_MATRIZ_INDEX(otra, 0, 1)==(peso_t)2.5);
+    assert(GD_MATRIZ_INDEX(otra, 2, 2)==-1 && GD_MATRIZ_INDEX(otra, 0, 0)==PESO_NO_ARISTA);
+    GRAFO_D_FREE(otra);
+    escribir(ruta, "%%MatrixMarket matrix array integer symmetric\n2 2\n1\n2\n3");
+    otra=matriz_peso_cargar_mm(ruta);
+    assert(otra && GD_MATRIZ_INDEX(otra, 0, 0)==1 && GD_MATRIZ_INDEX(otra, 1, 0)==2);
+    assert(GD_MATRIZ_INDEX(otra, 0, 1)==2 && GD_MATRIZ_INDEX(otra, 1, 1)==3);
+    GRAFO_D_FREE(otra);
+
+    //Indices fuera de rango y archivos inexistentes
+    escribir(ruta, "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n");
+    assert(matriz_peso_cargar_mm(ruta)==NULL && matriz_bits_cargar_mm(ruta)==NULL);
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "no_existe.mtx");
+    assert(matriz_peso_cargar_mm(ruta)==NULL);
+
+    GRAFO_D_FREE(pesos); GRAFO_D_FREE(ady); GRAFO_D_FREE(bits);
+    grafo_d_destruir(grafo);
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*  Matriz de bits: grafo_d_crear_mat_bits() comparada con la matriz de adyacencia, y vecinos
+    comunes, triangulos y cerradura transitiva comparados con su calculo directo
+*/
+#include "comun.h"
+
+#define N 300
+
+static bool ady[N][N];
+
+int main(void) {
+    Vertice* vts[N];
+    Grafo_D* grafo=prueba_grafo_azar(4, N, 0, vts);
+    unsigned semilla=5;
+    for(int i=0; i<2500; ++i) {
+        Vertice* ini=vts[prueba_azar(&semilla)%N];
+        assert(grafo_d_insertar_arpar(grafo, i, ini, vts[prueba_azar(&semilla)%N]));
+    }
+
+    Matriz_Ady* matriz=grafo_d_crear_mat_ady(grafo);
+    Matriz_Bits* bits=grafo_d_crear_mat_bits(grafo);
+    assert(matriz && bits && bits->orden==N && bits->palabras*64>=N);
+    for(size_t i=0; i<N; ++i) {
+        for(size_t j=0; j<N; ++j) {
+            ady[i][j]=GD_MATRIZ_INDEX(matriz, i, j)!=NULL;
+            assert(GD_MATRIZ_BIT(bits, i, j)==(unsigned)ady[i][j]);
+        }
+        //El relleno de cada renglon queda en ceros
+        for(size_t j=N; j<bits->palabras*64; ++j) assert(GD_MATRIZ_BIT(bits, i, j)==0);
+    }
+
+    for(size_t i=0; i<N; i+=7)
+        for(size_t j=0; j<N; j+=3) {
+            size_t comunes=0;
+            for(size_t k=0; k<N; ++k) comunes+=ady[i][k] && ady[j][k];
+            assert(matriz_bits_vecinos_comunes(bits, i, j)==comunes);
+        }
+
+    size_t triangulos=0;
+    for(size_t i=0; i<N; ++i)
+        for(size_t j=i+1; j<N; ++j)
+            for(size_t k=j+1; k<N; ++k)
+                triangulos+=ady[i][j] && ady[i][k] && ady[j][k];
+    assert(triangulos>0 && matriz_bits_contar_triangulos(bits)==triangulos);
+
+    //Cerradura transitiva de un grafo dirigido disperso contra Warshall sobre booleanos
+    grafo_d_destruir(grafo);
+    GRAFO_D_FREE(matriz);
+    GRAFO_D_FREE(bits);
+    grafo=prueba_grafo_azar(6, N, N, vts);
+    matriz=grafo_d_crear_mat_ady(grafo);
+    bits=grafo_d_crear_mat_bits(grafo);
+    assert(matriz && bits);
+    for(size_t i=0; i<N; ++i)
+        for(size_t j=0; j<N; ++j) ady[i][j]=GD_MATRIZ_INDEX(matriz, i, j)!=NULL;
+    for(size_t k=0; k<N; ++k)
+        for(size_t i=0; i<N; ++i)
+            if(ady[i][k])
+                for(size_t j=0; j<N; ++j) ady[i][j]=ady[i][j] || ady[k][j];
+    matriz_bits_cerradura_transitiva(bits);
+    for(size_t i=0; i<N; ++i)
+        for(size_t j=0; j<N; ++j) assert(GD_MATRIZ_BIT(bits, i, j)==(unsigned)ady[i][j]);
+
+    GRAFO_D_FREE(matriz);
+    GRAFO_D_FREE(bits);
+    grafo_d_destruir(grafo);
+    return 0;
+}
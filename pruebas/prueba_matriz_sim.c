@@ -0,0 +1,60 @@
+/*  Matriz de pesos simetrica empaquetada: grafo_d_es_simetrico() y grafo_d_crear_mat_peso_sim()
+    comparadas con la matriz de pesos completa
+*/
+#include "comun.h"
+
+static peso_t peso(Arista* ar) {return (peso_t)(*ar%5+1);}
+
+/*  Verifica que cada celda de la matriz simetrica coincida con la de la matriz completa*/
+static void comparar(const Grafo_D* grafo) {
+    Matriz_Peso* completa=grafo_d_crear_mat_peso(grafo);
+    Matriz_Peso_Sim* sim=grafo_d_crear_mat_peso_sim(grafo);
+    assert(completa && sim && sim->orden==grafo->orden);
+    for(size_t i=0; i<grafo->orden; ++i)
+        for(size_t j=0; j<grafo->orden; ++j) {
+            assert(GD_MATRIZ_SIM_INDEX(sim, i, j)==GD_MATRIZ_INDEX(completa, i, j));
+            assert(GD_MATRIZ_SIM_INDEX(sim, i, j)==GD_MATRIZ_SIM_INDEX(sim, j, i));
+        }
+    GRAFO_D_FREE(completa);
+    GRAFO_D_FREE(sim);
+}
+
+int main(void) {
+    Vertice* vts[200];
+    Grafo_D* grafo=prueba_grafo_azar(1, 200, 0, vts);
+    grafo_d_set_calc_peso(grafo, peso);
+    assert(grafo_d_es_simetrico(grafo));
+
+    //Un grafo construido con aristas en ambos sentidos es simetrico
+    unsigned semilla=2;
+    for(int i=0; i<1500; ++i) {
+        Vertice* ini=vts[prueba_azar(&semilla)%200];
+        assert(grafo_d_insertar_arpar(grafo, i, ini, vts[prueba_azar(&semilla)%200]));
+    }
+    assert(grafo_d_es_simetrico(grafo));
+    comparar(grafo);
+
+    //Con aristas paralelas ambas matrices toman el peso de la misma arista
+    const Vect_A* par=grafo_d_insertar_arista_par(grafo, 3, vts[0], vts[1]);
+    assert(par);
+    GRAFO_D_FREE((void*)par);
+    assert(grafo_d_es_simetrico(grafo));
+    comparar(grafo);
+
+    //Una arista sin conjugada o con un peso distinto rompe la simetria
+    Vertice* a=grafo_d_insertar_vertice(grafo, 200);
+    Vertice* b=grafo_d_insertar_vertice(grafo, 201);
+    assert(grafo_d_insertar_arista(grafo, 0, a, b));
+    assert(!grafo_d_es_simetrico(grafo));
+    assert(grafo_d_insertar_arista(grafo, 1, b, a));
+    assert(!grafo_d_es_simetrico(grafo));
+    grafo_d_destruir(grafo);
+
+    //Grafo vacio
+    grafo=grafo_d_crear();
+    Matriz_Peso_Sim* sim=grafo_d_crear_mat_peso_sim(grafo);
+    assert(sim && sim->orden==0 && grafo_d_es_simetrico(grafo));
+    GRAFO_D_FREE(sim);
+    grafo_d_destruir(grafo);
+    return 0;
+}
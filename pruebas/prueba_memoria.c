@@ -0,0 +1,150 @@
+/*  Medicion de memoria: el desglose de grafo_d_memoria() comparado con los nodos, lotes y
+    regiones que se encuentran al recorrer el grafo, antes y despues de compactar, y la memoria
+    de versiones, grafos comprimidos, matrices y caminos
+*/
+#include "comun.h"
+
+static size_t hash_vt(Vertice* vt) {return (size_t)*vt;}
+static size_t hash_ar(Arista* ar) {return (size_t)*ar;}
+
+static void verificar_total(const Grafo_D_Memoria* mem) {
+    assert(mem->total==mem->vertices+mem->aristas+mem->datos+mem->indices+mem->holgura);
+}
+
+/*  Verifica el desglose de un grafo sin indices de vertices o aristas ni diario recorriendo todas
+    sus aristas, y regresa los bytes de nodos libres
+*/
+static size_t verificar(const Grafo_D* grafo) {
+    size_t bytes=0, reservas=1, libres=0, indices=sizeof(Grafo_D);
+    for(const Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) {
+        if(vptr<grafo->region_v || vptr>=grafo->region_v+grafo->region_orden) {
+            bytes+=sizeof(Nodo_V);
+            ++reservas;
+        }
+        for(const _Lote_A* lote=vptr->lotes; lote; lote=lote->sig)
+            if(!lote->en_region) {
+                bytes+=sizeof(_Lote_A)+sizeof(Nodo_A)*lote->capacidad;
+                ++reservas;
+            }
+        for(const Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig)
+            if(!_grafo_d_arista_propia(vptr, aptr)) {
+                bytes+=sizeof(Nodo_A);
+                ++reservas;
+            }
+        for(const Nodo_A* aptr=vptr->libres; aptr; aptr=aptr->sig) libres+=sizeof(Nodo_A);
+        //Indice de vecinos de los vertices de grado alto
+        if(vptr->indice_ady) {
+            const _Tabla_H* t=vptr->indice_ady;
+            indices+=sizeof(_Tabla_H)+2*sizeof(_Nodo_H*)*t->capacidad+sizeof(_Nodo_H)*t->elementos;
+            reservas+=3+t->elementos;
+        }
+    }
+    if(grafo->region_v) {
+        bytes+=sizeof(Nodo_V)*grafo->region_orden+grafo->region_bytes_a;
+        reservas+=2;
+    }
+#ifdef GRAFO_D_IDS_32
+    if(grafo->capacidad_ids) {
+        indices+=(sizeof(Nodo_V*)+sizeof(uint32_t))*grafo->capacidad_ids;
+        reservas+=2;
+    }
+#endif
+    Grafo_D_Memoria mem=grafo_d_memoria(grafo);
+    verificar_total(&mem);
+    assert(mem.vertices+mem.aristas+mem.datos+mem.holgura==bytes);
+    assert(mem.datos==sizeof(Vertice)*grafo->orden+sizeof(Arista)*grafo->tamano);
+    assert(mem.indices==indices && mem.reservas==reservas && mem.compartido==0);
+    assert(mem.holgura>=libres);
+    return libres;
+}
+
+int main(void) {
+    //Grafo vacio y grafo con vertices sin aristas
+    Grafo_D* grafo=grafo_d_crear();
+    Grafo_D_Memoria mem=grafo_d_memoria(grafo);
+    assert(mem.total==sizeof(Grafo_D) && mem.indices==sizeof(Grafo_D) && mem.reservas==1);
+    Vertice* vts[100];
+    for(int i=0; i<100; ++i) vts[i]=grafo_d_insertar_vertice(grafo, i);
+    mem=grafo_d_memoria(grafo);
+    assert(mem.vertices==100*(sizeof(Nodo_V)-sizeof(Vertice)-sizeof(Nodo_A)*GRAFO_D_ADY_LOCAL));
+    assert(mem.holgura==100*sizeof(Nodo_A)*GRAFO_D_ADY_LOCAL && mem.aristas==0);
+    verificar(grafo);
+
+    //Aristas en nodos locales, en lotes, en pares y atomicas
+    prueba_operaciones(grafo, 46, 6000);
+    for(int i=0; i<300; ++i) assert(grafo_d_insertar_arista_atomica(grafo, i, vts[i%7], vts[i%13]));
+    assert(grafo_d_fin_carga_atomica(grafo));
+    verificar(grafo);
+
+    //Los indices hash se cuentan aparte
+    size_t sin_indices=grafo_d_memoria(grafo).total;
+    assert(grafo_d_set_hash_vt(grafo, hash_vt) && grafo_d_set_hash_ar(grafo, hash_ar));
+    mem=grafo_d_memoria(grafo);
+    verificar_total(&mem);
+    assert(mem.total>sin_indices+sizeof(_Nodo_H)*(grafo->orden+grafo->tamano));
+
+    //Despues de compactar la holgura son los nodos locales libres, luego aumenta con los huecos
+    Grafo_D_Traduccion* tr=grafo_d_compactar(grafo, NULL);
+    assert(tr);
+    grafo_d_traduccion_destruir(tr);
+    grafo_d_unset_hash_vt(grafo);
+    grafo_d_unset_hash_ar(grafo);
+    size_t libres=verificar(grafo);
+    mem=grafo_d_memoria(grafo);
+    assert(mem.holgura==libres);
+    size_t eliminados=0;
+    for(int i=0; i<30; ++i) {
+        Vertice* vt=grafo_d_buscar_vertice(grafo, i);
+        if(vt) {
+            grafo_d_eliminar_vertice(grafo, vt);
+            ++eliminados;
+        }
+    }
+    assert(eliminados>0);
+    libres=verificar(grafo);
+    assert(grafo_d_memoria(grafo).holgura>=libres+sizeof(Nodo_V)*eliminados);
+    grafo_d_destruir(grafo);
+
+    //Versiones: los bloques que no cambiaron se comparten
+    Vertice* vs[50];
+    grafo=prueba_grafo_azar(46, 50, 400, vs);
+    const Grafo_D_Version* v1=grafo_d_snapshot(grafo);
+    assert(grafo_d_insertar_arista(grafo, -1, vs[3], vs[4]));
+    const Grafo_D_Version* v2=grafo_d_snapshot(grafo);
+    assert(v1 && v2 && v1!=v2);
+    Grafo_D_Memoria m1=grafo_d_version_memoria(v1), m2=grafo_d_version_memoria(v2);
+    verificar_total(&m1);
+    verificar_total(&m2);
+    size_t bloques=sizeof(_Bloque_V)*grafo->orden+sizeof(_Arista_Ver)*grafo->tamano;
+    assert(m2.vertices+m2.aristas+m2.datos==bloques);
+    size_t propio=sizeof(_Bloque_V)+sizeof(_Arista_Ver)*_GD_NODO_V(vs[3])->grado_s;
+    assert(m2.compartido==bloques-propio);
+    assert(m1.compartido==m2.compartido && m1.total+sizeof(_Arista_Ver)==m2.total);
+    grafo_d_version_liberar(v1);
+    grafo_d_version_liberar(v2);
+
+    //Grafo comprimido
+    Grafo_D_Comprimido* comp=grafo_d_comprimir(grafo, false);
+    assert(comp);
+    mem=grafo_d_comprimido_memoria(comp);
+    verificar_total(&mem);
+    assert(mem.aristas==comp->bytes && mem.datos==sizeof(Vertice)*50+sizeof(Arista)*grafo->tamano);
+    grafo_d_comprimido_destruir(comp);
+
+    //Matrices y caminos
+    Matriz_Ady* ady=grafo_d_crear_mat_ady(grafo);
+    Matriz_Peso* peso=grafo_d_crear_mat_peso(grafo);
+    Matriz_Peso_Sim* sim=grafo_d_crear_mat_peso_sim(grafo);
+    Matriz_Bits* bits=grafo_d_crear_mat_bits(grafo);
+    assert(ady && peso && sim && bits);
+    assert(matriz_ady_memoria(ady)==sizeof(Matriz_Ady)+sizeof(Arista*)*50*50);
+    assert(matriz_peso_memoria(peso)==sizeof(Matriz_Peso)+sizeof(peso_t)*50*50);
+    assert(matriz_peso_sim_memoria(sim)==sizeof(Matriz_Peso_Sim)+sizeof(peso_t)*50*51/2);
+    assert(bits->palabras*64>=50 && matriz_bits_memoria(bits)==sizeof(Matriz_Bits)+sizeof(uint64_t)*bits->palabras*50);
+    GRAFO_D_FREE(ady); GRAFO_D_FREE(peso); GRAFO_D_FREE(sim); GRAFO_D_FREE(bits);
+    Camino_D* camino=grafo_d_dijkstra(grafo, vs[0], vs[0]);
+    assert(camino && camino_d_memoria(camino)==sizeof(Camino_D)+sizeof(Vertice*));
+    camino_d_destruir(camino);
+    grafo_d_destruir(grafo);
+    return 0;
+}
@@ -0,0 +1,58 @@
+/*  Busquedas en paralelo: grafo_d_buscar_vertices_par() y grafo_d_buscar_aristas_par() con
+    distintos numeros de hilos comparadas con las busquedas secuenciales
+*/
+#ifndef GRAFO_D_HILOS
+#define GRAFO_D_HILOS
+#endif
+#include "comun.h"
+
+static size_t hash_vt(Vertice* vt) {return (size_t)*vt;}
+static size_t hash_ar(Arista* ar) {return (size_t)*ar;}
+
+static void igual_v(const Vect_V* a, const Vect_V* b) {
+    assert(a && b && a->tamano==b->tamano);
+    for(size_t i=0; i<a->tamano; ++i) assert(a->vertices[i]==b->vertices[i]);
+    GRAFO_D_FREE((void*)a);
+    GRAFO_D_FREE((void*)b);
+}
+
+static void igual_a(const Vect_A* a, const Vect_A* b) {
+    assert(a && b && a->tamano==b->tamano);
+    for(size_t i=0; i<a->tamano; ++i) assert(a->aristas[i]==b->aristas[i]);
+    GRAFO_D_FREE((void*)a);
+    GRAFO_D_FREE((void*)b);
+}
+
+static void verificar(const Grafo_D* grafo) {
+    const unsigned hilos[]={0, 1, 2, 3, 8, 64};
+    for(size_t h=0; h<sizeof(hilos)/sizeof(hilos[0]); ++h) {
+        for(int ref=0; ref<12; ++ref) {
+            igual_v(grafo_d_buscar_vertices_par(grafo, ref, hilos[h]), grafo_d_buscar_vertices(grafo, ref));
+            igual_a(grafo_d_buscar_aristas_par(grafo, ref, hilos[h]), grafo_d_buscar_aristas(grafo, ref));
+        }
+    }
+}
+
+int main(void) {
+    //Grafo pequeno con menos vertices que hilos
+    Vertice* vts[3000];
+    Grafo_D* grafo=prueba_grafo_azar(50, 3, 10, vts);
+    verificar(grafo);
+    grafo_d_destruir(grafo);
+
+    //Grados muy desiguales para probar el reparto por aristas
+    grafo=grafo_d_crear();
+    for(int i=0; i<3000; ++i) vts[i]=grafo_d_insertar_vertice(grafo, i%12);
+    unsigned semilla=51;
+    for(int i=0; i<20000; ++i) {
+        Vertice* ini=vts[i%4 ? prueba_azar(&semilla)%5 : prueba_azar(&semilla)%3000];
+        assert(grafo_d_insertar_arista(grafo, prueba_azar(&semilla)%12, ini, vts[prueba_azar(&semilla)%3000]));
+    }
+    verificar(grafo);
+
+    //Con indices se usa la busqueda indexada y el resultado no cambia
+    assert(grafo_d_set_hash_vt(grafo, hash_vt) && grafo_d_set_hash_ar(grafo, hash_ar));
+    verificar(grafo);
+    grafo_d_destruir(grafo);
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*  GRAFO_D_PREFIJO: tres instancias de la libreria en el mismo archivo, cada una con sus propios
+    tipos y modos. Se define _POSIX_C_SOURCE para la instancia concurrente con -std=c99.
+*/
+#define _POSIX_C_SOURCE 200809L
+#undef NDEBUG
+#include <assert.h>
+#include <math.h>
+
+typedef struct {int id; char nombre[8];} Ciudad;
+typedef struct {int id; double longitud;} Via;
+
+#define GRAFO_D_PREFIJO vial
+#define STRUCT_VERTICE Ciudad
+#define STRUCT_ARISTA Via
+#define DATO_PESO double
+#define PESO_NO_ARISTA HUGE_VAL
+#define PESO_CAMPO longitud
+#define GRAFO_D_CMP_VT(v1, v2) ((v1)->id==(v2)->id)
+#define GRAFO_D_CMP_AR(a1, a2) ((a1)->id==(a2)->id)
+#include "../grafo_d.h"
+
+#define GRAFO_D_PREFIJO ent
+#define GRAFO_D_IDS_32
+#define GRAFO_D_ADY_LOCAL 2
+#include "../grafo_d.h"
+
+#define GRAFO_D_PREFIJO conc
+#define GRAFO_D_CONCURRENTE
+#define DATO_VERTICE long
+#include "../grafo_d.h"
+
+#if defined(Vertice) || defined(Arista) || defined(GRAFO_D_IDS_32) || defined(GRAFO_D_CONCURRENTE)
+#error "Las macros de tipos y modos deben eliminarse al terminar cada inclusion"
+#endif
+
+int main(void) {
+    //Vertices y aristas struct con pesos double
+    vial_Grafo_D* vial=vial_grafo_d_crear();
+    Ciudad* ciudades[10];
+    for(int i=0; i<10; ++i) {
+        Ciudad c={i, "c"};
+        ciudades[i]=vial_grafo_d_insertar_vertice(vial, c);
+    }
+    for(int i=0; i<9; ++i) {
+        Via v={i, i+0.5};
+        assert(vial_grafo_d_insertar_arista(vial, v, ciudades[i], ciudades[i+1]));
+    }
+    vial_Camino_D* camino=vial_grafo_d_dijkstra(vial, ciudades[0], ciudades[9]);
+    assert(camino && vial_es_camino_valido(camino) && camino->longitud==0.5*9+36);
+    vial_camino_d_destruir(camino);
+    vial_Matriz_Peso* pesos=vial_grafo_d_crear_mat_peso(vial);
+    assert(pesos && GD_MATRIZ_INDEX(pesos, 0, 5)==vial_grafo_d_peso_no_arista());
+    free(pesos);
+    Ciudad ref={4, ""};
+    assert(vial_grafo_d_buscar_vertice(vial, ref)==ciudades[4]);
+    vial_grafo_d_destruir(vial);
+
+    //Identificadores numericos y aristas locales
+    ent_Grafo_D* ent=ent_grafo_d_crear();
+    int* vts[100];
+    for(int i=0; i<100; ++i) vts[i]=ent_grafo_d_insertar_vertice(ent, i);
+    for(int i=0; i<99; ++i) assert(ent_grafo_d_insertar_arista(ent, i, vts[i], vts[i+1]));
+    assert(ent_grafo_d_id(vts[7])==7 && ent_grafo_d_vertice_por_id(ent, 7)==vts[7]);
+    ent_Camino_D* camino_ent=ent_grafo_d_dijkstra(ent, vts[0], vts[99]);
+    assert(camino_ent && camino_ent->longitud==99);
+    ent_camino_d_destruir(camino_ent);
+    assert(ent_grafo_d_peso_no_arista()==INT_MAX);
+    ent_grafo_d_destruir(ent);
+
+    //Grafo concurrente con vertices long
+    conc_Grafo_D* conc=conc_grafo_d_crear();
+    long* largos[3];
+    for(long i=0; i<3; ++i) largos[i]=conc_grafo_d_insertar_vertice(conc, i*1000000000L);
+    assert(conc_grafo_d_insertar_arista(conc, 1, largos[0], largos[2]));
+    assert(conc_grafo_d_buscar_vertice(conc, 2000000000L)==largos[2] && !conc_grafo_d_isempty(conc));
+    conc_grafo_d_destruir(conc);
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*  Reordenamiento: permutaciones de grafo_d_calcular_orden() con cada metodo, propiedades del
+    orden BFS, RCM y por grado, reduccion del ancho de banda de un grafo de banda con los vertices
+    revueltos y aristas conservadas despues de grafo_d_reordenar()
+*/
+#include "comun.h"
+
+#define N 600
+#define BANDA 3
+
+static Vertice* vts[N+1];
+static int perm[N];
+static size_t grado[N+1], pos[N+1];
+static const Nodo_V* nodos[N+1];
+
+/*  Guarda los nodos del grafo en el orden de la lista y el grado sin direccion de cada uno*/
+static size_t guardar(const Grafo_D* grafo) {
+    size_t n=0;
+    for(const Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig) {
+        nodos[n]=vptr;
+        grado[n++]=vptr->grado_s;
+    }
+    for(size_t i=0; i<n; ++i)
+        for(const Nodo_A* aptr=nodos[i]->lista_ady; aptr; aptr=aptr->sig)
+            for(size_t j=0; j<n; ++j)
+                if(_GD_FIN(grafo, aptr)==nodos[j]) {++grado[j]; break;}
+    return n;
+}
+
+/*  Verifica que el orden sea una permutacion y guarda en pos la posicion nueva de cada vertice*/
+static void verificar_permutacion(const size_t* orden, size_t n) {
+    for(size_t i=0; i<n; ++i) pos[i]=GD_NO_POSICION;
+    for(size_t i=0; i<n; ++i) {
+        assert(orden[i]<n && pos[orden[i]]==GD_NO_POSICION);
+        pos[orden[i]]=i;
+    }
+}
+
+/*  Regresa verdadero si u y v son adyacentes sin considerar la direccion*/
+static bool adyacentes(const Grafo_D* grafo, const Nodo_V* u, const Nodo_V* v) {
+    (void)grafo;
+    for(const Nodo_A* aptr=u->lista_ady; aptr; aptr=aptr->sig)
+        if(_GD_FIN(grafo, aptr)==v) return true;
+    for(const Nodo_A* aptr=v->lista_ady; aptr; aptr=aptr->sig)
+        if(_GD_FIN(grafo, aptr)==u) return true;
+    return false;
+}
+
+int main(void) {
+    //Grafo de banda con los vertices insertados en orden revuelto y un vertice aislado
+    unsigned semilla=45;
+    for(int i=0; i<N; ++i) perm[i]=i;
+    for(int i=N-1; i>0; --i) {
+        int j=prueba_azar(&semilla)%(i+1), tmp=perm[i];
+        perm[i]=perm[j];
+        perm[j]=tmp;
+    }
+    Grafo_D* grafo=grafo_d_crear();
+    Grafo_D* ref=grafo_d_crear();
+    for(int i=0; i<N; ++i) vts[perm[i]]=grafo_d_insertar_vertice(grafo, perm[i]);
+    vts[N]=grafo_d_insertar_vertice(grafo, N);
+    for(int i=0; i<=N; ++i) grafo_d_insertar_vertice(ref, i);
+    int a=0;
+    for(int i=0; i<N; ++i)
+        for(int k=1; k<=BANDA && i+k<N; ++k, ++a) {
+            int u=(a%2) ? i : i+k, v=(a%2) ? i+k : i;
+            assert(grafo_d_insertar_arista(grafo, a, vts[u], vts[v]));
+            assert(grafo_d_insertar_arista(ref, a, grafo_d_buscar_vertice(ref, u), grafo_d_buscar_vertice(ref, v)));
+        }
+    size_t n=guardar(grafo);
+    assert(n==N+1);
+
+    //Cada metodo da una permutacion
+    for(int metodo=GD_ORDEN_BFS; metodo<=GD_ORDEN_GORDER; ++metodo) {
+        size_t* orden=grafo_d_calcular_orden(grafo, metodo);
+        assert(orden);
+        verificar_permutacion(orden, n);
+        //BFS y RCM (al reves): en la unica componente con aristas, cada vertice salvo el primero
+        //tiene un vecino antes
+        if(metodo==GD_ORDEN_BFS || metodo==GD_ORDEN_RCM) {
+            size_t raices=0;
+            for(size_t i=0; i<n; ++i) {
+                size_t k=(metodo==GD_ORDEN_BFS) ? i : n-1-i;
+                if(grado[orden[k]]==0) continue;
+                bool vecino=false;
+                for(size_t j=0; j<i && !vecino; ++j)
+                    vecino=adyacentes(grafo, nodos[orden[k]], nodos[orden[(metodo==GD_ORDEN_BFS) ? j : n-1-j]]);
+                raices+=!vecino;
+            }
+            assert(raices==1);
+        }
+        if(metodo==GD_ORDEN_BFS) assert(orden[0]==0);
+        if(metodo==GD_ORDEN_GRADO)
+            for(size_t i=1; i<n; ++i) assert(grado[orden[i-1]]>=grado[orden[i]]);
+        GRAFO_D_FREE(orden);
+    }
+    assert(grafo_d_calcular_orden(grafo, GD_ORDEN_GORDER+1)==NULL);
+    assert(grafo_d_reordenar(grafo, -1, NULL, NULL)==NULL && grafo->lista_ady==nodos[0]);
+
+    //RCM recupera un ancho de banda cercano al de la banda original
+    size_t ancho=grafo_d_ancho_banda(grafo), antes=0, despues=0;
+    assert(ancho>20*BANDA);
+    Grafo_D_Traduccion* tr=grafo_d_reordenar(grafo, GD_ORDEN_RCM, &antes, &despues);
+    assert(tr && antes==ancho && despues<=2*BANDA && grafo_d_ancho_banda(grafo)==despues);
+    for(int i=0; i<=N; ++i) {
+        Vertice* nuevo=grafo_d_traducir_vertice(tr, vts[i]);
+        assert(nuevo && *nuevo==i);
+        vts[i]=nuevo;
+    }
+    grafo_d_traduccion_destruir(tr);
+
+    //Las aristas de cada vertice no cambian con ningun metodo
+    for(int metodo=GD_ORDEN_BFS; metodo<=GD_ORDEN_GORDER; ++metodo) {
+        tr=grafo_d_reordenar(grafo, metodo, NULL, NULL);
+        assert(tr && grafo->orden==N+1 && grafo->tamano==ref->tamano);
+        grafo_d_traduccion_destruir(tr);
+        for(const Nodo_V* r=ref->lista_ady; r; r=r->sig) {
+            Vertice* vt=grafo_d_buscar_vertice(grafo, r->vt);
+            assert(vt);
+            const Nodo_V* v=_GD_NODO_V(vt);
+            assert(v->grado_s==r->grado_s);
+            const Nodo_A* p=v->lista_ady, *q=r->lista_ady;
+            for(; p && q; p=p->sig, q=q->sig)
+                assert(p->ar==q->ar && _GD_FIN(grafo, p)->vt==_GD_FIN(ref, q)->vt);
+            assert(p==NULL && q==NULL);
+        }
+    }
+    grafo_d_destruir(ref);
+    grafo_d_destruir(grafo);
+
+    //Grafo vacio
+    grafo=grafo_d_crear();
+    assert(grafo_d_ancho_banda(grafo)==0);
+    tr=grafo_d_reordenar(grafo, GD_ORDEN_GORDER, &antes, &despues);
+    assert(tr && antes==0 && despues==0);
+    grafo_d_traduccion_destruir(tr);
+    grafo_d_destruir(grafo);
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*  Carga de archivos de texto: grafo_d_cargar_texto() con archivos DIMACS y listas de aristas,
+    con uno y varios hilos, comparando las aristas cargadas con las escritas, y los casos de error
+*/
+#include <string.h>
+#include "comun.h"
+
+#define N 2000
+#define M 60000
+
+typedef struct {int ini, fin, ar;} Terna;
+
+static Terna escritas[M], cargadas[M];
+
+static int cmp_terna(const void* a, const void* b) {
+    const Terna* x=(const Terna*)a;
+    const Terna* y=(const Terna*)b;
+    if(x->ini!=y->ini) return x->ini<y->ini ? -1 : 1;
+    if(x->fin!=y->fin) return x->fin<y->fin ? -1 : 1;
+    return (x->ar>y->ar)-(x->ar<y->ar);
+}
+
+static void escribir(const char* ruta, const char* texto) {
+    FILE* archivo=fopen(ruta, "w");
+    assert(archivo && fputs(texto, archivo)>=0);
+    fclose(archivo);
+}
+
+/*  Verifica que el grafo tenga exactamente las aristas escritas, en cualquier orden*/
+static void comparar(const Grafo_D* grafo, size_t m) {
+    assert(grafo->tamano==m);
+    size_t n=0;
+    for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig)
+        for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig) {
+            assert(n<m);
+            cargadas[n].ini=vptr->vt;
+            cargadas[n].fin=_GD_FIN(grafo, aptr)->vt;
+            cargadas[n].ar=aptr->ar;
+            ++n;
+        }
+    assert(n==m);
+    qsort(escritas, m, sizeof(Terna), cmp_terna);
+    qsort(cargadas, m, sizeof(Terna), cmp_terna);
+    assert(memcmp(escritas, cargadas, sizeof(Terna)*m)==0);
+}
+
+static bool leer_vt(size_t id, Vertice* vt) {
+    *vt=(Vertice)id*10;
+    return true;
+}
+
+/*  Falla con el ultimo vertice de la lista "0,1\n1,2\n2,3\n"*/
+static bool leer_vt_hasta_2(size_t id, Vertice* vt) {
+    *vt=(Vertice)id;
+    return id<=2;
+}
+
+/*  Lee el peso del segundo campo, despues de un nombre*/
+static bool leer_ar(const char** campos, const size_t* largos, size_t n, Arista* ar) {
+    if(n<2 || largos[0]==0) return false;
+    int val=0;
+    for(size_t i=0; i<largos[1]; ++i) {
+        if(campos[1][i]<'0' || campos[1][i]>'9') return false;
+        val=val*10+(campos[1][i]-'0');
+    }
+    *ar=val;
+    return true;
+}
+
+static size_t hash_ar(Arista* ar) {return (size_t)*ar;}
+
+/*  Verifica que la carga falle sin modificar un grafo con un vertice*/
+static void falla(const char* ruta, int formato, bool (*leer_v)(size_t, Vertice*),
+    bool (*leer)(const char**, const size_t*, size_t, Arista*)) {
+    const unsigned hilos[]={1, 4};
+    for(size_t h=0; h<2; ++h) {
+        Grafo_D* grafo=grafo_d_crear();
+        grafo_d_insertar_vertice(grafo, -1);
+        assert(!grafo_d_cargar_texto(grafo, ruta, formato, leer_v, leer, hilos[h]));
+        assert(grafo->orden==1 && grafo->tamano==0);
+        grafo_d_destruir(grafo);
+    }
+}
+
+int main(int argc, char** argv) {
+    assert(argc>1);
+    char ruta[512];
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "grafo.gr");
+    unsigned semilla=37;
+
+    //DIMACS suficientemente grande para dividirse en varios fragmentos
+    FILE* archivo=fopen(ruta, "w");
+    assert(archivo);
+    fprintf(archivo, "c prueba\nc %d vertices\np sp %d %d\n", N, N, M);
+    for(int i=0; i<M; ++i) {
+        escritas[i].ini=(int)(prueba_azar(&semilla)%N)+1;
+        escritas[i].fin=(int)(prueba_azar(&semilla)%N)+1;
+        escritas[i].ar=(int)(prueba_azar(&semilla)%1000);
+        fprintf(archivo, "a %d %d %d\n", escritas[i].ini, escritas[i].fin, escritas[i].ar);
+    }
+    fclose(archivo);
+    const unsigned hilos[]={1, 4, 0};
+    Grafo_D* un_hilo=NULL;
+    for(size_t h=0; h<3; ++h) {
+        Grafo_D* grafo=grafo_d_crear();
+        assert(grafo_d_set_hash_ar(grafo, hash_ar));
+        assert(grafo_d_cargar_texto(grafo, ruta, GD_TEXTO_DIMACS, NULL, NULL, hilos[h]));
+        //Los vertices se crean en orden de identificador
+        assert(grafo->orden==N);
+        int id=1;
+        for(Nodo_V* vptr=grafo->lista_ady; vptr; vptr=vptr->sig, ++id) assert(vptr->vt==id);
+        //El indice de aristas se reconstruye al terminar
+        const Vect_A* r=grafo_d_buscar_aristas(grafo, escritas[0].ar);
+        size_t esperadas=0;
+        for(int i=0; i<M; ++i) esperadas+=(escritas[i].ar==escritas[0].ar);
+        assert(r && r->tamano==esperadas);
+        GRAFO_D_FREE((void*)r);
+        comparar(grafo, M);
+        //Las listas quedan en el mismo orden con cualquier numero de hilos
+        if(un_hilo) {
+            prueba_iguales(grafo, un_hilo);
+            grafo_d_destruir(grafo);
+        }
+        else un_hilo=grafo;
+    }
+    grafo_d_destruir(un_hilo);
+
+    //Lista con encabezado, comentarios, separadores mezclados y un identificador sin usar
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "aristas.csv");
+    escribir(ruta, "origen,destino,nombre,peso\n# comentario\n0,1,a,5\n1\t3\tb\t7\r\n% otro\n\n3;0;c;9\n3 3 d 2");
+    const Terna csv[]={{0, 10, 5}, {10, 30, 7}, {30, 0, 9}, {30, 30, 2}};
+    for(size_t h=0; h<3; ++h) {
+        Grafo_D* grafo=grafo_d_crear();
+        assert(grafo_d_cargar_texto(grafo, ruta, GD_TEXTO_LISTA, leer_vt, leer_ar, hilos[h]));
+        assert(grafo->orden==3 && grafo->lista_ady->vt==0 && grafo->lista_ady->sig->sig->vt==30);
+        memcpy(escritas, csv, sizeof(csv));
+        comparar(grafo, 4);
+        grafo_d_destruir(grafo);
+    }
+    //Sin funciones se usan el identificador y el primer campo
+    escribir(ruta, "0,1,5\n1,0\n");
+    Grafo_D* grafo=grafo_d_crear();
+    assert(grafo_d_cargar_texto(grafo, ruta, GD_TEXTO_LISTA, NULL, NULL, 1));
+    const Terna simple[]={{0, 1, 5}, {1, 0, 0}};
+    memcpy(escritas, simple, sizeof(simple));
+    comparar(grafo, 2);
+    grafo_d_destruir(grafo);
+
+    //Errores: el grafo no se modifica
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "error.gr");
+    escribir(ruta, "p sp 3 2\na 1 2 3\na 1 x 3\n");
+    falla(ruta, GD_TEXTO_DIMACS, NULL, NULL);
+    escribir(ruta, "p sp 3 2\na 1 2 3\na 4 1 3\n");
+    falla(ruta, GD_TEXTO_DIMACS, NULL, NULL);
+    escribir(ruta, "p sp 3 2\na 0 2 3\n");
+    falla(ruta, GD_TEXTO_DIMACS, NULL, NULL);
+    escribir(ruta, "a 1 2 3\n");
+    falla(ruta, GD_TEXTO_DIMACS, NULL, NULL);
+    escribir(ruta, "p sp 3 1\na 1 2 peso\n");
+    falla(ruta, GD_TEXTO_DIMACS, NULL, NULL);
+    escribir(ruta, "0,1,a,5\n1,2,b,x\n");
+    falla(ruta, GD_TEXTO_LISTA, NULL, leer_ar);
+    escribir(ruta, "0,1\n1,2\n2,3\n");
+    falla(ruta, GD_TEXTO_LISTA, leer_vt_hasta_2, NULL);
+    prueba_ruta(ruta, sizeof(ruta), argv[1], "no_existe.gr");
+    falla(ruta, GD_TEXTO_DIMACS, NULL, NULL);
+    return 0;
+}
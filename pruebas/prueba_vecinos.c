@@ -0,0 +1,71 @@
+/*  Tabla de vecinos de los vertices de grado alto: grafo_d_buscar_arista(s)_entre_vert y
+    grafo_d_buscar_arista(s)_estricto comparadas con un recorrido de la lista de adyacencia, al
+    crear y al descartar la tabla
+*/
+#include "comun.h"
+
+#define N 100
+#define CONCENTRADORES 4
+
+/*  Verifica las cuatro busquedas entre ini y fin contra la lista de adyacencia de ini*/
+static void verificar(const Grafo_D* grafo, Vertice* ini, Vertice* fin, Arista ref) {
+    Nodo_V* vptr=grafo->lista_ady;
+    while(&(vptr->vt)!=ini) vptr=vptr->sig;
+    const Vect_A* todas=grafo_d_buscar_aristas_entre_vert(grafo, ini, fin);
+    const Vect_A* estrictas=grafo_d_buscar_aristas_estricto(grafo, ref, ini, fin);
+    assert(todas && estrictas);
+    size_t n=0, m=0;
+    for(Nodo_A* aptr=vptr->lista_ady; aptr; aptr=aptr->sig) {
+        if(&(_GD_FIN(grafo, aptr)->vt)!=fin) continue;
+        assert(n<todas->tamano && todas->aristas[n]==&(aptr->ar));
+        ++n;
+        if(aptr->ar==ref) {
+            assert(m<estrictas->tamano && estrictas->aristas[m]==&(aptr->ar));
+            ++m;
+        }
+    }
+    assert(n==todas->tamano && m==estrictas->tamano);
+    assert(grafo_d_buscar_arista_entre_vert(grafo, ini, fin)==(n ? todas->aristas[0] : NULL));
+    assert(grafo_d_buscar_arista_estricto(grafo, ref, ini, fin)==(m ? estrictas->aristas[0] : NULL));
+    GRAFO_D_FREE((void*)todas);
+    GRAFO_D_FREE((void*)estrictas);
+}
+
+static void verificar_todo(const Grafo_D* grafo, Vertice** vts) {
+    for(int c=0; c<CONCENTRADORES; ++c)
+        for(int j=0; j<N; ++j) verificar(grafo, vts[c], vts[j], j%3);
+    for(int i=CONCENTRADORES; i<N; i+=9)
+        for(int j=0; j<N; ++j) verificar(grafo, vts[i], vts[j], j%3);
+}
+
+int main(void) {
+    Vertice* vts[N];
+    Grafo_D* grafo=prueba_grafo_azar(30, N, 300, vts);
+    //Los primeros vertices reciben muchas aristas, incluso paralelas, y rebasan el umbral
+    unsigned semilla=31;
+    for(int i=0; i<3000; ++i) {
+        Vertice* ini=vts[prueba_azar(&semilla)%CONCENTRADORES];
+        Vertice* fin=vts[prueba_azar(&semilla)%N];
+        if(i%5==0) assert(grafo_d_insertar_arpar(grafo, i%3, ini, fin));
+        else assert(grafo_d_insertar_arista(grafo, i%3, ini, fin));
+    }
+    Nodo_V* vptr=grafo->lista_ady;
+    while(&(vptr->vt)!=vts[0]) vptr=vptr->sig;
+    assert(vptr->grado_s>GRAFO_D_UMBRAL_HASH_ADY && vptr->indice_ady);
+    verificar_todo(grafo, vts);
+
+    //Al bajar el grado la tabla se mantiene y despues se descarta
+    while(vptr->grado_s>0) {
+        grafo_d_elminar_arista(grafo, &(vptr->lista_ady->ar));
+        if(vptr->grado_s%97==0) verificar_todo(grafo, vts);
+    }
+    assert(vptr->indice_ady==NULL);
+    verificar_todo(grafo, vts);
+
+    //Eliminar un destino frecuente borra sus aristas de las tablas
+    grafo_d_eliminar_vertice(grafo, vts[N-1]);
+    for(int c=1; c<CONCENTRADORES; ++c)
+        for(int j=0; j<N-1; ++j) verificar(grafo, vts[c], vts[j], j%3);
+    grafo_d_destruir(grafo);
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*  Versiones del grafo: grafo_d_version_dijkstra() comparada con grafo_d_dijkstra() y bloques
+    compartidos entre versiones despues de modificar el grafo
+*/
+#include "comun.h"
+
+#define N 120
+#define ARISTAS 700
+
+static peso_t peso(Arista* ar) {return *ar%13+1;}
+
+static Vertice* vts[N];
+static peso_t longitudes[N][N];
+static size_t pos1[N];
+
+/*  Verifica que el camino de la version sea una cadena de aristas cuyo peso suma su longitud,
+    pos tiene la posicion en la version del vertice con cada valor
+*/
+static void verificar_camino(const Grafo_D_Version* ver, const size_t* pos, const Camino_D* camino,
+    size_t ini, size_t fin) {
+    assert(camino->vts[0]==grafo_d_version_vertice(ver, ini));
+    assert(camino->vts[camino->saltos]==grafo_d_version_vertice(ver, fin));
+    peso_t total=0;
+    for(size_t s=0; s<camino->saltos; ++s) {
+        size_t u=pos[*camino->vts[s]];
+        size_t k=0;
+        while(k<grafo_d_version_grado(ver, u) && grafo_d_version_arista(ver, u, k)!=camino->ars[s]) ++k;
+        assert(k<grafo_d_version_grado(ver, u));
+        assert(grafo_d_version_vertice(ver, grafo_d_version_destino(ver, u, k))==camino->vts[s+1]);
+        total+=peso(camino->ars[s]);
+    }
+    assert(total==camino->longitud);
+}
+
+/*  Compara version_dijkstra con las longitudes guardadas de grafo_d_dijkstra*/
+static void comparar(const Grafo_D_Version* ver, const size_t* pos) {
+    for(int i=0; i<N; i+=7)
+        for(int j=0; j<N; ++j) {
+            size_t ini=pos[i], fin=pos[j];
+            Camino_D* camino=grafo_d_version_dijkstra(ver, ini, fin);
+            assert(camino);
+            if(i==j) assert(es_camino_valido(camino) && camino->saltos==0 && camino->longitud==0);
+            else if(longitudes[i][j]==PESO_NO_ARISTA) assert(!es_camino_valido(camino));
+            else {
+                assert(es_camino_valido(camino) && camino->longitud==longitudes[i][j]);
+                verificar_camino(ver, pos, camino, ini, fin);
+            }
+            camino_d_destruir(camino);
+        }
+}
+
+static void guardar_longitudes(Grafo_D* grafo) {
+    for(int i=0; i<N; i+=7)
+        for(int j=0; j<N; ++j) {
+            if(i==j) continue;
+            Camino_D* camino=grafo_d_dijkstra(grafo, vts[i], vts[j]);
+            assert(camino);
+            longitudes[i][j]=es_camino_valido(camino) ? camino->longitud : PESO_NO_ARISTA;
+            camino_d_destruir(camino);
+        }
+}
+
+int main(void) {
+    Grafo_D* grafo=prueba_grafo_azar(34, N, ARISTAS, vts);
+    grafo_d_set_calc_peso(grafo, peso);
+    guardar_longitudes(grafo);
+    //Las versiones son de solo lectura desde que se crean
+    const Grafo_D_Version* (*snapshot)(Grafo_D*)=grafo_d_snapshot;
+    const Grafo_D_Version* v1=snapshot(grafo);
+    assert(v1 && grafo_d_version_orden(v1)==N && grafo_d_version_tamano(v1)==ARISTAS);
+    for(int i=0; i<N; ++i) {
+        pos1[i]=grafo_d_version_posicion(v1, vts[i]);
+        assert(pos1[i]<N && *grafo_d_version_vertice(v1, pos1[i])==i);
+        assert(grafo_d_version_buscar_vertice(v1, i)==pos1[i]);
+    }
+    assert(grafo_d_version_buscar_vertice(v1, N)==GD_NO_POSICION);
+    comparar(v1, pos1);
+    //Posiciones fuera de rango
+    assert(grafo_d_version_dijkstra(v1, N, 0)==NULL && grafo_d_version_dijkstra(v1, 0, N)==NULL);
+
+    //Insertar una arista solo copia el bloque de su vertice de inicio
+    size_t p3=pos1[3];
+    size_t grado3=grafo_d_version_grado(v1, p3);
+    assert(grafo_d_insertar_arista(grafo, 5, vts[3], vts[8]));
+    const Grafo_D_Version* v2=grafo_d_snapshot(grafo);
+    assert(v2 && grafo_d_version_tamano(v2)==ARISTAS+1);
+    for(size_t i=0; i<N; ++i) assert((v1->bloques[i]==v2->bloques[i])==(i!=p3));
+    assert(grafo_d_version_grado(v1, p3)==grado3 && grafo_d_version_grado(v2, p3)==grado3+1);
+
+    //grafo_d_marcar_modificado copia el bloque aunque la lista no haya cambiado
+    size_t p7=grafo_d_version_posicion(v2, vts[7]);
+    *vts[7]=1000;
+    grafo_d_marcar_modificado(grafo, vts[7]);
+    const Grafo_D_Version* v3=grafo_d_snapshot(grafo);
+    for(size_t i=0; i<N; ++i) assert((v2->bloques[i]==v3->bloques[i])==(i!=p7));
+    assert(*grafo_d_version_vertice(v2, p7)==7 && *grafo_d_version_vertice(v3, p7)==1000);
+    *vts[7]=7;
+    grafo_d_marcar_modificado(grafo, vts[7]);
+
+    //La version anterior no observa la eliminacion de un vertice ni de sus aristas
+    grafo_d_eliminar_vertice(grafo, vts[N-1]);
+    vts[N-1]=NULL;
+    const Grafo_D_Version* v4=grafo_d_snapshot(grafo);
+    assert(v4 && grafo_d_version_orden(v4)==N-1 && grafo_d_version_orden(v1)==N);
+    grafo_d_version_liberar(v2);
+    grafo_d_version_liberar(v3);
+    comparar(v1, pos1);
+
+    //Una version retenida sobrevive a la destruccion del grafo
+    const Grafo_D_Version* v5=grafo_d_version_retener(v4);
+    grafo_d_version_liberar(v4);
+    grafo_d_destruir(grafo);
+    assert(grafo_d_version_orden(v5)==N-1);
+    for(size_t i=0; i<N-1; ++i)
+        for(size_t k=0; k<grafo_d_version_grado(v5, i); ++k) assert(grafo_d_version_destino(v5, i, k)<N-1);
+    grafo_d_version_liberar(v5);
+    grafo_d_version_liberar(v1);
+    return 0;
+}